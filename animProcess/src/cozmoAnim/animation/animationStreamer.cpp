@@ -24,6 +24,7 @@
 #include "coretech/vision/shared/spriteSequence/spriteSequence.h"
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 
+#include "cozmoAnim/animation/facePreRenderer.h"
 #include "cozmoAnim/audio/animationAudioClient.h"
 #include "cozmoAnim/audio/proceduralAudioClient.h"
 #include "cozmoAnim/faceDisplay/faceDisplay.h"
@@ -94,6 +95,52 @@ namespace Anim {
   static bool s_faceDataOverrideRegistered = false;
   static uint8_t s_gammaLUT[3][256];// RGB x 256 entries
 
+  // s_gammaLUT applied directly to the packed bits of each RGB565 channel, so pixels don't
+  // need to be unpacked and repacked. Only usable if each channel's bits are contiguous.
+  struct GammaLUT565 {
+    u16 mask[3];
+    u16 shift[3];
+    u16 table[3][64];
+  };
+
+  static bool BuildGammaLUT565(GammaLUT565& lut)
+  {
+    const Vision::PixelRGB565 channelMax[3] = {
+      Vision::PixelRGB565(255, 0, 0), Vision::PixelRGB565(0, 255, 0), Vision::PixelRGB565(0, 0, 255)
+    };
+
+    for (int channel = 0; channel < 3; ++channel) {
+      const u16 mask = channelMax[channel].GetValue();
+      if (mask == 0) {
+        return false;
+      }
+      u16 shift = 0;
+      while (((mask >> shift) & 1) == 0) {
+        ++shift;
+      }
+      const u16 numValues = (mask >> shift) + 1;
+      if ((numValues > 64) || ((numValues & (numValues - 1)) != 0)) {
+        // Channel bits aren't contiguous
+        return false;
+      }
+      lut.mask[channel] = mask;
+      lut.shift[channel] = shift;
+
+      for (u16 i = 0; i < numValues; ++i) {
+        const Vision::PixelRGB565 pixel(static_cast<u16>(i << shift));
+        u8 rgb[3] = {0, 0, 0};
+        rgb[channel] = s_gammaLUT[channel][channel == 0 ? pixel.r() : (channel == 1 ? pixel.g() : pixel.b())];
+        lut.table[channel][i] = Vision::PixelRGB565(rgb[0], rgb[1], rgb[2]).GetValue();
+      }
+    }
+    return true;
+  }
+
+  // Built from s_gammaLUT whenever that changes (gamma console vars, or a LUT loaded from file)
+  static GammaLUT565 s_gammaLUT565;
+  static bool s_gammaLUT565Valid = false;
+  static bool s_gammaLUT565Dirty = true;
+
   void ResetFace(ConsoleFunctionContextRef context)
   {
     s_faceDataReset = true;
@@ -128,6 +175,7 @@ namespace Anim {
         }
 
         kProcFace_GammaType = (int)FaceGammaType::Custom;
+        s_gammaLUT565Dirty = true;
       }
     } else {
       // see https://ankiinc.atlassian.net/browse/VIC-1646 to productize .tga loading
@@ -156,6 +204,7 @@ namespace Anim {
           }
 
           kProcFace_GammaType = (int)FaceGammaType::Custom;
+          s_gammaLUT565Dirty = true;
         }
       }
     }
@@ -364,6 +413,15 @@ namespace Anim {
   // Disable streaming of backpack lights keyframes by default
   CONSOLE_VAR(bool, kEnableBackpackLightsTrack, "AnimationStreamer", false);
 
+  // Number of upcoming procedural face frames to draw ahead of time on the pre-render thread (0 to disable)
+  CONSOLE_VAR_RANGED(u32, kNumFacePreRenderFrames, "AnimationStreamer", 3, 0, (u32)FacePreRenderer::kMaxNumFrames);
+
+  // Pre-rendered faces are only valid when the face is drawn normally
+  bool CanUsePreRenderedFaces()
+  {
+    return (kProcFace_Display == (int)FaceDisplayType::Normal) && !s_faceDataReset;
+  }
+
   } // namespace
 
 #undef CONSOLE_GROUP
@@ -371,6 +429,7 @@ namespace Anim {
   AnimationStreamer::AnimationStreamer(const Anim::AnimContext* context)
   : _context(context)
   , _proceduralTrackComponent(new TrackLayerComponent(context))
+  , _facePreRenderer(new FacePreRenderer())
   , _lockedTracks((u8)AnimTrackFlag::BACKPACK_LIGHTS_TRACK)
   , _tracksInUse(0)
   , _animAudioClient( new Audio::AnimationAudioClient(context->GetAudioController()) )
@@ -889,6 +948,7 @@ namespace Anim {
     }
     _relativeStreamTime_ms = 0;
     _lockFaceTrackAtEndOfStreamingAnimation = false;
+    _facePreRenderer->Invalidate();
   } // Abort()
 
 
@@ -903,6 +963,7 @@ namespace Anim {
     }
 
     kCurrentManualFrameNumber = 0;
+    _facePreRenderer->Invalidate();
     auto* spriteCache = _context->GetDataLoader()->GetSpriteCache();
     Result lastResult = _streamingAnimation->Init(spriteCache);
     if (lastResult == RESULT_OK)
@@ -1211,6 +1272,12 @@ namespace Anim {
 
       kProcFace_GammaType_old = kProcFace_GammaType;
       kProcFace_Gamma_old = kProcFace_Gamma;
+      s_gammaLUT565Dirty = true;
+    }
+
+    if (s_gammaLUT565Dirty) {
+      s_gammaLUT565Valid = BuildGammaLUT565(s_gammaLUT565);
+      s_gammaLUT565Dirty = false;
     }
 
     if (kProcFace_GammaType != (int)FaceGammaType::None)
@@ -1223,12 +1290,30 @@ namespace Anim {
         nrows = 1;
       }
 
-      for (int i = 0; i < nrows; ++i)
+      if (s_gammaLUT565Valid)
+      {
+        const GammaLUT565& lut565 = s_gammaLUT565;
+        for (int i = 0; i < nrows; ++i)
+        {
+          u16* img_i = reinterpret_cast<u16*>(faceImg565.GetRow(i));
+          for (int j = 0; j < ncols; ++j)
+          {
+            const u16 value = img_i[j];
+            img_i[j] = (lut565.table[0][(value & lut565.mask[0]) >> lut565.shift[0]] |
+                        lut565.table[1][(value & lut565.mask[1]) >> lut565.shift[1]] |
+                        lut565.table[2][(value & lut565.mask[2]) >> lut565.shift[2]]);
+          }
+        }
+      }
+      else
       {
-        Vision::PixelRGB565* img_i = faceImg565.GetRow(i);
-        for (int j = 0; j < ncols; ++j)
+        for (int i = 0; i < nrows; ++i)
         {
-          img_i[j].SetValue(Vision::PixelRGB565(s_gammaLUT[0][img_i[j].r()], s_gammaLUT[1][img_i[j].g()], s_gammaLUT[2][img_i[j].b()]).GetValue());
+          Vision::PixelRGB565* img_i = faceImg565.GetRow(i);
+          for (int j = 0; j < ncols; ++j)
+          {
+            img_i[j].SetValue(Vision::PixelRGB565(s_gammaLUT[0][img_i[j].r()], s_gammaLUT[1][img_i[j].g()], s_gammaLUT[2][img_i[j].b()]).GetValue());
+          }
         }
       }
     }
@@ -1537,10 +1622,46 @@ namespace Anim {
     ExtractMessagesRelatedToProceduralTrackComponent(_context, _streamingAnimation, _proceduralTrackComponent.get(),
                                                      _lockedTracks, _relativeStreamTime_ms, kStoreFace, stateToSend);
 
+    QueueFacePreRenders();
+
     return lastResult;
   } // ExtractMessagesFromStreamingAnim()
 
 
+  void AnimationStreamer::QueueFacePreRenders()
+  {
+    // Only the animation's own face track can be predicted. Procedural face layers are combined
+    // with it each tick, so don't bother drawing ahead while there are any.
+    if (kNumFacePreRenderFrames == 0 ||
+        kIsInManualUpdateMode ||
+        !CanUsePreRenderedFaces() ||
+        IsTrackLocked(_lockedTracks, (u8)AnimTrackFlag::FACE_TRACK) ||
+        _proceduralTrackComponent->HaveFaceLayersToSend())
+    {
+      _facePreRenderer->Invalidate();
+      return;
+    }
+
+    const auto& faceTrack = _streamingAnimation->GetTrack<ProceduralFaceKeyFrame>();
+    for (u32 i = 1; i <= kNumFacePreRenderFrames; ++i)
+    {
+      const TimeStamp_t streamTime_ms = _relativeStreamTime_ms + (i * ANIM_TIME_STEP_MS);
+      if (_facePreRenderer->IsQueued(streamTime_ms))
+      {
+        continue;
+      }
+
+      // Scanline distortion draws from a shared random generator, so those faces are always drawn here
+      ProceduralFace face;
+      if (FacePreRenderer::GetFaceAtTime(faceTrack, streamTime_ms, face) &&
+          (face.GetScanlineDistorter() == nullptr))
+      {
+        _facePreRenderer->Queue(streamTime_ms, face);
+      }
+    }
+  } // QueueFacePreRenders()
+
+
   Result AnimationStreamer::ExtractMessagesRelatedToProceduralTrackComponent(const Anim::AnimContext* context,
                                                                              Animation* anim,
                                                                              TrackLayerComponent* trackComp,
@@ -1589,7 +1710,13 @@ namespace Anim {
 
     if (haveEyesToRender)
     {
-      GetStreamableFace(context, layeredKeyFrames.faceKeyFrame.GetFace(), stateToSend.faceImg);
+      const ProceduralFace& face = layeredKeyFrames.faceKeyFrame.GetFace();
+      const bool usePreRenderedFace = CanUsePreRenderedFaces() &&
+                                      _facePreRenderer->GetFrame(timeSinceAnimStart_ms, face, stateToSend.faceImg);
+      if (!usePreRenderedFace)
+      {
+        GetStreamableFace(context, face, stateToSend.faceImg);
+      }
       stateToSend.haveFaceToSend = true;
     }
 
@@ -51,6 +51,8 @@ namespace Vector {
   }
 
 namespace Anim {
+  class FacePreRenderer;
+
   class AnimationStreamer
   {
   public:
@@ -209,6 +211,9 @@ namespace Anim {
 
     std::unique_ptr<TrackLayerComponent>  _proceduralTrackComponent;
 
+    // Draws the streaming animation's upcoming procedural faces ahead of time
+    std::unique_ptr<FacePreRenderer>      _facePreRenderer;
+
     u32 _numLoops = 1;
     u32 _loopCtr  = 0;
 
@@ -398,6 +403,9 @@ namespace Anim {
                                 AnimationMessageWrapper& messageWrapper) const;
 
     static void GetStreamableFace(const Anim::AnimContext* context, const ProceduralFace& procFace, Vision::ImageRGB565& outImage);
+
+    // Queue the streaming animation's faces for the next few frames to be drawn by _facePreRenderer
+    void QueueFacePreRenders();
     void BufferFaceToSend(Vision::ImageRGB565& image);
 
   #if ANKI_DEV_CHEATS
@@ -0,0 +1,248 @@
+/**
+ * File: facePreRenderer.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Draws upcoming procedural face frames on a worker thread so the animation
+ *              tick only has to copy them out.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "cozmoAnim/animation/facePreRenderer.h"
+
+#include "anki/cozmo/shared/cozmoConfig.h"
+#include "util/cpuProfiler/cpuProfiler.h"
+#include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+
+#include <iterator>
+
+#define LOG_CHANNEL "Animations"
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FacePreRenderer::FacePreRenderer()
+: _stopDrawing(false)
+{
+  for(auto& frame : _frames)
+  {
+    frame.img.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+  }
+  _drawThread = std::thread(&FacePreRenderer::DrawLoop, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FacePreRenderer::~FacePreRenderer()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopDrawing = true;
+  }
+  _queuedCondition.notify_all();
+
+  _drawThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FacePreRenderer::Queue(const TimeStamp_t streamTime_ms, const ProceduralFace& face)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Frame* emptyFrame = nullptr;
+    for(auto& frame : _frames)
+    {
+      if(frame.state == FrameState::Empty)
+      {
+        if(emptyFrame == nullptr)
+        {
+          emptyFrame = &frame;
+        }
+      }
+      else if(!frame.discard && (frame.streamTime_ms == streamTime_ms))
+      {
+        // Already queued
+        return;
+      }
+    }
+
+    if(emptyFrame == nullptr)
+    {
+      return;
+    }
+
+    emptyFrame->state = FrameState::Queued;
+    emptyFrame->discard = false;
+    emptyFrame->streamTime_ms = streamTime_ms;
+    emptyFrame->face = face;
+    // The global hue and saturation are only safe to read on this (the animation) thread
+    emptyFrame->hue = ProceduralFace::GetHue();
+    emptyFrame->saturation = ProceduralFace::GetSaturation();
+  }
+  _queuedCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FacePreRenderer::IsQueued(const TimeStamp_t streamTime_ms) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for(const auto& frame : _frames)
+  {
+    if((frame.state != FrameState::Empty) && !frame.discard && (frame.streamTime_ms == streamTime_ms))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FacePreRenderer::GetFrame(const TimeStamp_t streamTime_ms,
+                               const ProceduralFace& face,
+                               Vision::ImageRGB565& outImg)
+{
+  ANKI_CPU_PROFILE("FacePreRenderer::GetFrame");
+
+  bool haveFrame = false;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  for(auto& frame : _frames)
+  {
+    if((frame.state == FrameState::Empty) || (frame.streamTime_ms > streamTime_ms))
+    {
+      continue;
+    }
+
+    if((frame.state == FrameState::Ready) &&
+       !frame.discard &&
+       (frame.streamTime_ms == streamTime_ms) &&
+       (frame.face == face) &&
+       (frame.hue == ProceduralFace::GetHue()) &&
+       (frame.saturation == ProceduralFace::GetSaturation()))
+    {
+      frame.img.CopyTo(outImg);
+      haveFrame = true;
+    }
+
+    // This frame is now in the past
+    if(frame.state == FrameState::Drawing)
+    {
+      frame.discard = true;
+    }
+    else
+    {
+      frame.state = FrameState::Empty;
+    }
+  }
+
+  return haveFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FacePreRenderer::Invalidate()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for(auto& frame : _frames)
+  {
+    if(frame.state == FrameState::Drawing)
+    {
+      // The drawing thread still owns the image, it will release it when done
+      frame.discard = true;
+    }
+    else
+    {
+      frame.state = FrameState::Empty;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FacePreRenderer::GetFaceAtTime(const Animations::Track<ProceduralFaceKeyFrame>& track,
+                                    const TimeStamp_t streamTime_ms,
+                                    ProceduralFace& outFace)
+{
+  // Same lookup as FaceLayerManager::GetFaceHelper(), but starting from the current keyframe
+  // without moving the track
+  if(!track.HasFramesLeft())
+  {
+    return false;
+  }
+
+  const auto& allKeyframes = track.GetAllKeyframes();
+  auto currIter = allKeyframes.begin() + (&track.GetCurrentKeyFrame() - allKeyframes.data());
+  if(!currIter->IsTimeToPlay(streamTime_ms))
+  {
+    return false;
+  }
+
+  auto nextIter = std::next(currIter);
+  while((nextIter != allKeyframes.end()) && nextIter->IsTimeToPlay(streamTime_ms))
+  {
+    currIter = nextIter++;
+  }
+
+  if(nextIter != allKeyframes.end())
+  {
+    // GetInterpolatedFace() isn't const, but doesn't modify the keyframe
+    outFace = const_cast<ProceduralFaceKeyFrame&>(*currIter).GetInterpolatedFace(*nextIter, streamTime_ms);
+  }
+  else
+  {
+    outFace = currIter->GetFace();
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FacePreRenderer::Frame* FacePreRenderer::GetNextFrameToDraw()
+{
+  Frame* nextFrame = nullptr;
+  for(auto& frame : _frames)
+  {
+    if((frame.state == FrameState::Queued) &&
+       ((nextFrame == nullptr) || (frame.streamTime_ms < nextFrame->streamTime_ms)))
+    {
+      nextFrame = &frame;
+    }
+  }
+  return nextFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FacePreRenderer::DrawLoop()
+{
+  Anki::Util::SetThreadName(pthread_self(), "FacePreRender");
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(!_stopDrawing)
+  {
+    Frame* frame = GetNextFrameToDraw();
+    if(frame == nullptr)
+    {
+      _queuedCondition.wait(lock);
+      continue;
+    }
+
+    // The face, hue, saturation and image are only touched by this thread while the frame is being drawn
+    frame->state = FrameState::Drawing;
+    lock.unlock();
+    {
+      ANKI_CPU_PROFILE("FacePreRenderer::Draw");
+      _drawer.Draw(frame->face, frame->hue, frame->saturation, _rng, frame->img);
+    }
+    lock.lock();
+
+    frame->state = frame->discard ? FrameState::Empty : FrameState::Ready;
+    frame->discard = false;
+  }
+}
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
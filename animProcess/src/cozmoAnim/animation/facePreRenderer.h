@@ -0,0 +1,110 @@
+/**
+ * File: facePreRenderer.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Draws upcoming procedural face frames on a worker thread so the animation
+ *              tick only has to copy them out. The AnimationStreamer queues the faces it
+ *              expects to show in the next few frames, and asks for the pre-rendered image
+ *              when the time comes. A pre-rendered image is only returned if it was drawn
+ *              from exactly the face that is about to be shown, so anything that changes the
+ *              face in the meantime (procedural layers, track locking, ...) simply falls back
+ *              to drawing synchronously.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Anki_Cozmo_FacePreRenderer_H__
+#define __Anki_Cozmo_FacePreRenderer_H__
+
+#include "cannedAnimLib/baseTypes/track.h"
+#include "cannedAnimLib/proceduralFace/proceduralFace.h"
+#include "cannedAnimLib/proceduralFace/proceduralFaceDrawer.h"
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/image.h"
+#include "util/random/randomGenerator.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+class FacePreRenderer
+{
+public:
+  // Maximum number of frames that can be queued ahead of the current one
+  static constexpr size_t kMaxNumFrames = 6;
+
+  FacePreRenderer();
+  ~FacePreRenderer();
+
+  // Queue face to be drawn for the frame at streamTime_ms, with the current global face hue and saturation.
+  // Does nothing if that frame is already queued or all buffers are in use. Call from the animation thread.
+  void Queue(const TimeStamp_t streamTime_ms, const ProceduralFace& face);
+
+  // Returns true if a frame is queued for streamTime_ms (whether or not it has been drawn yet)
+  bool IsQueued(const TimeStamp_t streamTime_ms) const;
+
+  // If the frame for streamTime_ms has been drawn from a face equal to the given one, copies it into
+  // outImg and returns true. Frames at or before streamTime_ms are released either way.
+  bool GetFrame(const TimeStamp_t streamTime_ms, const ProceduralFace& face, Vision::ImageRGB565& outImg);
+
+  // Drops all queued and drawn frames, e.g. when the streaming animation changes or is aborted
+  void Invalidate();
+
+  // Computes the face the animation's face track will produce at streamTime_ms, as long as the
+  // track isn't advanced past the current keyframe before then. Returns false if the track has
+  // no face for that time.
+  static bool GetFaceAtTime(const Animations::Track<ProceduralFaceKeyFrame>& track,
+                            const TimeStamp_t streamTime_ms,
+                            ProceduralFace& outFace);
+
+private:
+
+  enum class FrameState : u8 {
+    Empty,
+    Queued,
+    Drawing,
+    Ready
+  };
+
+  struct Frame {
+    FrameState          state = FrameState::Empty;
+    bool                discard = false; // set if invalidated while being drawn
+    TimeStamp_t         streamTime_ms = 0;
+    ProceduralFace      face;
+    f32                 hue = 0.f;        // global face hue and saturation when the frame was queued
+    f32                 saturation = 0.f;
+    Vision::ImageRGB565 img;
+  };
+
+  std::array<Frame, kMaxNumFrames> _frames;
+
+  // Only touched by the drawing thread
+  ProceduralFaceDrawer    _drawer;
+  Util::RandomGenerator   _rng;
+
+  mutable std::mutex      _mutex;
+  std::condition_variable _queuedCondition;
+  std::atomic<bool>       _stopDrawing;
+  std::thread             _drawThread;
+
+  void DrawLoop();
+
+  // Returns the queued frame with the earliest stream time, or nullptr. Must hold _mutex.
+  Frame* GetNextFrameToDraw();
+
+}; // class FacePreRenderer
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Cozmo_FacePreRenderer_H__
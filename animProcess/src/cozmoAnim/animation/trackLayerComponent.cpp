@@ -66,7 +66,7 @@ void TrackLayerComponent::Init(AnimationStreamer& animStreamer)
   // Setup Keep Alive Activities
   SetupKeepFaceAliveActivities();
   // Setup Audio latency callback to reset keyframe idx
-  const auto callback = [this] () { _validAudioKeyframeIt = false; };
+  const auto callback = [this] () { _validAudioKeyframeIdx = false; };
   animStreamer.AddNewAnimationCallback(callback);
 }
   
@@ -257,6 +257,12 @@ bool TrackLayerComponent::HaveLayersToSend() const
           _faceLayerManager->HaveLayersToSend());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TrackLayerComponent::HaveFaceLayersToSend() const
+{
+  return _faceLayerManager->HaveLayersToSend();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 u32 TrackLayerComponent::GetMaxBlinkSpacingTimeForScreenProtection_ms() const
 {
@@ -324,16 +330,16 @@ void TrackLayerComponent::ApplyAudioLayersToAnim(Animation* anim,
     auto& track = anim->GetTrack<RobotAudioKeyFrame>();
     auto& frameList = track.GetAllKeyframes();
 
-    if (!_validAudioKeyframeIt) {
-      _audioKeyframeIt = frameList.begin();
-      _validAudioKeyframeIt = true;
+    if (!_validAudioKeyframeIdx) {
+      _audioKeyframeIdx = 0;
+      _validAudioKeyframeIdx = true;
     }
 
-    if ((_audioKeyframeIt != frameList.end()) &&
-         _audioKeyframeIt->IsTimeToPlay(audioOffsetTime_ms)) {
-      layeredKeyFrames.audioKeyFrame = *_audioKeyframeIt;
+    if ((_audioKeyframeIdx < frameList.size()) &&
+         frameList[_audioKeyframeIdx].IsTimeToPlay(audioOffsetTime_ms)) {
+      layeredKeyFrames.audioKeyFrame = frameList[_audioKeyframeIdx];
       layeredKeyFrames.haveAudioKeyFrame = true;
-      ++_audioKeyframeIt;
+      ++_audioKeyframeIdx;
     }
   }
   
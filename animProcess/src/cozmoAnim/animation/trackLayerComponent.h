@@ -126,6 +126,9 @@ public:
   
   // Returns true if any of the layerManagers have layers to send
   bool HaveLayersToSend() const;
+
+  // Returns true if the faceLayerManager has layers to send
+  bool HaveFaceLayersToSend() const;
   
   u32 GetMaxBlinkSpacingTimeForScreenProtection_ms() const;
   
@@ -165,8 +168,8 @@ private:
   std::vector<KeepAliveModifier>                _keepAliveModifiers;
 
   // Audio letancy offset tracking vars
-  mutable bool _validAudioKeyframeIt = false;
-  mutable std::list<RobotAudioKeyFrame>::iterator _audioKeyframeIt;
+  mutable bool _validAudioKeyframeIdx = false;
+  mutable size_t _audioKeyframeIdx = 0;
   
   // Setup and add keep face alive activites to _keepAliveActivities vector
   void SetupKeepFaceAliveActivities();
@@ -259,7 +259,7 @@ void ITrackLayerManager<FRAME_TYPE>::ValidateTrack(const Animations::Track<FRAME
 {
   if(ANKI_DEV_CHEATS){
     // Ensure tracks don't overlap
-    for(const auto& keyframe: track.GetCopyOfKeyframes()){
+    for(const auto& keyframe: track.GetAllKeyframes()){
       ANKI_VERIFY(keyframe.GetTriggerTime_ms() != keyframe.GetTimestampActionComplete_ms(),
                   "ITrackLayerManager.ValidateTrack.KeyframeWithNoLength",
                   "All keyframes must have a duration");
@@ -272,7 +272,7 @@ void ITrackLayerManager<ProceduralFaceKeyFrame>::ValidateTrack(const Animations:
 {
   if(ANKI_DEV_CHEATS){
     // Ensure tracks don't overlap
-    auto keyframes = track.GetCopyOfKeyframes();
+    const auto& keyframes = track.GetAllKeyframes();
     for(auto keyframeIter = keyframes.begin(); keyframeIter != keyframes.end(); keyframeIter++){
       ANKI_VERIFY(keyframeIter->GetTriggerTime_ms() != keyframeIter->GetTimestampActionComplete_ms(),
                   "ITrackLayerManager.ValidateTrack.KeyframeWithNoLength",
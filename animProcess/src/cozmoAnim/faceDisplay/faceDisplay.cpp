@@ -15,12 +15,17 @@
 #include "cozmoAnim/faceDisplay/faceDisplayImpl.h"
 #include "cozmoAnim/faceDisplay/faceInfoScreenManager.h"
 #include "coretech/common/shared/array2d.h"
+#include "coretech/common/shared/math/rect.h"
 #include "coretech/vision/engine/image.h"
 #include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/threading/threadPriority.h"
 #include "cozmoAnim/execCommand/exec_command.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 #define LOG_CHANNEL "FaceDisplay"
 
 // Whether or not we need to manually stop the boot animation process, vic-bootAnim
@@ -35,6 +40,13 @@ namespace Vector {
 #endif
 
 namespace {
+  // Only send the part of each frame that changed since the last one (and nothing if it's the same)
+  CONSOLE_VAR(bool, kFaceDisplayPartialUpdates, "FaceDisplay", true);
+
+  // Other processes (vic-faultCodeDisplay, the rescue face in vic-switchboard) can draw on the LCD without us knowing,
+  // so with partial updates still send a whole frame at least this often to get the face back (0 = never)
+  CONSOLE_VAR(u32, kFaceDisplayFullRedrawPeriod_ms, "FaceDisplay", 1000);
+
 #if REMOTE_CONSOLE_ENABLED
   FaceDisplayImpl* sDisplayImpl = nullptr;
 
@@ -80,6 +92,8 @@ FaceDisplay::FaceDisplay()
   _faceDrawImg[0]->Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
   _faceDrawImg[1].reset(new Vision::ImageRGB565());
   _faceDrawImg[1]->Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+  _displayedImg.reset(new Vision::ImageRGB565());
+  _displayedImg->Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
   _faceDrawThread = std::thread(&FaceDisplay::DrawFaceLoop, this);
 }
 
@@ -183,6 +197,7 @@ void FaceDisplay::DrawFaceLoop()
      // Actually create a FaceDisplay which will open a connection to the LCD
      // now that no other process is using it
      _displayImpl.reset(new FaceDisplayImpl());
+     _displayedImgValid = false;
 
 #if REMOTE_CONSOLE_ENABLED
      sDisplayImpl = _displayImpl.get();
@@ -209,7 +224,7 @@ void FaceDisplay::DrawFaceLoop()
       // Only draw to the face once the boot anim has been stopped
       if(_displayImpl != nullptr && _stopBootAnim)
       {
-        _displayImpl->FaceDraw(drawImage.GetRawDataPointer());
+        DrawToDisplay(drawImage);
       }
 
       // Done with this image, clear the pointer
@@ -241,6 +256,92 @@ void FaceDisplay::DrawFaceLoop()
   LOG_INFO("FaceDisplay.DrawFaceLoop", "DrawFaceLoop thread is exiting");
 }
 
+void FaceDisplay::DrawToDisplay(const Vision::ImageRGB565& img)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const bool fullRedrawDue = (kFaceDisplayFullRedrawPeriod_ms > 0) &&
+                             (now - _lastFullDrawTime >= std::chrono::milliseconds(kFaceDisplayFullRedrawPeriod_ms));
+
+  if(!kFaceDisplayPartialUpdates || !_displayedImgValid || fullRedrawDue)
+  {
+    _displayImpl->FaceDraw(img.GetRawDataPointer());
+    img.CopyTo(*_displayedImg);
+    _displayedImgValid = true;
+    _lastFullDrawTime = now;
+    return;
+  }
+
+  Rectangle<s32> changedRect;
+  if(!GetChangedRect(*_displayedImg, img, changedRect))
+  {
+    // Already on the display
+    return;
+  }
+
+  _displayImpl->FaceDrawRect(img.GetRawDataPointer(), changedRect);
+
+  const size_t rowSize = img.GetNumCols() * sizeof(Vision::PixelRGB565);
+  for(s32 row = changedRect.GetY(); row < changedRect.GetYmax(); ++row)
+  {
+    std::memcpy(_displayedImg->GetRow(row), img.GetRow(row), rowSize);
+  }
+}
+
+bool FaceDisplay::GetChangedRect(const Vision::ImageRGB565& prevImg,
+                                 const Vision::ImageRGB565& img,
+                                 Rectangle<s32>& outRect)
+{
+  DEV_ASSERT((prevImg.GetNumRows() == img.GetNumRows()) && (prevImg.GetNumCols() == img.GetNumCols()),
+             "FaceDisplay.GetChangedRect.SizeMismatch");
+
+  const s32 numRows = img.GetNumRows();
+  const s32 numCols = img.GetNumCols();
+  const size_t rowSize = numCols * sizeof(Vision::PixelRGB565);
+
+  // Find the first and last rows with any changes
+  s32 firstRow = 0;
+  while((firstRow < numRows) && (0 == std::memcmp(prevImg.GetRow(firstRow), img.GetRow(firstRow), rowSize)))
+  {
+    ++firstRow;
+  }
+  if(firstRow == numRows)
+  {
+    return false;
+  }
+
+  s32 lastRow = numRows - 1;
+  while((lastRow > firstRow) && (0 == std::memcmp(prevImg.GetRow(lastRow), img.GetRow(lastRow), rowSize)))
+  {
+    --lastRow;
+  }
+
+  // Then narrow down the columns within those rows
+  s32 firstCol = numCols;
+  s32 lastCol = -1;
+  for(s32 row = firstRow; row <= lastRow; ++row)
+  {
+    const u16* prevRow = reinterpret_cast<const u16*>(prevImg.GetRow(row));
+    const u16* currRow = reinterpret_cast<const u16*>(img.GetRow(row));
+
+    s32 col = 0;
+    while((col < firstCol) && (prevRow[col] == currRow[col]))
+    {
+      ++col;
+    }
+    firstCol = std::min(firstCol, col);
+
+    col = numCols - 1;
+    while((col > lastCol) && (prevRow[col] == currRow[col]))
+    {
+      --col;
+    }
+    lastCol = std::max(lastCol, col);
+  }
+
+  outRect = Rectangle<s32>(firstCol, firstRow, lastCol - firstCol + 1, lastRow - firstRow + 1);
+  return true;
+}
+
 void FaceDisplay::StopBootAnim()
 {
   if(!_stopBootAnim)
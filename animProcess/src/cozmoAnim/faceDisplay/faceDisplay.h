@@ -18,7 +18,9 @@
 #include "anki/cozmo/shared/factory/faultCodes.h"
 
 #include "clad/types/lcdTypes.h"
+#include "coretech/common/shared/math/rect_fwd.h"
 
+#include <chrono>
 #include <thread>
 
 namespace Anki {
@@ -47,6 +49,12 @@ public:
 
   // Stops the boot animation process if it is running
   void StopBootAnim();
+
+  // Computes the bounding rectangle of all pixels that differ between prevImg and img, which must
+  // be the same size. Returns false if the images are identical.
+  static bool GetChangedRect(const Vision::ImageRGB565& prevImg,
+                             const Vision::ImageRGB565& img,
+                             Rectangle<s32>& outRect);
   
 protected:
   FaceDisplay();
@@ -72,8 +80,15 @@ private:
   // Whether or not the boot animation process has been stopped
   // Atomic because it is checked by the face drawing thread
   std::atomic<bool> _stopBootAnim;
+
+  // Copy of what is currently on the display, so only changes need to be sent
+  // (only used by the face-drawing thread)
+  std::unique_ptr<Vision::ImageRGB565>  _displayedImg;
+  bool                                  _displayedImgValid = false;
+  std::chrono::steady_clock::time_point _lastFullDrawTime;
   
   void DrawFaceLoop();
+  void DrawToDisplay(const Vision::ImageRGB565& img);
   void UpdateNextImgPtr();
 }; // class FaceDisplay
 
@@ -14,6 +14,7 @@
 #ifndef ANKI_COZMOANIM_FACE_DISPLAY_IMPL_H
 #define ANKI_COZMOANIM_FACE_DISPLAY_IMPL_H
 #include "coretech/common/shared/types.h"
+#include "coretech/common/shared/math/rect.h"
 #include "anki/cozmo/shared/cozmoConfig.h"
 
 
@@ -41,6 +42,10 @@ public:
   //      FaceDisplay::getInstance()->FaceDraw(reinterpret_cast<u16*>(img565.ptr()));
   void FaceDraw(const u16* frame);
 
+  // Draws only the pixels of frame inside rect to the face display. 'frame' is still a
+  // full FACE_DISPLAY_WIDTH x FACE_DISPLAY_HEIGHT buffer, as for FaceDraw().
+  void FaceDrawRect(const u16* frame, const Rectangle<s32>& rect);
+
   // Print text to face display
   void FacePrintf(const char *format, ...);
 
@@ -35,6 +35,17 @@ namespace { // "Private members"
   
   // Face 'image' to send to webots each frame
   u32 faceImg_[FACE_DISPLAY_WIDTH*FACE_DISPLAY_HEIGHT] = {0};
+
+  // Sends the first width x height pixels of faceImg_ to webots, to be drawn at (x,y)
+  void PasteFaceImg(int x, int y, int width, int height)
+  {
+    // Send the image to webots (by using the webots::Display 'clipboard' functionality),
+    // paste it from the 'clipboard' to the main display, then delete it.
+    // (see https://www.cyberbotics.com/doc/reference/display#display-functions)
+    auto imgRef = face_->imageNew(width, height, faceImg_, webots::Display::ARGB);
+    face_->imagePaste(imgRef, x, y);
+    face_->imageDelete(imgRef);
+  }
   
 } // "private" namespace
 
@@ -75,12 +86,23 @@ namespace { // "Private members"
       ++frame;
     }
 
-    // Send the entire image to webots (by using the webots::Display 'clipboard' functionality),
-    // paste it from the 'clipboard' to the main display, then delete it.
-    // (see https://www.cyberbotics.com/doc/reference/display#display-functions)
-    auto imgRef = face_->imageNew(FACE_DISPLAY_WIDTH, FACE_DISPLAY_HEIGHT, faceImg_, webots::Display::ARGB);
-    face_->imagePaste(imgRef, 0, 0);
-    face_->imageDelete(imgRef);
+    PasteFaceImg(0, 0, FACE_DISPLAY_WIDTH, FACE_DISPLAY_HEIGHT);
+  }
+
+  void FaceDisplayImpl::FaceDrawRect(const u16* frame, const Rectangle<s32>& rect)
+  {
+    // Pack just the rect's pixels at the start of faceImg_
+    u32* imgPtr = &faceImg_[0];
+    for (s32 row = rect.GetY(); row < rect.GetYmax(); ++row) {
+      const u16* framePtr = frame + (row * FACE_DISPLAY_WIDTH) + rect.GetX();
+      for (s32 col = 0; col < rect.GetWidth(); ++col) {
+        Vision::PixelRGB565 rgb565(*framePtr);
+        *imgPtr++ = rgb565.ToBGRA32();
+        ++framePtr;
+      }
+    }
+
+    PasteFaceImg(rect.GetX(), rect.GetY(), rect.GetWidth(), rect.GetHeight());
   }
   
   void FaceDisplayImpl::FacePrintf(const char* format, ...)
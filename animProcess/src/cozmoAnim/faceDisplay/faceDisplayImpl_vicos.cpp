@@ -46,6 +46,12 @@ namespace Vector {
   {
     lcd_draw_frame2(frame, FACE_DISPLAY_WIDTH*FACE_DISPLAY_HEIGHT*sizeof(u16));
   }
+
+  void FaceDisplayImpl::FaceDrawRect(const u16* frame, const Rectangle<s32>& rect)
+  {
+    // core/lcd only supports writing whole frames. FaceDisplay still skips unchanged frames entirely.
+    FaceDraw(frame);
+  }
   
   void FaceDisplayImpl::FacePrintf(const char* format, ...)
   {
@@ -14,7 +14,6 @@
 
 #include "cozmoAnim/micData/audioFFT.h"
 #include "util/logging/logging.h"
-#include "pffft.h"
 #include <math.h>
 
 namespace Anki {
@@ -24,6 +23,7 @@ namespace Vector {
 AudioFFT::AudioFFT( unsigned int N )
 : _N{ N }
 , _buff{ N, N }
+, _fft{ N }
 , _windowCoeffs(N, 0.0)
 {
   Reset();
@@ -39,7 +39,6 @@ AudioFFT::AudioFFT( unsigned int N )
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioFFT::~AudioFFT()
 {
-  Cleanup();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -61,41 +60,32 @@ void AudioFFT::AddSamples( const BuffType* samples, size_t numSamples )
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-std::vector<AudioFFT::DataType> AudioFFT::GetPower()
+void AudioFFT::GetPower( std::vector<DataType>& outPower )
 {
-  std::vector<DataType> ret;
+  outPower.clear();
   
   if( !_hasEnoughSamples ) {
-    return ret;
+    return;
   }
   
-  ret.reserve( _N/2 );
+  outPower.reserve( _N/2 );
   
   // do dft if needed
   DoDFT();
   
-  // compute power from _outData. real and imag components are interleaved
+  // compute power from the fft output. real and imag components are interleaved
+  const DataType* outData = _fft.GetOutput();
   static const DataType normFactor = 1.0 / (_N*_N);
-  ret.push_back( (_outData[0]*_outData[0] + _outData[1]*_outData[1])*normFactor );
+  outPower.push_back( (outData[0]*outData[0] + outData[1]*outData[1])*normFactor );
   for( int i=2; i<_N; i+=2 ) {
-    const DataType mag = _outData[i]*_outData[i] + _outData[i+1]*_outData[i+1];
-    ret.push_back( 2*normFactor*mag );
+    const DataType mag = outData[i]*outData[i] + outData[i+1]*outData[i+1];
+    outPower.push_back( 2*normFactor*mag );
   }
-  
-  return ret;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioFFT::Reset()
 {
-  Cleanup();
-
-  _plan = (void*) PFFFT::pffft_new_setup( _N, PFFFT::PFFFT_REAL );
-  
-  int numBytes = _N * sizeof(float);
-  _inData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
-  _outData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
-  
   _hasEnoughSamples = false;
   _dirty = false;
   _buff.Reset();
@@ -113,31 +103,12 @@ void AudioFFT::DoDFT()
   const BuffType* buffData = _buff.ReadData( _N );
   assert( buffData != nullptr );
   static const DataType factor = 1.0 / std::numeric_limits<BuffType>::max();
+  DataType* inData = _fft.GetInput();
   for( int i=0; i<_N; ++i ) {
     const DataType fVal = *(buffData + i) * factor;
-    _inData[i] = _windowCoeffs[i] * fVal;
-  }
-  // pffft docs say: "If 'work' is NULL, then stack will be used instead (this is probably the
-  // best strategy for small FFTs, say for N < 16384)."
-  float* work = nullptr;
-  PFFFT::pffft_transform_ordered( (PFFFT::PFFFT_Setup*)_plan, _inData, _outData, work, PFFFT::PFFFT_FORWARD );
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AudioFFT::Cleanup()
-{
-  if( _plan != nullptr ) {
-    PFFFT::pffft_destroy_setup( (PFFFT::PFFFT_Setup*)_plan );
-    _plan = nullptr;
-  }
-  if( _inData ) {
-    PFFFT::pffft_aligned_free( (void*)_inData );
-    _inData = nullptr;
-  }
-  if( _outData ) {
-    PFFFT::pffft_aligned_free( (void*)_outData );
-    _outData = nullptr;
+    inData[i] = _windowCoeffs[i] * fVal;
   }
+  _fft.Transform();
 }
 
 } // namespace Vector
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "audioUtil/audioDataTypes.h"
+#include "cozmoAnim/micData/fftService.h"
 #include "util/container/ringBuffContiguousRead.h"
 #include "util/helpers/noncopyable.h"
 #include <array>
@@ -39,27 +40,24 @@ public:
   
   bool HasEnoughSamples() const { return _hasEnoughSamples; }
   
-  // returns power of the last N samples in a vector of size N/2+1. Only call this if HasEnoughSamples().
-  std::vector<DataType> GetPower();
+  // fills outPower with the power of the last N samples (N/2 values), reusing its storage. Only call this if
+  // HasEnoughSamples().
+  void GetPower( std::vector<DataType>& outPower );
   
   void Reset();
   
 private:
   
-  // Computes the DFT of _buff, saving to _outData, only if _buff has changed
+  // Computes the DFT of _buff, saving to the _fft output, only if _buff has changed
   void DoDFT();
   
-  void Cleanup();
-  
   const unsigned int _N;
   Anki::Util::RingBuffContiguousRead<BuffType> _buff;
   
   bool _hasEnoughSamples = false;
   bool _dirty = false;
   
-  DataType* _inData = nullptr;
-  DataType* _outData = nullptr;
-  void* _plan = nullptr; // pointer to library context
+  RealFFT _fft;
   
   std::vector<DataType> _windowCoeffs;
   
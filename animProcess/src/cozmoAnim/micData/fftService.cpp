@@ -0,0 +1,189 @@
+/**
+ * File: fftService.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Shared real-input, single precision FFTs for the anim process, backed by pffft.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ */
+
+#include "cozmoAnim/micData/fftService.h"
+#include "util/logging/logging.h"
+#include "pffft.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define LOG_CHANNEL "Microphones"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // pffft needs at least this many samples for a real transform
+  constexpr unsigned int kMinSize = 32;
+
+  std::mutex sPlanMutex;
+  std::unordered_map<unsigned int, PFFFT::PFFFT_Setup*> sSharedPlans;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FFTService::IsValidSize(unsigned int N)
+{
+  if( (N < kMinSize) || ((N % kMinSize) != 0) ) {
+    return false;
+  }
+  N /= kMinSize;
+  for( const unsigned int factor : {2, 3, 5} ) {
+    while( (N % factor) == 0 ) {
+      N /= factor;
+    }
+  }
+  return (N == 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned int FFTService::GetLargestValidSize(unsigned int N)
+{
+  // Valid sizes are multiples of 32 and fairly dense, so this doesn't have to search far
+  for( N -= (N % kMinSize); N >= kMinSize; N -= kMinSize ) {
+    if( IsValidSize(N) ) {
+      return N;
+    }
+  }
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PFFFT::PFFFT_Setup* FFTService::GetSharedPlan(unsigned int N)
+{
+  if( !IsValidSize(N) ) {
+    LOG_ERROR("FFTService.GetSharedPlan.InvalidSize", "pffft can't transform %u samples", N);
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(sPlanMutex);
+  auto& plan = sSharedPlans[N];
+  if( plan == nullptr ) {
+    plan = PFFFT::pffft_new_setup( N, PFFFT::PFFFT_REAL );
+  }
+  return plan;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FFTService::AlignedDeleter::operator()(float* ptr) const
+{
+  PFFFT::pffft_aligned_free( (void*)ptr );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FFTService::AlignedBuffer FFTService::AllocateAligned(size_t numFloats)
+{
+  return AlignedBuffer( (float*) PFFFT::pffft_aligned_malloc( numFloats * sizeof(float) ) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FFTService::DeinterleaveToFloat(const AudioUtil::AudioSample* interleaved,
+                                     size_t numFrames,
+                                     size_t numChannels,
+                                     float* const* outChannels,
+                                     float scale)
+{
+  size_t frame = 0;
+
+  if( numChannels == 4 ) {
+#ifdef __ARM_NEON__
+    // vld4 deinterleaves 4 frames of 4 channels in one go
+    const float32x4_t scaleVec = vdupq_n_f32( scale );
+    for( ; frame + 4 <= numFrames; frame += 4 ) {
+      const int16x4x4_t samples = vld4_s16( interleaved + frame*4 );
+      for( size_t ch = 0; ch < 4; ++ch ) {
+        const float32x4_t values = vcvtq_f32_s32( vmovl_s16( samples.val[ch] ) );
+        vst1q_f32( outChannels[ch] + frame, vmulq_f32( values, scaleVec ) );
+      }
+    }
+#elif defined(__SSE2__)
+    // Transpose 4 frames of 4 channels with two rounds of 16 bit unpacks
+    const __m128 scaleVec = _mm_set1_ps( scale );
+    for( ; frame + 4 <= numFrames; frame += 4 ) {
+      const __m128i frames01 = _mm_loadu_si128( (const __m128i*)(interleaved + frame*4) );
+      const __m128i frames23 = _mm_loadu_si128( (const __m128i*)(interleaved + frame*4 + 8) );
+      // [f0c0 f2c0 f0c1 f2c1 f0c2 f2c2 f0c3 f2c3], [f1c0 f3c0 f1c1 f3c1 ...]
+      const __m128i evenFrames = _mm_unpacklo_epi16( frames01, frames23 );
+      const __m128i oddFrames  = _mm_unpackhi_epi16( frames01, frames23 );
+      // [c0 x4, c1 x4], [c2 x4, c3 x4]
+      const __m128i ch01 = _mm_unpacklo_epi16( evenFrames, oddFrames );
+      const __m128i ch23 = _mm_unpackhi_epi16( evenFrames, oddFrames );
+      // Sign extend to 32 bits by unpacking into the high half and shifting back down
+      const __m128i ch0 = _mm_srai_epi32( _mm_unpacklo_epi16( ch01, ch01 ), 16 );
+      const __m128i ch1 = _mm_srai_epi32( _mm_unpackhi_epi16( ch01, ch01 ), 16 );
+      const __m128i ch2 = _mm_srai_epi32( _mm_unpacklo_epi16( ch23, ch23 ), 16 );
+      const __m128i ch3 = _mm_srai_epi32( _mm_unpackhi_epi16( ch23, ch23 ), 16 );
+      _mm_storeu_ps( outChannels[0] + frame, _mm_mul_ps( _mm_cvtepi32_ps( ch0 ), scaleVec ) );
+      _mm_storeu_ps( outChannels[1] + frame, _mm_mul_ps( _mm_cvtepi32_ps( ch1 ), scaleVec ) );
+      _mm_storeu_ps( outChannels[2] + frame, _mm_mul_ps( _mm_cvtepi32_ps( ch2 ), scaleVec ) );
+      _mm_storeu_ps( outChannels[3] + frame, _mm_mul_ps( _mm_cvtepi32_ps( ch3 ), scaleVec ) );
+    }
+#endif
+  }
+
+  for( ; frame < numFrames; ++frame ) {
+    for( size_t ch = 0; ch < numChannels; ++ch ) {
+      outChannels[ch][frame] = interleaved[frame*numChannels + ch] * scale;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RealFFT::RealFFT( unsigned int N, bool ownPlan )
+: _N{ N }
+, _ownPlan{ ownPlan }
+{
+  if( _ownPlan ) {
+    _plan = FFTService::IsValidSize( _N ) ? PFFFT::pffft_new_setup( _N, PFFFT::PFFFT_REAL ) : nullptr;
+  } else {
+    _plan = FFTService::GetSharedPlan( _N );
+  }
+
+  if( _plan == nullptr ) {
+    LOG_ERROR("RealFFT.InvalidPlan", "Could not create plan for %u samples", _N);
+    return;
+  }
+
+  _inData = FFTService::AllocateAligned( _N );
+  _outData = FFTService::AllocateAligned( _N );
+  // pffft would otherwise put the work area on the stack, which is too much for the larger sizes
+  _workData = FFTService::AllocateAligned( _N );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RealFFT::~RealFFT()
+{
+  if( _ownPlan && (_plan != nullptr) ) {
+    PFFFT::pffft_destroy_setup( _plan );
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const float* RealFFT::Transform( const float* input )
+{
+  DEV_ASSERT( IsValid(), "RealFFT.Transform.InvalidPlan" );
+  PFFFT::pffft_transform_ordered( _plan,
+                                  (input != nullptr) ? input : _inData.get(),
+                                  _outData.get(),
+                                  _workData.get(),
+                                  PFFFT::PFFFT_FORWARD );
+  return _outData.get();
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,99 @@
+/**
+ * File: fftService.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Shared real-input, single precision FFTs for the anim process, backed by pffft.
+ *              Plans for sizes that are used over and over (e.g. by AudioFFT) are created once and shared
+ *              between all users, since pffft plans are read-only after creation. Each RealFFT allocates
+ *              its aligned buffers up front, so transforming doesn't allocate.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ */
+
+#ifndef ANIMPROCESS_COZMO_MICDATA_FFTSERVICE_H
+#define ANIMPROCESS_COZMO_MICDATA_FFTSERVICE_H
+#pragma once
+
+#include "audioUtil/audioDataTypes.h"
+#include "util/helpers/noncopyable.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace PFFFT {
+  struct PFFFT_Setup;
+}
+
+namespace Anki {
+namespace Vector {
+
+namespace FFTService {
+
+  // Returns true if pffft can do a real transform of size N, i.e. N = 2^a * 3^b * 5^c with a >= 5
+  bool IsValidSize(unsigned int N);
+
+  // Returns the largest valid size <= N, or 0 if there is none
+  unsigned int GetLargestValidSize(unsigned int N);
+
+  // Returns the shared plan for a real transform of size N, creating it on first use. Thread safe. Shared plans
+  // live for the lifetime of the process, so only use this for sizes that are used repeatedly.
+  PFFFT::PFFFT_Setup* GetSharedPlan(unsigned int N);
+
+  // SIMD aligned float buffers
+  struct AlignedDeleter {
+    void operator()(float* ptr) const;
+  };
+  using AlignedBuffer = std::unique_ptr<float[], AlignedDeleter>;
+  AlignedBuffer AllocateAligned(size_t numFloats);
+
+  // Splits numFrames of interleaved samples into per-channel float buffers, multiplying each sample by scale.
+  // Vectorized for 4 channels, which is what the raw mic data has.
+  void DeinterleaveToFloat(const AudioUtil::AudioSample* interleaved,
+                           size_t numFrames,
+                           size_t numChannels,
+                           float* const* outChannels,
+                           float scale);
+
+}
+
+class RealFFT : private Anki::Util::noncopyable
+{
+public:
+
+  // Uses the shared plan for N unless ownPlan is set, which is intended for one-off sizes
+  explicit RealFFT( unsigned int N, bool ownPlan = false );
+
+  ~RealFFT();
+
+  bool IsValid() const { return _plan != nullptr; }
+
+  unsigned int GetSize() const { return _N; }
+
+  // Aligned buffer of N floats to fill before calling Transform()
+  float* GetInput() { return _inData.get(); }
+
+  // Forward transform of GetInput(), or of input if given (must be aligned and hold N floats). The output holds
+  // interleaved complex numbers, except that the first pair is the real DC and Nyquist components.
+  const float* Transform( const float* input = nullptr );
+
+  const float* GetOutput() const { return _outData.get(); }
+
+private:
+
+  const unsigned int _N;
+  const bool _ownPlan;
+  PFFFT::PFFFT_Setup* _plan = nullptr;
+
+  FFTService::AlignedBuffer _inData;
+  FFTService::AlignedBuffer _outData;
+  FFTService::AlignedBuffer _workData;
+
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // ANIMPROCESS_COZMO_MICDATA_FFTSERVICE_H
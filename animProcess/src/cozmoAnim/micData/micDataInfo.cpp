@@ -10,7 +10,7 @@
 *
 */
 
-#include "cozmoAnim/FftComplex.h"
+#include "cozmoAnim/micData/fftService.h"
 #include "cozmoAnim/micData/micDataInfo.h"
 #include "audioUtil/waveFile.h"
 #include "util/fileUtils/fileUtils.h"
@@ -18,6 +18,8 @@
 #include "util/math/math.h"
 #include "util/math/numericCast.h"
 #include "util/threading/threadPriority.h"
+#include <algorithm>
+#include <array>
 #include <iomanip>
 #include <sstream>
 #include <thread>
@@ -74,6 +76,9 @@ void MicDataInfo::CollectProcessedAudio(const AudioUtil::AudioSample* audioChunk
       // Copy entire chunk
       std::copy(audioChunk, audioChunk + size, newChunk.begin());
     }
+    if (_opusEncoder != nullptr) {
+      _opusEncoder->Encode(newChunk.data(), newChunk.size(), _opusPackets);
+    }
     _processedAudioData.push_back(std::move(newChunk));
   }
 }
@@ -101,6 +106,37 @@ AudioUtil::AudioChunkList MicDataInfo::GetProcessedAudio(size_t beginIndex)
   return copiedData;
 }
 
+void MicDataInfo::EnableOpusEncoding(int32_t bitrate_bps)
+{
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  if (!_processedAudioData.empty()) {
+    LOG_WARNING("MicDataInfo.EnableOpusEncoding",
+                "Attempt to enable opus encoding after collecting processed audio");
+    return;
+  }
+
+  _opusEncoder.reset(new MicDataOpusEncoder(bitrate_bps));
+  if (!_opusEncoder->IsValid()) {
+    _opusEncoder.reset();
+  }
+}
+
+bool MicDataInfo::IsOpusEncoding() const
+{
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  return (_opusEncoder != nullptr);
+}
+
+MicDataOpus::PacketList MicDataInfo::GetOpusPackets(size_t beginIndex)
+{
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  if (beginIndex >= _opusPackets.size())
+  {
+    return MicDataOpus::PacketList{};
+  }
+  return MicDataOpus::PacketList(_opusPackets.begin() + beginIndex, _opusPackets.end());
+}
+
 void MicDataInfo::SetTimeToRecord(uint32_t timeToRecord)
 {
   std::lock_guard<std::mutex> lock(_dataMutex);
@@ -344,22 +380,55 @@ std::vector<uint32_t> MicDataInfo::GetFFTResultFromRaw(const AudioUtil::AudioChu
 {
   std::vector<uint32_t> perChannelFFT;
   
-  // Run a seperate fft for each of the channels/mics
+  size_t numFrames = 0;
+  for(const auto& chunk : data)
+  {
+    numFrames += chunk.size() / kNumInputChannels;
+  }
+  
+  // pffft only handles certain sizes, so drop the end of the recording to get to the nearest one below. This
+  // shortens the recording by well under a percent for anything long enough to be worth analyzing.
+  const unsigned int fftSize = FFTService::GetLargestValidSize(Util::numeric_cast<unsigned int>(numFrames));
+  if (fftSize == 0)
+  {
+    LOG_WARNING("MicDataInfo.GetFFTResultFromRaw.TooShort", "Only %zu samples per channel", numFrames);
+    return std::vector<uint32_t>(kNumInputChannels, 0);
+  }
+  const float fftLength_s = length_s * fftSize / numFrames;
+  
+  // One-off size, so don't keep the plan around
+  const bool ownPlan = true;
+  RealFFT fft(fftSize, ownPlan);
+  if (!fft.IsValid())
+  {
+    return std::vector<uint32_t>(kNumInputChannels, 0);
+  }
+  
+  // Deinterlace all channels in one pass over the raw audio chunks, then run the same fft on each of the
+  // channels/mics. Order in each raw audio chunk is channel 0,1,2,3,0,1,2,3,...
+  FFTService::AlignedBuffer channelData = FFTService::AllocateAligned(kNumInputChannels * fftSize);
+  std::array<float*, kNumInputChannels> channels;
   for(auto i = 0; i < kNumInputChannels; ++i)
   {
-    // Deinterlace the current channel from the raw audio chunks
-    // Order in each raw audio chunk is channel 0,1,2,3,0,1,2,3,...
-    std::vector<std::complex<double> > fftArray;
-    for(const auto& chunk : data)
+    channels[i] = channelData.get() + i * fftSize;
+  }
+  
+  size_t frameIdx = 0;
+  for(auto chunkIter = data.begin(); (chunkIter != data.end()) && (frameIdx < fftSize); ++chunkIter)
+  {
+    const size_t numChunkFrames = std::min(chunkIter->size() / kNumInputChannels, fftSize - frameIdx);
+    std::array<float*, kNumInputChannels> chunkChannels;
+    for(auto i = 0; i < kNumInputChannels; ++i)
     {
-      for(uint32_t j = i; j < chunk.size(); j += kNumInputChannels)
-      {
-        fftArray.push_back(chunk[j]);
-      }
+      chunkChannels[i] = channels[i] + frameIdx;
     }
-    
-    // Run fft in place
-    Fft::transform(fftArray);
+    FFTService::DeinterleaveToFloat(chunkIter->data(), numChunkFrames, kNumInputChannels, chunkChannels.data(), 1.0f);
+    frameIdx += numChunkFrames;
+  }
+  
+  for(auto i = 0; i < kNumInputChannels; ++i)
+  {
+    const float* fftResult = fft.Transform(channels[i]);
     
     // Keep track of the largest/most prominent value and index
     // from the fft
@@ -368,20 +437,20 @@ std::vector<uint32_t> MicDataInfo::GetFFTResultFromRaw(const AudioUtil::AudioChu
     float    largestValue    = 0;
     uint32_t largestValueIdx = 0;
     
-    // Skip the first one since it is garbage and often really large
-    // Only look at the first half since the second half is just the inverse of the first
-    // Only look at every other element to save processing time
-    for(int i = 1; i < fftArray.size()/2; i += 2)
+    // Skip the first one since it is garbage and often really large (it also holds the nyquist component)
+    // Only the first half is computed since the second half is just the inverse of the first
+    for(uint32_t bin = 1; bin < fftSize/2; ++bin)
     {
-      const auto& e = fftArray[i];
-      float magSq = e.real()*e.real() + e.imag()*e.imag();
+      const float re = fftResult[2*bin];
+      const float im = fftResult[2*bin + 1];
+      const float magSq = re*re + im*im;
       if(magSq > largestValue)
       {
         largestValue = magSq;
-        largestValueIdx = i;
+        largestValueIdx = bin;
       }
     }
-    perChannelFFT.push_back((uint32_t)(largestValueIdx/length_s));
+    perChannelFFT.push_back((uint32_t)(largestValueIdx/fftLength_s));
   }
   
   return perChannelFFT;
@@ -14,12 +14,14 @@
 #define __AnimProcess_CozmoAnim_MicDataInfo_H_
 
 #include "micDataTypes.h"
+#include "cozmoAnim/micData/micDataOpus.h"
 #include "audioUtil/audioDataTypes.h"
 #include "clad/cloud/mic.h"
 #include "util/bitFlags/bitFlags.h"
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -60,6 +62,12 @@ public:
   void CollectProcessedAudio(const AudioUtil::AudioSample* audioChunk, size_t size);
 
   AudioUtil::AudioChunkList GetProcessedAudio(size_t beginIndex);
+
+  // Opus encode the processed audio as it's collected, on the processing thread, for streaming.
+  // Note: Must be enabled before CollectProcessedAudio() is called
+  void EnableOpusEncoding(int32_t bitrate_bps);
+  bool IsOpusEncoding() const;
+  MicDataOpus::PacketList GetOpusPackets(size_t beginIndex);
   void UpdateForNextChunk();
   bool CheckDone() const;
   uint32_t GetTimeToRecord_ms() const;
@@ -81,6 +89,8 @@ private:
   
   AudioUtil::AudioChunkList _rawAudioData{};
   AudioUtil::AudioChunkList _processedAudioData{};
+  std::unique_ptr<MicDataOpusEncoder> _opusEncoder;
+  MicDataOpus::PacketList _opusPackets{};
   mutable std::mutex _dataMutex;
 
   void SaveCollectedAudio(const std::string& dataDirectory, const std::string& nameToUse, const std::string& nameToRemove);
@@ -0,0 +1,193 @@
+/**
+* File: micDataOpus.cpp
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Opus encoding of processed mic audio for streaming to the cloud process, plus the matching
+*              decoder.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+
+#include "cozmoAnim/micData/micDataOpus.h"
+
+#include "util/logging/logging.h"
+
+#include "opus/opus.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#define LOG_CHANNEL "Microphones"
+
+namespace Anki {
+namespace Vector {
+namespace MicData {
+
+namespace {
+  // Recommended maximum packet size from the libopus docs
+  constexpr int32_t kMaxPacketSize = 1276;
+
+  static_assert(std::is_same<AudioUtil::AudioSample, opus_int16>::value,
+                "Expecting AudioSample to be usable as opus_int16");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MicDataOpusEncoder::MicDataOpusEncoder(int32_t bitrate_bps)
+{
+  int error = OPUS_OK;
+  _encoder = opus_encoder_create(AudioUtil::kSampleRate_hz, 1, OPUS_APPLICATION_VOIP, &error);
+  if (error != OPUS_OK) {
+    LOG_ERROR("MicDataOpusEncoder.Create", "Failed to create encoder: %s", opus_strerror(error));
+    _encoder = nullptr;
+    return;
+  }
+
+  opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(bitrate_bps));
+  opus_encoder_ctl(_encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MicDataOpusEncoder::~MicDataOpusEncoder()
+{
+  if (_encoder != nullptr) {
+    opus_encoder_destroy(_encoder);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MicDataOpusEncoder::Encode(const AudioUtil::AudioSample* samples,
+                                size_t numSamples,
+                                MicDataOpus::PacketList& outPackets)
+{
+  if (!IsValid()) {
+    return false;
+  }
+
+  while (numSamples > 0) {
+    const size_t numToCopy = std::min(numSamples, _frame.size() - _frameNumSamples);
+    std::copy(samples, samples + numToCopy, _frame.begin() + _frameNumSamples);
+    _frameNumSamples += numToCopy;
+    samples += numToCopy;
+    numSamples -= numToCopy;
+
+    if (_frameNumSamples < _frame.size()) {
+      break;
+    }
+    _frameNumSamples = 0;
+
+    MicDataOpus::Packet packet(kMaxPacketSize);
+    const opus_int32 packetSize = opus_encode(_encoder, _frame.data(), (int)_frame.size(),
+                                              packet.data(), (opus_int32)packet.size());
+    if (packetSize < 0) {
+      LOG_ERROR("MicDataOpusEncoder.Encode", "Failed to encode frame: %s", opus_strerror(packetSize));
+      return false;
+    }
+    packet.resize(packetSize);
+    outPackets.push_back(std::move(packet));
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int32_t MicDataOpusEncoder::GetLookahead() const
+{
+  opus_int32 lookahead = 0;
+  if (IsValid()) {
+    opus_encoder_ctl(_encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+  }
+  return lookahead;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MicDataOpusDecoder::MicDataOpusDecoder()
+{
+  int error = OPUS_OK;
+  _decoder = opus_decoder_create(AudioUtil::kSampleRate_hz, 1, &error);
+  if (error != OPUS_OK) {
+    LOG_ERROR("MicDataOpusDecoder.Create", "Failed to create decoder: %s", opus_strerror(error));
+    _decoder = nullptr;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MicDataOpusDecoder::~MicDataOpusDecoder()
+{
+  if (_decoder != nullptr) {
+    opus_decoder_destroy(_decoder);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MicDataOpusDecoder::Decode(const MicDataOpus::Packet& packet, AudioUtil::AudioChunk& outSamples)
+{
+  if (!IsValid()) {
+    return false;
+  }
+
+  const size_t prevSize = outSamples.size();
+  outSamples.resize(prevSize + MicDataOpus::kFrameNumSamples);
+  const int numDecoded = opus_decode(_decoder, packet.data(), (opus_int32)packet.size(),
+                                     outSamples.data() + prevSize, (int)MicDataOpus::kFrameNumSamples, 0);
+  if (numDecoded != (int)MicDataOpus::kFrameNumSamples) {
+    LOG_ERROR("MicDataOpusDecoder.Decode", "Failed to decode packet of %zu bytes: %s",
+              packet.size(), (numDecoded < 0) ? opus_strerror(numDecoded) : "unexpected frame size");
+    outSamples.resize(prevSize);
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MicDataOpus::RunRoundTrip(const AudioUtil::AudioSample* samples,
+                               size_t numSamples,
+                               int32_t bitrate_bps,
+                               RoundTripStats& outStats)
+{
+  MicDataOpusEncoder encoder(bitrate_bps);
+  MicDataOpusDecoder decoder;
+  if (!encoder.IsValid() || !decoder.IsValid()) {
+    return false;
+  }
+
+  PacketList packets;
+  if (!encoder.Encode(samples, numSamples, packets)) {
+    return false;
+  }
+
+  AudioUtil::AudioChunk decoded;
+  decoded.reserve(packets.size() * kFrameNumSamples);
+  for (const auto& packet : packets) {
+    if (!decoder.Decode(packet, decoded)) {
+      return false;
+    }
+  }
+
+  outStats.numPackets = packets.size();
+  outStats.numEncodedBytes = 0;
+  for (const auto& packet : packets) {
+    outStats.numEncodedBytes += packet.size();
+  }
+
+  // Decoded sample i + lookahead corresponds to input sample i
+  const size_t lookahead = (size_t)encoder.GetLookahead();
+  double signalPower = 0.0;
+  double noisePower = 0.0;
+  for (size_t i = 0; i + lookahead < decoded.size(); ++i) {
+    const double signal = samples[i];
+    const double error = (double)decoded[i + lookahead] - signal;
+    signalPower += signal * signal;
+    noisePower += error * error;
+  }
+  outStats.snr_dB = (noisePower > 0.0) ? (float)(10.0 * std::log10(signalPower / noisePower)) : 0.f;
+
+  return true;
+}
+
+} // namespace MicData
+} // namespace Vector
+} // namespace Anki
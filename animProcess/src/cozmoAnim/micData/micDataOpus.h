@@ -0,0 +1,103 @@
+/**
+* File: micDataOpus.h
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Opus encoding of processed mic audio for streaming to the cloud process, plus the matching
+*              decoder. Audio is encoded in fixed frames of kFrameNumSamples mono samples, one Opus packet
+*              per frame. Packets must be decoded in order, with none dropped, since the codec state carries
+*              over from one to the next.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+
+#ifndef __AnimProcess_CozmoAnim_MicDataOpus_H_
+#define __AnimProcess_CozmoAnim_MicDataOpus_H_
+
+#include "audioUtil/audioDataTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fwd decl
+struct OpusEncoder;
+struct OpusDecoder;
+
+namespace Anki {
+namespace Vector {
+namespace MicData {
+
+namespace MicDataOpus {
+  constexpr uint32_t kFrameSize_ms       = 20;
+  constexpr uint32_t kFrameNumSamples    = (AudioUtil::kSampleRate_hz / 1000) * kFrameSize_ms;
+  constexpr int32_t  kDefaultBitrate_bps = 24000;
+
+  using Packet     = std::vector<uint8_t>;
+  using PacketList = std::vector<Packet>;
+}
+
+class MicDataOpusEncoder
+{
+public:
+  explicit MicDataOpusEncoder(int32_t bitrate_bps = MicDataOpus::kDefaultBitrate_bps);
+  ~MicDataOpusEncoder();
+
+  MicDataOpusEncoder(const MicDataOpusEncoder&) = delete;
+  MicDataOpusEncoder& operator=(const MicDataOpusEncoder&) = delete;
+
+  bool IsValid() const { return _encoder != nullptr; }
+
+  // Buffers the samples and appends a packet to outPackets for every full frame. Leftover samples are kept
+  // for the next call. Returns false if encoding failed.
+  bool Encode(const AudioUtil::AudioSample* samples, size_t numSamples, MicDataOpus::PacketList& outPackets);
+
+  // Number of samples the decoded audio is delayed by, relative to the encoded audio
+  int32_t GetLookahead() const;
+
+private:
+  OpusEncoder* _encoder = nullptr;
+
+  std::array<AudioUtil::AudioSample, MicDataOpus::kFrameNumSamples> _frame;
+  size_t _frameNumSamples = 0;
+};
+
+class MicDataOpusDecoder
+{
+public:
+  MicDataOpusDecoder();
+  ~MicDataOpusDecoder();
+
+  MicDataOpusDecoder(const MicDataOpusDecoder&) = delete;
+  MicDataOpusDecoder& operator=(const MicDataOpusDecoder&) = delete;
+
+  bool IsValid() const { return _decoder != nullptr; }
+
+  // Decodes one packet and appends its kFrameNumSamples samples to outSamples. Returns false on a corrupt packet.
+  bool Decode(const MicDataOpus::Packet& packet, AudioUtil::AudioChunk& outSamples);
+
+private:
+  OpusDecoder* _decoder = nullptr;
+};
+
+namespace MicDataOpus {
+  struct RoundTripStats {
+    size_t numPackets      = 0;
+    size_t numEncodedBytes = 0;
+    float  snr_dB          = 0.f;
+  };
+
+  // Encodes then decodes the samples, to check the encoding stage end to end. The SNR is computed after
+  // compensating for the encoder lookahead, over all complete frames.
+  bool RunRoundTrip(const AudioUtil::AudioSample* samples, size_t numSamples, int32_t bitrate_bps,
+                    RoundTripStats& outStats);
+}
+
+} // namespace MicData
+} // namespace Vector
+} // namespace Anki
+
+#endif // __AnimProcess_CozmoAnim_MicDataOpus_H_
@@ -37,6 +37,8 @@
 #include "util/math/math.h"
 #include "util/threading/threadPriority.h"
 #include "clad/robotInterface/messageRobotToEngine_sendAnimToEngine_helper.h"
+#include <algorithm>
+#include <chrono>
 #include <list>
 #include <sched.h>
 
@@ -57,6 +59,11 @@ namespace {
   // performance. Note that this probably needs to at least be as long as the trigger, which is ~ 500-750ms.
   CONSOLE_VAR_RANGED(uint32_t, kMicData_QuietTimeCooldown_ms, CONSOLE_GROUP, 1000, 500, 10000);
 
+  // Opus encode the audio streamed to the cloud process instead of sending raw PCM. Requires a cloud
+  // process that handles the audioOpus message, so it's off by default.
+  CONSOLE_VAR(bool, kMicData_OpusStreaming, CONSOLE_GROUP, false);
+  CONSOLE_VAR_RANGED(int32_t, kMicData_OpusBitrate_bps, CONSOLE_GROUP, MicDataOpus::kDefaultBitrate_bps, 6000, 64000);
+
 #if ANKI_DEV_CHEATS
 
   CONSOLE_VAR(bool, kMicData_SaveRawFullIntent, CONSOLE_GROUP, false);
@@ -94,12 +101,29 @@ constexpr auto kCladMicDataTypeSize = sizeof(RobotInterface::MicData::data)/size
 static_assert(kCladMicDataTypeSize == kIncomingAudioChunkSize,
               "Expecting size of MicData::data to match kIncomingAudioChunkSize");
 
+struct MicDataProcessor::RawAudioSlot
+{
+  RobotInterface::MicData micData;
+  std::chrono::steady_clock::time_point receivedTime;
+};
+
 
 
 void MicDataProcessor::SetupConsoleFuncs()
 {
 #if ANKI_DEV_CHEATS
-  // TODO: Left method for furture console vars
+  const auto printRawAudioRingStatsFunc = [this](ConsoleFunctionContextRef context)
+  {
+    const auto stats = GetRawAudioRingStats();
+    std::string histogram;
+    for (size_t i = 0; i < stats.latencyHistogram_ms.size(); ++i) {
+      const bool isLast = (i + 1 == stats.latencyHistogram_ms.size());
+      histogram += isLast ? (" >=" + std::to_string(1u << (i - 1))) : (" <" + std::to_string(1u << i));
+      histogram += "ms:" + std::to_string(stats.latencyHistogram_ms[i]);
+    }
+    context->channel->WriteLog("Raw audio ring: %u overruns, latency%s", stats.numOverruns, histogram.c_str());
+  };
+  sConsoleFuncs.emplace_front("RawAudioRingStats", std::move(printRawAudioRingStatsFunc), CONSOLE_GROUP, "");
 #endif
 }
 # undef CONSOLE_GROUP
@@ -111,6 +135,7 @@ MicDataProcessor::MicDataProcessor(const Anim::AnimContext* context, MicDataSyst
 , _micDataSystem(micDataSystem)
 , _writeLocationDir(writeLocation)
 , _micImmediateDirection(std::make_unique<MicImmediateDirection>())
+, _rawAudioRing(std::make_unique<RawAudioRing>())
 , _beatDetector(std::make_unique<BeatDetector>())
 {
   // Init the various SE processing
@@ -282,6 +307,9 @@ RobotTimeStamp_t MicDataProcessor::CreateStreamJob(CloudMic::StreamType streamTy
   newJob->EnableDataCollect(MicDataType::Processed, saveToFile);
   newJob->SetTimeToRecord(MicDataInfo::kMaxRecordTime_ms);
   newJob->SetAudioFadeInTime(MicDataInfo::kDefaultAudioFadeIn_ms);
+  if (kMicData_OpusStreaming) {
+    newJob->EnableOpusEncoding(kMicData_OpusBitrate_bps);
+  }
   
   // Copy the current audio chunks in the trigger overlap buffer
   // The immediate buffer is bigger than just the overlap time (time right after trigger end but before trigger was
@@ -689,21 +717,16 @@ void MicDataProcessor::ProcessRawLoop()
     ANKI_CPU_TICK("MicDataProcessorRaw", maxProcTime_ms, Util::CpuProfiler::CpuProfilerLoggingTime(kMicDataProcessorRaw_Logging));
     const auto start = std::chrono::steady_clock::now();
   
-    // Switch which buffer we're processing if it's empty
-    {
-      std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-      if (_rawAudioBuffers[_rawAudioProcessingIndex].empty())
-      {
-        _rawAudioProcessingIndex = (_rawAudioProcessingIndex == 1) ? 0 : 1;
-      }
-    }
-
-    auto& rawAudioToProcess = _rawAudioBuffers[_rawAudioProcessingIndex];
-    while (rawAudioToProcess.size() > 0)
+    // Process everything the anim thread has handed over since last time, in place in the ring
+    const RawAudioSlot* nextSlot = nullptr;
+    while ((nextSlot = _rawAudioRing->BeginRead()) != nullptr)
     {
       ANKI_CPU_PROFILE("ProcessLoop");
 
-      const auto& nextData = rawAudioToProcess.front();
+      const auto waitTime = std::chrono::steady_clock::now() - nextSlot->receivedTime;
+      RecordRawAudioLatency((uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(waitTime).count());
+
+      const auto& nextData = nextSlot->micData;
       const auto* audioChunk = nextData.data;
       
       // Copy the current set of jobs we have for recording audio, so the list can be added to while processing
@@ -730,7 +753,7 @@ void MicDataProcessor::ProcessRawLoop()
       
       _micDataSystem->UpdateMicJobs();
       
-      rawAudioToProcess.pop_front();
+      _rawAudioRing->CommitRead();
     }
 
     const auto end = std::chrono::steady_clock::now();
@@ -829,19 +852,35 @@ void MicDataProcessor::UpdateBeatDetector(const AudioUtil::AudioSample* const sa
   
 void MicDataProcessor::ProcessMicDataPayload(const RobotInterface::MicData& payload)
 {
-  // Store off this next job
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-  if (!_muteMics) {
-    // Use whichever buffer is currently _not_ being processed
-    auto& bufferToUse = (_rawAudioProcessingIndex == 1) ? _rawAudioBuffers[0] : _rawAudioBuffers[1];
-    RobotInterface::MicData& nextJob = bufferToUse.push_back();
-    nextJob = payload;
+  if (_muteMics) {
+    return;
+  }
+
+  // Store off this next job. If the processing thread has fallen so far behind that the ring is full, drop the new
+  // chunk rather than block the anim thread.
+  RawAudioSlot* nextSlot = _rawAudioRing->BeginWrite();
+  if (nextSlot == nullptr) {
+    const uint32_t numOverruns = ++_rawAudioRingOverruns;
+    // Only log occasionally, since this happens every chunk while processing is stalled
+    if ((numOverruns % kRawAudioBufferSize) == 1) {
+      LOG_WARNING("MicDataProcessor.ProcessMicDataPayload.RingFull",
+                  "Dropping raw mic chunk, %u dropped so far", numOverruns);
+    }
+    return;
+  }
+  nextSlot->micData = payload;
+  nextSlot->receivedTime = std::chrono::steady_clock::now();
+  _rawAudioRing->CommitWrite();
+
+  // Only this thread raises the peak, so a plain load/store is enough
+  const size_t ringSize = _rawAudioRing->Size();
+  if (ringSize > _rawAudioRingPeakSize.load(std::memory_order_relaxed)) {
+    _rawAudioRingPeakSize.store(ringSize, std::memory_order_relaxed);
   }
 }
   
 void MicDataProcessor::MuteMics(bool mute)
 {
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
   _muteMics = mute;
 }
 
@@ -853,15 +892,41 @@ void MicDataProcessor::ResetMicListenDirection()
 
 float MicDataProcessor::GetIncomingMicDataPercentUsed()
 {
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-  // Use whichever buffer is currently _not_ being processed
-  const auto inUseIndex = (_rawAudioProcessingIndex == 1) ? 0 : 1;
-  const auto& bufferInUse = _rawAudioBuffers[inUseIndex];
-  const auto updatedFullness = ((float)bufferInUse.size()) / ((float)bufferInUse.capacity());
-  // Cache the current fullness for this buffer and use the greater of the two buffer fullnesses
-  // This way the "fullness" returned is less variable and better covers the worst case
-  _rawAudioBufferFullness[inUseIndex] = updatedFullness;
-  return MAX(_rawAudioBufferFullness[0], _rawAudioBufferFullness[1]);
+  // Report the worst backlog since the last call, relative to the size of one of the old double buffers, so that the
+  // value keeps the meaning it had before the ring (1.0 == one buffer's worth of audio waiting)
+  const size_t peakSize = std::max(_rawAudioRingPeakSize.exchange(0, std::memory_order_relaxed),
+                                   _rawAudioRing->Size());
+  const auto fullness = ((float)peakSize) / ((float)kRawAudioBufferSize);
+  return MIN(fullness, 1.f);
+}
+
+void MicDataProcessor::RecordRawAudioLatency(uint32_t latency_ms)
+{
+  size_t bucket = 0;
+  while ((bucket + 1 < kNumRawLatencyBuckets) && (latency_ms >= (1u << bucket))) {
+    ++bucket;
+  }
+  _rawAudioLatencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  uint32_t maxLatency_ms = _rawAudioMaxLatency_ms.load(std::memory_order_relaxed);
+  while ((latency_ms > maxLatency_ms) &&
+         !_rawAudioMaxLatency_ms.compare_exchange_weak(maxLatency_ms, latency_ms, std::memory_order_relaxed)) {
+  }
+}
+
+MicDataProcessor::RawAudioRingStats MicDataProcessor::GetRawAudioRingStats() const
+{
+  RawAudioRingStats stats;
+  stats.numOverruns = _rawAudioRingOverruns.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kNumRawLatencyBuckets; ++i) {
+    stats.latencyHistogram_ms[i] = _rawAudioLatencyHistogram[i].load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+uint32_t MicDataProcessor::PopMaxRawAudioLatency_ms()
+{
+  return _rawAudioMaxLatency_ms.exchange(0, std::memory_order_relaxed);
 }
 
 void MicDataProcessor::SetActiveMicDataProcessingState(MicDataProcessor::ProcessingState state)
@@ -19,6 +19,7 @@
 #include "micDataTypes.h"
 #include "coretech/common/engine/robotTimeStamp.h"
 #include "cozmoAnim/micData/micTriggerConfig.h"
+#include "cozmoAnim/micData/spscRing.h"
 #include "clad/cloud/mic.h"
 #include "util/container/fixedCircularBuffer.h"
 #include "util/global/globalDefinitions.h"
@@ -84,6 +85,20 @@ public:
   
   void ResetMicListenDirection();
   float GetIncomingMicDataPercentUsed();
+
+  // Stats for the hand off of raw mic data from the anim thread to the processing thread
+  static constexpr size_t kNumRawLatencyBuckets = 8;
+  struct RawAudioRingStats {
+    uint32_t numOverruns = 0; // chunks dropped because the ring was full
+    // Time chunks spent in the ring before processing started. Bucket i counts latencies in [2^(i-1), 2^i) ms,
+    // with bucket 0 for under 1 ms, and the last bucket for everything longer.
+    std::array<uint32_t, kNumRawLatencyBuckets> latencyHistogram_ms{};
+  };
+  RawAudioRingStats GetRawAudioRingStats() const;
+
+  // Returns the longest time a chunk waited in the ring since the last call (meant for a single caller, i.e.
+  // PerfMetricAnim)
+  uint32_t PopMaxRawAudioLatency_ms();
   
   BeatDetector& GetBeatDetector() { assert(nullptr != _beatDetector); return *_beatDetector.get(); }
 
@@ -120,16 +135,19 @@ private:
   std::unique_ptr<MicImmediateDirection> _micImmediateDirection;
 
   static constexpr uint32_t kRawAudioBufferSize = kRawAudioPerBuffer_ms / kTimePerChunk_ms;
-  float _rawAudioBufferFullness[2] = { 0.f, 0.f };
-  // We have 2 fixed buffers for incoming raw audio that we alternate between, so that the processing thread can work
-  // on one set of data while the main thread can copy new data into the other set.
-  Util::FixedCircularBuffer<RobotInterface::MicData, kRawAudioBufferSize> _rawAudioBuffers[2];
-  // Index of the buffer that is currently being used by the processing thread
-  uint32_t _rawAudioProcessingIndex = 0;
+  // Incoming raw audio is handed from the anim thread to the processing thread through a lock-free ring, filled and
+  // processed in place. It holds as much audio as the pair of buffers it replaced.
+  struct RawAudioSlot;
+  using RawAudioRing = SpscRing<RawAudioSlot, 2 * kRawAudioBufferSize>;
+  std::unique_ptr<RawAudioRing> _rawAudioRing;
+  // Largest number of chunks waiting in the ring since GetIncomingMicDataPercentUsed() was last called
+  std::atomic<size_t> _rawAudioRingPeakSize{0};
+  std::atomic<uint32_t> _rawAudioRingOverruns{0};
+  std::array<std::atomic<uint32_t>, kNumRawLatencyBuckets> _rawAudioLatencyHistogram{};
+  std::atomic<uint32_t> _rawAudioMaxLatency_ms{0};
   std::thread _processThread;
   std::thread _processTriggerThread;
-  std::mutex _rawMicDataMutex;
-  bool _muteMics = false;
+  std::atomic<bool> _muteMics{false};
   bool _processThreadStop = false;
   bool _robotWasMoving = false;
   bool _isSpeakerActive = false;
@@ -195,6 +213,9 @@ private:
 
   void ProcessRawLoop();
   void ProcessTriggerLoop();
+
+  // Called by the processing thread when it picks up a raw chunk
+  void RecordRawAudioLatency(uint32_t latency_ms);
   
   void UpdateBeatDetector(const AudioUtil::AudioSample* const samples, const uint32_t nSamples);
   
@@ -44,6 +44,7 @@
 
 #include "clad/robotInterface/messageRobotToEngine_sendAnimToEngine_helper.h"
 
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
@@ -87,6 +88,9 @@ static_assert(
   decltype(MicDirectionData::confidenceList)().size(),
   "Expecting length of RobotInterface::MicDirection::confidenceList to match MicDirectionData::confidenceList");
 
+static_assert(MicDataOpus::kFrameSize_ms % kTimePerChunk_ms == 0,
+              "Expecting opus frames to hold a whole number of processed audio chunks");
+
 void MicDataSystem::SetupConsoleFuncs()
 {
 #if ANKI_DEV_CHEATS
@@ -107,6 +111,30 @@ void MicDataSystem::SetupConsoleFuncs()
     }
   };
   _devConsoleFuncs.emplace_front("ClearMicData", std::move(clearMicDataFunc), CONSOLE_GROUP".zHiddenForSafety", "");
+
+  const auto opusRoundTripFunc = [](ConsoleFunctionContextRef context)
+  {
+    // Encode and decode one second of a swept tone, to check the opus streaming stage end to end
+    const int32_t bitrate_bps = ConsoleArg_GetOptional_Int(context, "bitrate_bps", MicDataOpus::kDefaultBitrate_bps);
+    AudioUtil::AudioChunk samples(AudioUtil::kSampleRate_hz);
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const float t_s = (float)i / AudioUtil::kSampleRate_hz;
+      const float freq_hz = 200.f + 1800.f * t_s;
+      samples[i] = (AudioUtil::AudioSample)(8000.f * std::sin(M_PI_F * freq_hz * t_s));
+    }
+
+    MicDataOpus::RoundTripStats stats;
+    if (!MicDataOpus::RunRoundTrip(samples.data(), samples.size(), bitrate_bps, stats)) {
+      context->channel->WriteLog("Opus round trip failed");
+      return;
+    }
+    const size_t rawBytes = stats.numPackets * MicDataOpus::kFrameNumSamples * sizeof(AudioUtil::AudioSample);
+    context->channel->WriteLog("Opus round trip: %zu packets, %zu bytes (%.1fx smaller than PCM), SNR %.1f dB",
+                               stats.numPackets, stats.numEncodedBytes,
+                               (stats.numEncodedBytes > 0) ? (float)rawBytes / stats.numEncodedBytes : 0.f,
+                               stats.snr_dB);
+  };
+  _devConsoleFuncs.emplace_front("OpusRoundTrip", std::move(opusRoundTripFunc), CONSOLE_GROUP, "optional int bitrate_bps");
 #endif
 }
 
@@ -492,6 +520,7 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
         _currentlyStreaming = true;
         _streamingComplete = ShouldSimulateStreaming();
         _streamingAudioIndex = 0;
+        _streamingOpusIndex = 0;
 
         // even though this isn't necessarily the exact frame the backpack lights begin (since that's done in a different
         // thread), it doesn't make a noticeable difference since this is an arbitrary number and doesn't need to be precise
@@ -545,16 +574,34 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
           if (!_fakeStreamingState)
         #endif
           {
-            // Copy any new data that has been pushed onto the currently streaming job
-            AudioUtil::AudioChunkList newAudio = _currentStreamingJob->GetProcessedAudio(_streamingAudioIndex);
-            _streamingAudioIndex += newAudio.size();
+            if (_currentStreamingJob->IsOpusEncoding())
+            {
+              // The processing thread has already encoded the audio, so just send out any new packets
+              MicDataOpus::PacketList newPackets = _currentStreamingJob->GetOpusPackets(_streamingOpusIndex);
+              _streamingOpusIndex += newPackets.size();
+              _streamingAudioIndex += newPackets.size() * (MicDataOpus::kFrameSize_ms / kTimePerChunk_ms);
 
-            // Send the audio to any clients we've got
-            if (_udpServer->HasClient())
+              if (_udpServer->HasClient())
+              {
+                for(auto& packet : newPackets)
+                {
+                  SendUdpMessage(CloudMic::Message::CreateaudioOpus(CloudMic::AudioOpusData{std::move(packet)}));
+                }
+              }
+            }
+            else
             {
-              for(const auto& audioChunk : newAudio)
+              // Copy any new data that has been pushed onto the currently streaming job
+              AudioUtil::AudioChunkList newAudio = _currentStreamingJob->GetProcessedAudio(_streamingAudioIndex);
+              _streamingAudioIndex += newAudio.size();
+
+              // Send the audio to any clients we've got
+              if (_udpServer->HasClient())
               {
-                SendUdpMessage(CloudMic::Message::Createaudio(CloudMic::AudioData{audioChunk}));
+                for(const auto& audioChunk : newAudio)
+                {
+                  SendUdpMessage(CloudMic::Message::Createaudio(CloudMic::AudioData{audioChunk}));
+                }
               }
             }
           }
@@ -174,6 +174,7 @@ private:
   bool _fakeStreamingState = false;
 #endif
   size_t _streamingAudioIndex = 0;
+  size_t _streamingOpusIndex = 0;
   Util::Locale _locale = {"en", "US"};
   std::string _timeZone = "";
 
@@ -64,7 +64,7 @@ void NotchDetector::AddSamples( const short* samples, size_t numSamples, bool an
     
     _sampleIdx = _sampleIdx % kPeriod;
     
-    _powers[_idx] = _audioFFT.GetPower();
+    _audioFFT.GetPower( _powers[_idx] );
     
     ++_idx;
     if( _idx >= _powers.size() ) {
@@ -0,0 +1,97 @@
+/**
+* File: spscRing.h
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Lock-free ring buffer for exactly one producer thread and one consumer thread. Slots are filled
+*              and read in place, so elements are never copied in or out of the ring, and neither side ever
+*              waits on the other.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+
+#ifndef __AnimProcess_CozmoAnim_SpscRing_H_
+#define __AnimProcess_CozmoAnim_SpscRing_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Anki {
+namespace Vector {
+namespace MicData {
+
+template <typename T, size_t kCapacity>
+class SpscRing
+{
+public:
+  static_assert(kCapacity > 0, "SpscRing needs at least one slot");
+
+  SpscRing() = default;
+  SpscRing(const SpscRing& other) = delete;
+  SpscRing& operator=(const SpscRing& other) = delete;
+
+  static constexpr size_t Capacity() { return kCapacity; }
+
+  // Producer only. Returns the next free slot to fill, or nullptr if the ring is full. The slot isn't visible to the
+  // consumer until CommitWrite() is called.
+  T* BeginWrite()
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (Next(head) == _tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &_slots[head];
+  }
+
+  // Producer only. Publishes the slot returned by the last BeginWrite()
+  void CommitWrite()
+  {
+    _head.store(Next(_head.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  // Consumer only. Returns the oldest filled slot, or nullptr if the ring is empty. The slot stays valid until
+  // CommitRead() is called.
+  const T* BeginRead() const
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &_slots[tail];
+  }
+
+  // Consumer only. Hands the slot returned by the last BeginRead() back to the producer
+  void CommitRead()
+  {
+    _tail.store(Next(_tail.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  // Safe from any thread, but only a snapshot
+  size_t Size() const
+  {
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    return (head >= tail) ? (head - tail) : (kNumSlots - tail + head);
+  }
+
+private:
+  // One slot is always left empty to tell a full ring from an empty one
+  static constexpr size_t kNumSlots = kCapacity + 1;
+
+  static size_t Next(size_t index) { return (index + 1 == kNumSlots) ? 0 : (index + 1); }
+
+  std::array<T, kNumSlots> _slots;
+
+  // Keep the indices on separate cache lines so the two threads don't contend on them
+  alignas(64) std::atomic<size_t> _head{0}; // next slot to write
+  alignas(64) std::atomic<size_t> _tail{0}; // next slot to read
+};
+
+} // namespace MicData
+} // namespace Vector
+} // namespace Anki
+
+#endif // __AnimProcess_CozmoAnim_SpscRing_H_
@@ -14,6 +14,8 @@
 #include "cozmoAnim/animation/animationStreamer.h"
 #include "cozmoAnim/animContext.h"
 #include "cozmoAnim/animProcessMessages.h"
+#include "cozmoAnim/micData/micDataProcessor.h"
+#include "cozmoAnim/micData/micDataSystem.h"
 #include "cozmoAnim/perfMetricAnim.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/perfMetric/perfMetricImpl.h"
@@ -30,12 +32,13 @@ namespace Vector {
 
 PerfMetricAnim::PerfMetricAnim(const Anim::AnimContext* context)
   : _frameBuffer(nullptr)
+  , _context(context)
 {
-  _headingLine1 = "                       Anim     Anim    Sleep    Sleep     Over      RtA   AtR   EtA   AtE  Anim Layer";
-  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count  Time Count";
+  _headingLine1 = "                       Anim     Anim    Sleep    Sleep     Over      RtA   AtR   EtA   AtE  Anim Layer   Mic   Mic";
+  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count  Time Count  Drop  Wait";
   _headingLine2Extra = "";
-  _headingLine1CSV = ",,Anim,Anim,Sleep,Sleep,Over,RtA,AtR,EtA,AtE,Anim,Layer";
-  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Time,Count";
+  _headingLine1CSV = ",,Anim,Anim,Sleep,Sleep,Over,RtA,AtR,EtA,AtE,Anim,Layer,Mic,Mic";
+  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Time,Count,Drop,Wait";
   _headingLine2ExtraCSV = "";
 }
 
@@ -93,6 +96,18 @@ void PerfMetricAnim::Update(const float tickDuration_ms,
     frame._relativeStreamTime_ms    = _animationStreamer->GetRelativeStreamTime_ms();
     frame._numLayersRendered        = _animationStreamer->GetNumLayersRendered();
 
+    frame._micRawOverruns      = 0;
+    frame._micRawMaxLatency_ms = 0;
+    const auto* micDataSystem = _context->GetMicDataSystem();
+    auto* micDataProcessor = (micDataSystem != nullptr) ? micDataSystem->GetMicDataProcessor() : nullptr;
+    if (micDataProcessor != nullptr)
+    {
+      const uint32_t micRawOverruns = micDataProcessor->GetRawAudioRingStats().numOverruns;
+      frame._micRawOverruns      = static_cast<uint16_t>(micRawOverruns - _lastMicRawOverruns);
+      frame._micRawMaxLatency_ms = static_cast<uint16_t>(micDataProcessor->PopMaxRawAudioLatency_ms());
+      _lastMicRawOverruns = micRawOverruns;
+    }
+
     if (++_nextFrameIndex >= kNumFramesInBuffer)
     {
       _nextFrameIndex = 0;
@@ -111,6 +126,8 @@ void PerfMetricAnim::InitDumpAccumulators()
   _accMessageCountAtR.Clear();
   _accMessageCountEtA.Clear();
   _accMessageCountAtE.Clear();
+  _accMicRawOverruns.Clear();
+  _accMicRawMaxLatency_ms.Clear();
 }
 
 
@@ -123,6 +140,8 @@ const PerfMetric::FrameMetric& PerfMetricAnim::UpdateDumpAccumulators(const int
   _accMessageCountAtE += frame._messageCountAnimToEngine;
   _accRelativeStreamTime_ms += frame._relativeStreamTime_ms;
   _accNumLayersRendered     += frame._numLayersRendered;
+  _accMicRawOverruns        += frame._micRawOverruns;
+  _accMicRawMaxLatency_ms   += frame._micRawMaxLatency_ms;
 
   return _frameBuffer[frameBufferIndex];  // Return the base class data
 }
@@ -137,10 +156,11 @@ int PerfMetricAnim::AppendFrameData(const DumpType dumpType,
 #define ANIM_LINE_DATA_VARS \
   frame._messageCountRobotToAnim, frame._messageCountAnimToRobot,\
   frame._messageCountEngineToAnim, frame._messageCountAnimToEngine,\
-  frame._relativeStreamTime_ms, frame._numLayersRendered
+  frame._relativeStreamTime_ms, frame._numLayersRendered,\
+  frame._micRawOverruns, frame._micRawMaxLatency_ms
 
-  static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i\n";
-  static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i\n";
+  static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i %5i %5i\n";
+  static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%i,%i\n";
 
   const int lenOut = snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,
                               dumpType == DT_FILE_CSV ? kFormatLineCSV : kFormatLine,
@@ -159,10 +179,11 @@ int PerfMetricAnim::AppendSummaryData(const DumpType dumpType,
 #define ANIM_SUMMARY_LINE_VARS(StatCall)\
   _accMessageCountRtA.StatCall(), _accMessageCountAtR.StatCall(),\
   _accMessageCountEtA.StatCall(), _accMessageCountAtE.StatCall(),\
-  _accRelativeStreamTime_ms.StatCall(), _accNumLayersRendered.StatCall()
+  _accRelativeStreamTime_ms.StatCall(), _accNumLayersRendered.StatCall(),\
+  _accMicRawOverruns.StatCall(), _accMicRawMaxLatency_ms.StatCall()
 
-  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.0f %5.0f\n";
-  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.0f,%.0f\n";
+  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.0f %5.0f %5.1f %5.0f\n";
+  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.0f,%.0f,%.1f,%.0f\n";
 
 #define APPEND_SUMMARY_LINE(StatCall)\
   lenOut = snprintf(&_dumpBuffer[dumpBufferOffset],    - dumpBufferOffset,\
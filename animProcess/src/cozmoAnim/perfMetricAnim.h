@@ -55,8 +55,8 @@ private:
                                 const int dumpBufferOffset,
                                 const int lineIndex) override final;
 
-  // Frame size:  Base struct is 16 bytes; plus this struct is 20 bytes = 36 bytes total
-  // x 1000 frames is roughly 35 KB
+  // Frame size:  Base struct is 16 bytes; plus this struct is 24 bytes = 40 bytes total
+  // x 1000 frames is roughly 39 KB
   struct FrameMetricAnim : public FrameMetric
   {
     uint32_t _messageCountAnimToRobot;
@@ -65,6 +65,8 @@ private:
     uint32_t _messageCountEngineToAnim;
     uint16_t _relativeStreamTime_ms;
     uint16_t _numLayersRendered;
+    uint16_t _micRawOverruns;       // Raw mic chunks dropped this tick
+    uint16_t _micRawMaxLatency_ms;  // Longest a raw mic chunk waited for processing this tick
   };
 
   FrameMetricAnim*              _frameBuffer = nullptr;
@@ -75,8 +77,12 @@ private:
   Util::Stats::StatsAccumulator _accMessageCountAtE;
   Util::Stats::StatsAccumulator _accRelativeStreamTime_ms;
   Util::Stats::StatsAccumulator _accNumLayersRendered;
+  Util::Stats::StatsAccumulator _accMicRawOverruns;
+  Util::Stats::StatsAccumulator _accMicRawMaxLatency_ms;
 
+  const Anim::AnimContext*            _context = nullptr;
   Anim::AnimationStreamer*            _animationStreamer = nullptr;
+  uint32_t                            _lastMicRawOverruns = 0;
 };
 
 static const int kNumFramesInBuffer = 2000;
@@ -30,6 +30,7 @@
 #include "audioEngine/plugins/streamingWavePortalPlugIn.h"
 #include "util/console/consoleInterface.h"
 #include "util/dispatchQueue/dispatchQueue.h"
+#include "util/environment/locale.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
 #include "util/time/universalTime.h"
@@ -54,6 +55,12 @@ namespace {
   // Enable write to /tmp/tts.pcm?
   CONSOLE_VAR(bool, kWriteTTSFile, "TextToSpeech", false);
 
+  // How much synthesized audio do we keep around for repeated utterances? 0 disables the cache.
+  CONSOLE_VAR_RANGED(u32, kAudioCacheSize_KB, "TextToSpeech", 1024, 0, 8192);
+
+  // Only short utterances (names, weather phrases, etc.) are likely to repeat, so longer ones aren't cached
+  CONSOLE_VAR_RANGED(u32, kAudioCacheMaxTextLength, "TextToSpeech", 80, 0, 1024);
+
 }
 
 namespace Anki {
@@ -72,6 +79,10 @@ TextToSpeechComponent::TextToSpeechComponent(const Anim::AnimContext* context)
   const Json::Value& tts_config = context->GetDataLoader()->GetTextToSpeechConfig();
   _pvdr = std::make_unique<TextToSpeech::TextToSpeechProvider>(context, tts_config);
 
+  if (nullptr != context->GetLocale()) {
+    _locale = context->GetLocale()->GetLocaleString();
+  }
+
 } // TextToSpeechComponent()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -155,6 +166,10 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
   // Get an empty data instance
   auto waveData = AudioEngine::PlugIns::StreamingWavePortalPlugIn::CreateDataInstance();
 
+  // Audio processing style is applied by the audio engine at playback, so cached audio is shared between styles
+  const std::string cacheKey = GetAudioCacheKey(_locale, ttsStr, durationScalar, pitchScalar);
+  const CachedAudioPtr cachedAudio = FindCachedAudio(cacheKey);
+
   {
     std::lock_guard<std::mutex> lock(_lock);
     const auto it = _bundleMap.emplace(ttsID, std::make_shared<TtsBundle>());
@@ -169,10 +184,33 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
     bundle->triggerMode = triggerMode;
     bundle->style = style;
     bundle->waveData = waveData;
+
+    // Repeated utterance? Then the audio is ready right away, without waiting behind other work on the worker thread
+    if (cachedAudio) {
+      StandardWaveDataContainer waveContainer(cachedAudio->sampleRate, cachedAudio->numChannels,
+                                              cachedAudio->samples.size());
+      waveContainer.CopyWaveData(cachedAudio->samples.data(), cachedAudio->samples.size());
+      waveData->AppendStandardWaveData(std::move(waveContainer));
+      waveData->DoneProducingData();
+
+      LOG_DEBUG("TextToSpeechComponent.CreateSpeech", "TTSID %d audio is complete (cached)", ttsID);
+      const f32 duration_ms = GetDuration_ms(waveData);
+      bundle->state = AudioCreationState::Prepared;
+      PushEvent({ttsID, TextToSpeechState::Playable, duration_ms});
+      PushEvent({ttsID, TextToSpeechState::Prepared, duration_ms});
+      return RESULT_OK;
+    }
+  }
+
+  // Keep a copy of the audio as it's generated if it's worth caching
+  std::shared_ptr<CachedAudio> recording;
+  if ((kAudioCacheSize_KB > 0) && (ttsStr.size() <= kAudioCacheMaxTextLength)) {
+    recording = std::make_shared<CachedAudio>();
   }
 
   // Dispatch work onto another thread
-  Util::Dispatch::Async(_dispatchQueue, [this, ttsID, ttsStr, durationScalar, pitchScalar, waveData]
+  Util::Dispatch::Async(_dispatchQueue, [this, ttsID, ttsStr, durationScalar, pitchScalar, waveData,
+                                         cacheKey, recording]
   {
 
     // Have we sent TextToSpeechState::Playable for this utterance?
@@ -181,7 +219,7 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
     // Have we finished generating audio for this utterance?
     bool done = false;
 
-    Result result = GetFirstAudioData(ttsStr, durationScalar, pitchScalar, waveData, done);
+    Result result = GetFirstAudioData(ttsStr, durationScalar, pitchScalar, waveData, recording.get(), done);
     if (RESULT_OK != result) {
       LOG_ERROR("TextToSpeechComponent.CreateSpeech", "Unable to get first audio data (error %d)", result);
       PushEvent({ttsID, TextToSpeechState::Invalid, 0.f});
@@ -204,7 +242,7 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
     }
 
     while (result == RESULT_OK && !done) {
-      result = GetNextAudioData(waveData, done);
+      result = GetNextAudioData(waveData, recording.get(), done);
       if (RESULT_OK != result) {
         LOG_ERROR("TextToSpeechComponent.CreateSpeech", "Unable to get next audio data (error %d)", result);
         PushEvent({ttsID, TextToSpeechState::Invalid, 0.f});
@@ -227,6 +265,10 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
       }
     }
 
+    if (recording) {
+      AddCachedAudio(cacheKey, recording);
+    }
+
     // Finalize data instance
     {
       std::lock_guard<std::mutex> lock(_lock);
@@ -346,6 +388,60 @@ void TextToSpeechComponent::ClearAllLoadedAudioData()
   _bundleMap.clear();
 } // ClearAllLoadedAudioData()
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string TextToSpeechComponent::GetAudioCacheKey(const std::string & locale,
+                                                    const std::string & text,
+                                                    float durationScalar,
+                                                    float pitchScalar)
+{
+  char params[64];
+  snprintf(params, sizeof(params), "%s|%.3f|%.3f|", locale.c_str(), durationScalar, pitchScalar);
+  return params + text;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TextToSpeechComponent::CachedAudioPtr TextToSpeechComponent::FindCachedAudio(const std::string & key)
+{
+  std::lock_guard<std::mutex> lock(_audioCacheMutex);
+  if (kAudioCacheSize_KB == 0) {
+    return nullptr;
+  }
+  const auto it = _audioCacheMap.find(key);
+  if (it == _audioCacheMap.end()) {
+    return nullptr;
+  }
+  // Move to front of LRU list
+  _audioCache.splice(_audioCache.begin(), _audioCache, it->second);
+  return it->second->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechComponent::AddCachedAudio(const std::string & key, const CachedAudioPtr & audio)
+{
+  const size_t maxNumSamples = (kAudioCacheSize_KB * 1024) / sizeof(AudioUtil::AudioSample);
+  if (audio->samples.empty() || (audio->samples.size() > maxNumSamples)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_audioCacheMutex);
+  if (_audioCacheMap.find(key) != _audioCacheMap.end()) {
+    // Same utterance was requested again while it was being synthesized
+    return;
+  }
+
+  _audioCache.emplace_front(key, audio);
+  _audioCacheMap.emplace(key, _audioCache.begin());
+  _audioCacheNumSamples += audio->samples.size();
+
+  // Evict least recently used utterances until we fit
+  while (_audioCacheNumSamples > maxNumSamples) {
+    const auto & oldest = _audioCache.back();
+    _audioCacheNumSamples -= oldest.second->samples.size();
+    _audioCacheMap.erase(oldest.first);
+    _audioCache.pop_back();
+  }
+}
+
 static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveDataInstance> & waveData,
                             const TextToSpeech::TextToSpeechProviderData & ttsData,
                             bool done)
@@ -388,11 +484,25 @@ static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveData
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechComponent::RecordAudioData(CachedAudio * recording,
+                                            const TextToSpeech::TextToSpeechProviderData & ttsData)
+{
+  if (nullptr == recording || ttsData.GetNumSamples() == 0) {
+    return;
+  }
+  recording->sampleRate = ttsData.GetSampleRate();
+  recording->numChannels = ttsData.GetNumChannels();
+  const auto & chunk = ttsData.GetChunk();
+  recording->samples.insert(recording->samples.end(), chunk.begin(), chunk.end());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result TextToSpeechComponent::GetFirstAudioData(const std::string & text,
                                                 float durationScalar,
                                                 float pitchScalar,
                                                 const StreamingWaveDataPtr & data,
+                                                CachedAudio * recording,
                                                 bool & done)
 {
   TextToSpeech::TextToSpeechProviderData ttsData;
@@ -405,10 +515,12 @@ Result TextToSpeechComponent::GetFirstAudioData(const std::string & text,
 
   AppendAudioData(data, ttsData, done);
 
+  RecordAudioData(recording, ttsData);
+
   return RESULT_OK;
 } // GetFirstAudioData()
 
-Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data, bool & done)
+Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data, CachedAudio * recording, bool & done)
 {
   TextToSpeech::TextToSpeechProviderData ttsData;
   const Result result = _pvdr->GetNextAudioData(ttsData, done);
@@ -420,6 +532,8 @@ Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data
 
   AppendAudioData(data, ttsData, done);
 
+  RecordAudioData(recording, ttsData);
+
   return RESULT_OK;
 }
 
@@ -771,6 +885,9 @@ void TextToSpeechComponent::SetLocale(const std::string & locale)
   //
   LOG_DEBUG("TextToSpeechComponent.SetLocale", "Set locale to %s", locale.c_str());
 
+  // Requests queued from now on are cached under the new locale
+  _locale = locale;
+
   const auto & task = [this, locale = std::string(locale)] {
     DEV_ASSERT(_pvdr != nullptr, "TextToSpeechComponent.SetLocale.InvalidProvider");
     LOG_DEBUG("TextToSpeechComponent.SetLocale", "Setting locale to %s", locale.c_str());
@@ -15,6 +15,7 @@
 #include "audioEngine/audioTools/standardWaveDataContainer.h"
 #include "audioEngine/audioTools/streamingWaveDataInstance.h"
 #include "audioEngine/audioTypes.h"
+#include "audioUtil/audioDataTypes.h"
 #include "coretech/common/shared/types.h"
 #include "clad/audio/audioEventTypes.h"
 #include "clad/audio/audioGameObjectTypes.h"
@@ -22,8 +23,11 @@
 #include "clad/types/textToSpeechTypes.h"
 #include "util/helpers/templateHelpers.h"
 #include <deque>
+#include <list>
 #include <mutex>
 #include <map>
+#include <string>
+#include <unordered_map>
 
 // Forward declarations
 namespace Anki {
@@ -41,6 +45,7 @@ namespace Anki {
     }
     namespace TextToSpeech {
       class TextToSpeechProvider;
+      class TextToSpeechProviderData;
     }
   }
   namespace Util {
@@ -125,6 +130,18 @@ private:
   // Shared pointer to data bundle
   using BundlePtr = std::shared_ptr<TtsBundle>;
 
+  // Complete audio for a synthesized utterance, kept so that repeated phrases (names, weather, etc.) can be
+  // played without synthesizing them again
+  struct CachedAudio
+  {
+    int sampleRate = 0;
+    int numChannels = 0;
+    AudioUtil::AudioChunk samples;
+  };
+
+  using CachedAudioPtr = std::shared_ptr<const CachedAudio>;
+  using AudioCacheList = std::list<std::pair<std::string, CachedAudioPtr>>;
+
   // -------------------------------------------------------------------------------------------------------------------
   // Private members
   // -------------------------------------------------------------------------------------------------------------------
@@ -151,6 +168,16 @@ private:
   EventQueue _event_queue;
   std::mutex _event_mutex;
 
+  // LRU cache of synthesized utterances, most recently used first. Looked up on the main thread when a request
+  // arrives, and filled in by the worker thread when synthesis completes.
+  AudioCacheList _audioCache;
+  std::unordered_map<std::string, AudioCacheList::iterator> _audioCacheMap;
+  size_t _audioCacheNumSamples = 0;
+  std::mutex _audioCacheMutex;
+
+  // Locale of requests being queued, which is part of the cache key. Only used on main thread.
+  std::string _locale;
+
   // -------------------------------------------------------------------------------------------------------------------
   // Private methods
   // -------------------------------------------------------------------------------------------------------------------
@@ -162,16 +189,29 @@ private:
   // Initialize TTS utterance and get first chunk of TTS audio.
   // Returns RESULT_OK on success, else error code.
   // Sets done to true when audio generation is complete.
+  // If recording is not null, the audio is also appended to it for caching.
   Result GetFirstAudioData(const std::string & text,
                            float durationScalar,
                            float pitchScalar,
                            const StreamingWaveDataPtr & data,
+                           CachedAudio * recording,
                            bool & done);
 
   // Get next chunk of TTS audio.
   // Returns RESULT_OK on success, else error code.
   // Sets done to true when audio generation is complete.
-  Result GetNextAudioData(const StreamingWaveDataPtr & data, bool & done);
+  Result GetNextAudioData(const StreamingWaveDataPtr & data, CachedAudio * recording, bool & done);
+
+  // Append a chunk of provider audio to recording, if not null
+  static void RecordAudioData(CachedAudio * recording, const TextToSpeech::TextToSpeechProviderData & ttsData);
+
+  // Audio cache helpers. Thread-safe.
+  static std::string GetAudioCacheKey(const std::string & locale,
+                                      const std::string & text,
+                                      float durationScalar,
+                                      float pitchScalar);
+  CachedAudioPtr FindCachedAudio(const std::string & key);
+  void AddCachedAudio(const std::string & key, const CachedAudioPtr & audio);
 
   // Get bundle for given ID
   // Returns nullptr if ID is not found
@@ -0,0 +1,170 @@
+/**
+ * File: faceDisplayTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for FaceDisplay::GetChangedRect, which decides what part of each face frame is sent to
+ *              the display.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/faceDisplay/faceDisplay.h"
+
+#include "anki/cozmo/shared/cozmoConfig.h"
+#include "coretech/common/shared/math/rect.h"
+#include "coretech/vision/engine/image.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  void SetPixel(Vision::ImageRGB565& img, s32 row, s32 col, u16 value)
+  {
+    reinterpret_cast<u16*>(img.GetRow(row))[col] = value;
+  }
+
+  u16 GetPixel(const Vision::ImageRGB565& img, s32 row, s32 col)
+  {
+    return reinterpret_cast<const u16*>(img.GetRow(row))[col];
+  }
+
+  // A face sized image with a different value in every pixel
+  Vision::ImageRGB565 MakeGradientImage()
+  {
+    Vision::ImageRGB565 img;
+    img.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+    for(s32 row = 0; row < img.GetNumRows(); ++row)
+    {
+      for(s32 col = 0; col < img.GetNumCols(); ++col)
+      {
+        SetPixel(img, row, col, static_cast<u16>(row * img.GetNumCols() + col));
+      }
+    }
+    return img;
+  }
+
+  void ExpectRect(const Rectangle<s32>& rect, s32 x, s32 y, s32 width, s32 height)
+  {
+    EXPECT_EQ(x, rect.GetX());
+    EXPECT_EQ(y, rect.GetY());
+    EXPECT_EQ(width, rect.GetWidth());
+    EXPECT_EQ(height, rect.GetHeight());
+  }
+
+}
+
+TEST(FaceDisplay, GetChangedRectIdentical)
+{
+  const Vision::ImageRGB565 prevImg = MakeGradientImage();
+  Vision::ImageRGB565 img;
+  prevImg.CopyTo(img);
+
+  Rectangle<s32> rect;
+  EXPECT_FALSE(FaceDisplay::GetChangedRect(prevImg, img, rect));
+}
+
+TEST(FaceDisplay, GetChangedRectSinglePixel)
+{
+  const Vision::ImageRGB565 prevImg = MakeGradientImage();
+  const s32 lastRow = prevImg.GetNumRows() - 1;
+  const s32 lastCol = prevImg.GetNumCols() - 1;
+
+  // Corners, edges and somewhere in the middle
+  const std::vector<std::pair<s32,s32>> pixels{
+    {0, 0}, {0, lastCol}, {lastRow, 0}, {lastRow, lastCol},
+    {0, 57}, {lastRow, 13}, {31, 0}, {29, lastCol}, {48, 91},
+  };
+
+  for(const auto& pixel : pixels)
+  {
+    Vision::ImageRGB565 img;
+    prevImg.CopyTo(img);
+    SetPixel(img, pixel.first, pixel.second, ~GetPixel(img, pixel.first, pixel.second));
+
+    Rectangle<s32> rect;
+    ASSERT_TRUE(FaceDisplay::GetChangedRect(prevImg, img, rect));
+    ExpectRect(rect, pixel.second, pixel.first, 1, 1);
+  }
+}
+
+TEST(FaceDisplay, GetChangedRectBoundsAllChanges)
+{
+  const Vision::ImageRGB565 prevImg = MakeGradientImage();
+
+  // The rows with the leftmost and rightmost changes are not the first and last changed rows
+  Vision::ImageRGB565 img;
+  prevImg.CopyTo(img);
+  SetPixel(img, 10, 50, 0);
+  SetPixel(img, 20, 5,  0);
+  SetPixel(img, 30, 90, 0);
+  SetPixel(img, 40, 60, 0);
+
+  Rectangle<s32> rect;
+  ASSERT_TRUE(FaceDisplay::GetChangedRect(prevImg, img, rect));
+  ExpectRect(rect, 5, 10, 86, 31);
+}
+
+TEST(FaceDisplay, GetChangedRectWholeImage)
+{
+  const Vision::ImageRGB565 prevImg = MakeGradientImage();
+  Vision::ImageRGB565 img;
+  img.Allocate(prevImg.GetNumRows(), prevImg.GetNumCols());
+  for(s32 row = 0; row < img.GetNumRows(); ++row)
+  {
+    for(s32 col = 0; col < img.GetNumCols(); ++col)
+    {
+      SetPixel(img, row, col, ~GetPixel(prevImg, row, col));
+    }
+  }
+
+  Rectangle<s32> rect;
+  ASSERT_TRUE(FaceDisplay::GetChangedRect(prevImg, img, rect));
+  ExpectRect(rect, 0, 0, img.GetNumCols(), img.GetNumRows());
+}
+
+// Compare against a brute force bounding box of a few random changes
+TEST(FaceDisplay, GetChangedRectRandom)
+{
+  const Vision::ImageRGB565 prevImg = MakeGradientImage();
+  std::mt19937 rng(20181016);
+  std::uniform_int_distribution<s32> rowDist(0, prevImg.GetNumRows() - 1);
+  std::uniform_int_distribution<s32> colDist(0, prevImg.GetNumCols() - 1);
+  std::uniform_int_distribution<s32> countDist(1, 6);
+
+  for(int trial = 0; trial < 200; ++trial)
+  {
+    Vision::ImageRGB565 img;
+    prevImg.CopyTo(img);
+
+    s32 minRow = prevImg.GetNumRows();
+    s32 maxRow = -1;
+    s32 minCol = prevImg.GetNumCols();
+    s32 maxCol = -1;
+    const s32 numChanges = countDist(rng);
+    for(s32 i = 0; i < numChanges; ++i)
+    {
+      const s32 row = rowDist(rng);
+      const s32 col = colDist(rng);
+      SetPixel(img, row, col, ~GetPixel(prevImg, row, col));
+      minRow = std::min(minRow, row);
+      maxRow = std::max(maxRow, row);
+      minCol = std::min(minCol, col);
+      maxCol = std::max(maxCol, col);
+    }
+
+    Rectangle<s32> rect;
+    ASSERT_TRUE(FaceDisplay::GetChangedRect(prevImg, img, rect));
+    ExpectRect(rect, minCol, minRow, maxCol - minCol + 1, maxRow - minRow + 1);
+  }
+}
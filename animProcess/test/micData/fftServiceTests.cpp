@@ -0,0 +1,97 @@
+/**
+ * File: fftServiceTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for the FFTService helpers: which sizes pffft accepts, and that the vectorized
+ *              deinterleave puts every sample in the right channel, matching the scalar conversion exactly.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/micData/fftService.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(FFTService, IsValidSize)
+{
+  // 2^a * 3^b * 5^c with a >= 5
+  for( const unsigned int N : {32u, 64u, 96u, 160u, 480u, 512u, 960u, 1024u, 7200u, 32768u} ) {
+    EXPECT_TRUE( FFTService::IsValidSize(N) ) << N;
+  }
+
+  // Too small, not a multiple of 32, or with other prime factors
+  for( const unsigned int N : {0u, 1u, 16u, 31u, 33u, 48u, 100u, 224u, 352u, 32u*7u*5u, 32u*13u} ) {
+    EXPECT_FALSE( FFTService::IsValidSize(N) ) << N;
+  }
+}
+
+TEST(FFTService, GetLargestValidSize)
+{
+  EXPECT_EQ( 0u,   FFTService::GetLargestValidSize(0) );
+  EXPECT_EQ( 0u,   FFTService::GetLargestValidSize(31) );
+  EXPECT_EQ( 32u,  FFTService::GetLargestValidSize(32) );
+  EXPECT_EQ( 32u,  FFTService::GetLargestValidSize(63) );
+  EXPECT_EQ( 320u, FFTService::GetLargestValidSize(352) );
+  EXPECT_EQ( 480u, FFTService::GetLargestValidSize(500) );
+  EXPECT_EQ( 512u, FFTService::GetLargestValidSize(512) );
+}
+
+// The 4 channel case is vectorized a few frames at a time, with a scalar loop for the rest. Other channel counts
+// only use the scalar loop. Either way every output should be exactly sample * scale.
+TEST(FFTService, DeinterleaveToFloat)
+{
+  std::mt19937 rng(20181016);
+  std::uniform_int_distribution<int> sampleDist(std::numeric_limits<AudioUtil::AudioSample>::min(),
+                                                std::numeric_limits<AudioUtil::AudioSample>::max());
+
+  // Outputs are written at an offset into larger buffers, to catch writes outside of numFrames
+  constexpr size_t kGuard = 8;
+  constexpr float kGuardValue = -12345.f;
+
+  for( const size_t numChannels : {1u, 2u, 3u, 4u, 6u} ) {
+    for( size_t numFrames = 0; numFrames <= 37; ++numFrames ) {
+      for( const float scale : {1.f, 1.f / 32768.f, -0.37f} ) {
+        std::vector<AudioUtil::AudioSample> interleaved( numFrames * numChannels );
+        for( auto& sample : interleaved ) {
+          sample = static_cast<AudioUtil::AudioSample>( sampleDist(rng) );
+        }
+        // Make sure the extremes show up, to check sign extension
+        if( interleaved.size() >= 2 ) {
+          interleaved[0] = std::numeric_limits<AudioUtil::AudioSample>::min();
+          interleaved[interleaved.size() - 1] = std::numeric_limits<AudioUtil::AudioSample>::max();
+        }
+
+        std::vector<std::vector<float>> channels( numChannels,
+                                                  std::vector<float>(numFrames + 2 * kGuard, kGuardValue) );
+        std::vector<float*> outChannels;
+        for( auto& channel : channels ) {
+          outChannels.push_back( channel.data() + kGuard );
+        }
+
+        FFTService::DeinterleaveToFloat( interleaved.data(), numFrames, numChannels, outChannels.data(), scale );
+
+        for( size_t ch = 0; ch < numChannels; ++ch ) {
+          for( size_t i = 0; i < kGuard; ++i ) {
+            ASSERT_EQ( kGuardValue, channels[ch][i] );
+            ASSERT_EQ( kGuardValue, channels[ch][kGuard + numFrames + i] );
+          }
+          for( size_t frame = 0; frame < numFrames; ++frame ) {
+            const float expected = interleaved[frame * numChannels + ch] * scale;
+            ASSERT_EQ( expected, outChannels[ch][frame] )
+              << "channel " << ch << " of " << numChannels << ", frame " << frame << " of " << numFrames;
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/**
+ * File: micDataOpusTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for the Opus encoder and decoder used for streaming mic audio
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/micData/micDataOpus.h"
+
+#include <cmath>
+#include <random>
+
+using namespace Anki;
+using namespace Anki::Vector::MicData;
+
+namespace {
+
+  // Same signal as the OpusRoundTrip console func: a tone sweeping up from 200Hz
+  AudioUtil::AudioChunk MakeSweep(size_t numSamples)
+  {
+    AudioUtil::AudioChunk samples(numSamples);
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const double t_s = (double)i / AudioUtil::kSampleRate_hz;
+      const double freq_hz = 200.0 + 1800.0 * t_s;
+      samples[i] = (AudioUtil::AudioSample)(8000.0 * std::sin(M_PI * freq_hz * t_s));
+    }
+    return samples;
+  }
+
+}
+
+TEST(MicDataOpus, EncodeOnePacketPerFrame)
+{
+  const AudioUtil::AudioChunk samples = MakeSweep(AudioUtil::kSampleRate_hz);
+
+  MicDataOpusEncoder encoder;
+  ASSERT_TRUE(encoder.IsValid());
+
+  // A partial frame produces nothing until it's completed
+  MicDataOpus::PacketList packets;
+  ASSERT_TRUE(encoder.Encode(samples.data(), MicDataOpus::kFrameNumSamples - 1, packets));
+  EXPECT_TRUE(packets.empty());
+
+  ASSERT_TRUE(encoder.Encode(samples.data() + MicDataOpus::kFrameNumSamples - 1,
+                             samples.size() - (MicDataOpus::kFrameNumSamples - 1), packets));
+  EXPECT_EQ(samples.size() / MicDataOpus::kFrameNumSamples, packets.size());
+  for (const auto& packet : packets) {
+    EXPECT_FALSE(packet.empty());
+  }
+}
+
+// How the samples are split up between calls to Encode shouldn't change the packets
+TEST(MicDataOpus, EncodeChunkingIndependent)
+{
+  const AudioUtil::AudioChunk samples = MakeSweep(AudioUtil::kSampleRate_hz);
+
+  MicDataOpusEncoder wholeEncoder;
+  MicDataOpus::PacketList wholePackets;
+  ASSERT_TRUE(wholeEncoder.Encode(samples.data(), samples.size(), wholePackets));
+
+  std::mt19937 rng(20181016);
+  std::uniform_int_distribution<size_t> chunkDist(1, 2 * MicDataOpus::kFrameNumSamples);
+
+  MicDataOpusEncoder chunkedEncoder;
+  MicDataOpus::PacketList chunkedPackets;
+  for (size_t pos = 0; pos < samples.size(); ) {
+    const size_t numSamples = std::min(chunkDist(rng), samples.size() - pos);
+    ASSERT_TRUE(chunkedEncoder.Encode(samples.data() + pos, numSamples, chunkedPackets));
+    pos += numSamples;
+  }
+
+  EXPECT_EQ(wholePackets, chunkedPackets);
+}
+
+TEST(MicDataOpus, RoundTrip)
+{
+  const AudioUtil::AudioChunk samples = MakeSweep(AudioUtil::kSampleRate_hz);
+
+  MicDataOpus::RoundTripStats stats;
+  ASSERT_TRUE(MicDataOpus::RunRoundTrip(samples.data(), samples.size(), MicDataOpus::kDefaultBitrate_bps, stats));
+
+  EXPECT_EQ(samples.size() / MicDataOpus::kFrameNumSamples, stats.numPackets);
+
+  // Roughly the requested bitrate, and far smaller than the PCM
+  const size_t expectedBytes = MicDataOpus::kDefaultBitrate_bps / 8;
+  EXPECT_GT(stats.numEncodedBytes, expectedBytes / 2);
+  EXPECT_LT(stats.numEncodedBytes, expectedBytes * 2);
+
+  // The decoded audio should still look like the input once lined up with it
+  EXPECT_GT(stats.snr_dB, 10.f);
+}
+
+TEST(MicDataOpus, RoundTripFollowsBitrate)
+{
+  const AudioUtil::AudioChunk samples = MakeSweep(AudioUtil::kSampleRate_hz);
+
+  MicDataOpus::RoundTripStats lowStats;
+  MicDataOpus::RoundTripStats highStats;
+  ASSERT_TRUE(MicDataOpus::RunRoundTrip(samples.data(), samples.size(), 12000, lowStats));
+  ASSERT_TRUE(MicDataOpus::RunRoundTrip(samples.data(), samples.size(), 64000, highStats));
+
+  EXPECT_LT(lowStats.numEncodedBytes, highStats.numEncodedBytes);
+  EXPECT_GT(lowStats.snr_dB, 10.f);
+  EXPECT_GT(highStats.snr_dB, 10.f);
+}
+
+TEST(MicDataOpus, DecodeRejectsCorruptPacket)
+{
+  MicDataOpusDecoder decoder;
+  ASSERT_TRUE(decoder.IsValid());
+
+  // Arbitrary frame count packet claiming zero frames
+  const MicDataOpus::Packet packet{0x03, 0x00};
+  AudioUtil::AudioChunk decoded(7, 1);
+  EXPECT_FALSE(decoder.Decode(packet, decoded));
+
+  // Output is left as it was
+  EXPECT_EQ(AudioUtil::AudioChunk(7, 1), decoded);
+}
@@ -0,0 +1,198 @@
+/**
+ * File: spscRingTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for SpscRing, the lock-free ring between the mic data threads. A full ring rejects new
+ *              elements (the newest data is what gets dropped), so that's checked along with ordering.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/micData/spscRing.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Anki::Vector::MicData;
+
+namespace {
+
+  template <typename T, size_t kCapacity>
+  bool Push(SpscRing<T, kCapacity>& ring, const T& value)
+  {
+    T* slot = ring.BeginWrite();
+    if (slot == nullptr) {
+      return false;
+    }
+    *slot = value;
+    ring.CommitWrite();
+    return true;
+  }
+
+  template <typename T, size_t kCapacity>
+  bool Pop(SpscRing<T, kCapacity>& ring, T& value)
+  {
+    const T* slot = ring.BeginRead();
+    if (slot == nullptr) {
+      return false;
+    }
+    value = *slot;
+    ring.CommitRead();
+    return true;
+  }
+
+}
+
+TEST(SpscRing, EmptyPop)
+{
+  SpscRing<int, 4> ring;
+  EXPECT_EQ(0, ring.Size());
+  EXPECT_EQ(nullptr, ring.BeginRead());
+
+  int value = -1;
+  EXPECT_FALSE(Pop(ring, value));
+  EXPECT_EQ(-1, value);
+}
+
+TEST(SpscRing, FillToCapacity)
+{
+  SpscRing<int, 4> ring;
+  EXPECT_EQ(4, ring.Capacity());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(Push(ring, i));
+    EXPECT_EQ(i + 1, ring.Size());
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    int value = -1;
+    EXPECT_TRUE(Pop(ring, value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_EQ(0, ring.Size());
+}
+
+TEST(SpscRing, PushWhenFullDropsNewest)
+{
+  SpscRing<int, 3> ring;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(Push(ring, i));
+  }
+
+  EXPECT_EQ(nullptr, ring.BeginWrite());
+  EXPECT_FALSE(Push(ring, 100));
+  EXPECT_EQ(3, ring.Size());
+
+  // What was already queued is untouched
+  for (int i = 0; i < 3; ++i) {
+    int value = -1;
+    ASSERT_TRUE(Pop(ring, value));
+    EXPECT_EQ(i, value);
+  }
+  int value = -1;
+  EXPECT_FALSE(Pop(ring, value));
+
+  // And it accepts data again once there's room
+  EXPECT_TRUE(Push(ring, 7));
+  ASSERT_TRUE(Pop(ring, value));
+  EXPECT_EQ(7, value);
+}
+
+// Keeps a varying number of elements queued while the indices go around the ring many times
+TEST(SpscRing, Wraparound)
+{
+  SpscRing<int, 5> ring;
+  int nextPush = 0;
+  int nextPop = 0;
+
+  for (int lap = 0; lap < 100; ++lap) {
+    const int fill = 1 + (lap % 5);
+    while (static_cast<int>(ring.Size()) < fill) {
+      ASSERT_TRUE(Push(ring, nextPush++));
+    }
+    if (fill == 5) {
+      EXPECT_FALSE(Push(ring, -1));
+    }
+    EXPECT_EQ(fill, ring.Size());
+
+    // Leave one behind so the read index trails the write index across the wrap
+    while (ring.Size() > 1) {
+      int value = -1;
+      ASSERT_TRUE(Pop(ring, value));
+      EXPECT_EQ(nextPop++, value);
+    }
+  }
+
+  int value = -1;
+  while (Pop(ring, value)) {
+    EXPECT_EQ(nextPop++, value);
+  }
+  EXPECT_EQ(nextPush, nextPop);
+  // Gone around all 6 slots many times
+  EXPECT_GT(nextPush, 10 * 6);
+}
+
+// One thread writes increasing values while another reads them. Every value the producer managed to push must come
+// out exactly once and in order, and each slot must have been fully written before the consumer sees it.
+TEST(SpscRing, ProducerConsumerOrdering)
+{
+  struct Chunk {
+    uint32_t sequence = 0;
+    std::array<uint32_t, 16> data{};
+  };
+
+  constexpr uint32_t kNumChunks = 200000;
+  SpscRing<Chunk, 8> ring;
+  std::vector<uint32_t> pushed;
+  pushed.reserve(kNumChunks);
+  std::atomic<bool> producerDone{false};
+
+  std::thread producer([&ring, &pushed, &producerDone] {
+    for (uint32_t seq = 0; seq < kNumChunks; ++seq) {
+      Chunk* slot = ring.BeginWrite();
+      if (slot == nullptr) {
+        // Dropped, as the mic thread would when the consumer falls behind
+        continue;
+      }
+      slot->sequence = seq;
+      slot->data.fill(seq);
+      ring.CommitWrite();
+      pushed.push_back(seq);
+    }
+    producerDone.store(true, std::memory_order_release);
+  });
+
+  std::vector<uint32_t> popped;
+  popped.reserve(kNumChunks);
+  bool allChunksIntact = true;
+  while (true) {
+    // Once the producer is done, everything it pushed is visible, so one more empty read means we have it all
+    const bool wasDone = producerDone.load(std::memory_order_acquire);
+    const Chunk* slot = ring.BeginRead();
+    if (slot == nullptr) {
+      if (wasDone) {
+        break;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    for (const uint32_t value : slot->data) {
+      allChunksIntact &= (value == slot->sequence);
+    }
+    popped.push_back(slot->sequence);
+    ring.CommitRead();
+  }
+  producer.join();
+
+  EXPECT_TRUE(allChunksIntact);
+  EXPECT_EQ(pushed, popped);
+  EXPECT_FALSE(popped.empty());
+}
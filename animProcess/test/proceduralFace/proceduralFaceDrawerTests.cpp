@@ -0,0 +1,75 @@
+/**
+ * File: proceduralFaceDrawerTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Checks that the vectorized face noise kernel matches the scalar one exactly, for every value pair
+ *              and for row lengths and alignments that leave a tail after the SIMD loop.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cannedAnimLib/proceduralFace/proceduralFaceDrawer.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(ProceduralFaceDrawer, ApplyNoiseAllValuePairs)
+{
+  // One row per eye value, each with every noise value
+  std::vector<u8> eyeShape(256);
+  std::vector<u8> noise(256);
+  std::vector<u8> output(256);
+  std::vector<u8> expected(256);
+  for(s32 i = 0; i < 256; ++i)
+  {
+    noise[i] = static_cast<u8>(i);
+  }
+
+  for(s32 eyeValue = 0; eyeValue < 256; ++eyeValue)
+  {
+    std::fill(eyeShape.begin(), eyeShape.end(), static_cast<u8>(eyeValue));
+    ProceduralFaceDrawer::ApplyNoiseToRow(eyeShape.data(), noise.data(), output.data(), 256);
+    ProceduralFaceDrawer::ApplyNoiseToRowScalar(eyeShape.data(), noise.data(), expected.data(), 256);
+    ASSERT_EQ(expected, output) << "eye value " << eyeValue;
+  }
+}
+
+TEST(ProceduralFaceDrawer, ApplyNoiseRandomTails)
+{
+  std::mt19937 rng(20181016);
+  std::uniform_int_distribution<int> valueDist(0, 255);
+
+  // Unaligned starts, and lengths on both sides of multiples of the SIMD width
+  const s32 kMaxOffset = 15;
+  const s32 kMaxNumElements = 70;
+  std::vector<u8> eyeShape(kMaxOffset + kMaxNumElements);
+  std::vector<u8> noise(kMaxOffset + kMaxNumElements);
+
+  for(s32 offset = 0; offset <= kMaxOffset; offset += 3)
+  {
+    for(s32 numElements = 0; numElements <= kMaxNumElements; ++numElements)
+    {
+      for(auto& value : eyeShape) { value = static_cast<u8>(valueDist(rng)); }
+      for(auto& value : noise)    { value = static_cast<u8>(valueDist(rng)); }
+
+      // Also check nothing past numElements is written
+      std::vector<u8> output(kMaxOffset + kMaxNumElements + 1, 0xA5);
+      std::vector<u8> expected(output);
+
+      ProceduralFaceDrawer::ApplyNoiseToRow(eyeShape.data() + offset, noise.data() + offset,
+                                            output.data() + offset, numElements);
+      ProceduralFaceDrawer::ApplyNoiseToRowScalar(eyeShape.data() + offset, noise.data() + offset,
+                                                  expected.data() + offset, numElements);
+      ASSERT_EQ(expected, output) << "offset " << offset << ", " << numElements << " elements";
+    }
+  }
+}
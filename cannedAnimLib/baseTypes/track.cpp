@@ -122,7 +122,7 @@ namespace Animations {
   void Track<ProceduralFaceKeyFrame>::AdvanceTrack(const TimeStamp_t toTime_ms)
   {
     if(ANKI_DEV_CHEATS){
-      auto allKeyframes = GetCopyOfKeyframes();
+      const FrameList& allKeyframes = _frames;
       auto safetyCheckIter = allKeyframes.begin();
       while(safetyCheckIter != allKeyframes.end()) {
         auto nextIter = safetyCheckIter;
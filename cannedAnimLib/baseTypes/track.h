@@ -19,7 +19,9 @@
 #include "json/json-forwards.h"
 #include "util/helpers/boundedWhile.h"
 #include <stdint.h>
-#include <list>
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 namespace CozmoAnim {
   struct HeadAngle;
@@ -46,43 +48,15 @@ class Track
 public:
   static constexpr size_t ConstMaxFramesPerTrack() { return 1000; }
 
-  //
-  // Default copy constructor and copy assignment operator do not do the right thing for std::list iterators.
-  // When a std::list is copied, any associated iterator must be updated to point to the same location in
-  // the new location.  The default member-wise copy produces an invalid iterator.
-  //
-  
-  // Default constructor, move constructor, move assignment
+  using FrameList = std::vector<FRAME_TYPE>;
+
+  // Frames are stored contiguously and the current position is an index, so the default copy and move
+  // operations preserve the position.
   Track<FRAME_TYPE>() = default;
+  Track<FRAME_TYPE>(const Track<FRAME_TYPE>&) = default;
   Track<FRAME_TYPE>(Track<FRAME_TYPE>&&) noexcept = default;
+  Track<FRAME_TYPE>& operator = (const Track<FRAME_TYPE>&) = default;
   Track<FRAME_TYPE>& operator = (Track<FRAME_TYPE>&&) noexcept = default;
-  
-  // Custom copy constructor
-  Track<FRAME_TYPE>(const Track<FRAME_TYPE>& other) :
-    _frames(other._frames),
-    _frameIter(_frames.begin())
-  {
-    if(!other._frames.empty()){
-      // Advance iterator to preserve original position
-      for (auto pos = other._frames.begin(); pos != other._frameIter; ++pos) {
-        ++_frameIter;
-      }
-    }
-  }
-  
-  // Custom copy assignment
-  Track<FRAME_TYPE>& operator = (const Track<FRAME_TYPE>& other)
-  {
-    if (this != &other) {
-      _frames = other._frames;
-      _frameIter = _frames.begin();
-      // Advance iterator to preserve original position
-      for (auto pos = other._frames.begin(); pos != other._frameIter; ++pos) {
-        ++_frameIter;
-      }
-    }
-    return *this;
-  }
 
   bool operator ==(const Track<FRAME_TYPE>& other) const
   {
@@ -118,9 +92,11 @@ public:
   RobotInterface::EngineToRobot* GetCurrentStreamingMessage(const TimeStamp_t relativeStreamingTime_ms) const;
   
   // Get a reference to the current KeyFrame in the track.
+  // Keyframes are mutable through a const Track (as they were when the position was a list iterator), since
+  // streaming updates per-keyframe state.
   FRAME_TYPE& GetCurrentKeyFrame() const {
     ANKI_VERIFY(HasFramesLeft(),"Track.GetCurrentKeyframe.NoFramesLeft","");
-    return *_frameIter;
+    return const_cast<FRAME_TYPE&>(_frames[_frameIdx]);
   }
   
   // Get pointer to next keyframe. Returns nullptr if the track is on the last frame.
@@ -133,9 +109,10 @@ public:
   const FRAME_TYPE* GetLastKeyFrame() const;
   FRAME_TYPE* GetLastKeyFrame();
   
-  std::list<FRAME_TYPE> GetCopyOfKeyframes() const { return _frames;}
+  FrameList GetCopyOfKeyframes() const { return _frames;}
 
-  std::list<FRAME_TYPE>& GetAllKeyframes() { return _frames;}
+  FrameList& GetAllKeyframes() { return _frames;}
+  const FrameList& GetAllKeyframes() const { return _frames;}
 
   
   // Move to next frame and delete the current one if it's marked "live".
@@ -156,7 +133,7 @@ public:
   // track. HasFramesLeft() will be false after this.
   void MoveToEnd();
 
-  bool HasFramesLeft() const { return _frameIter != _frames.end(); }
+  bool HasFramesLeft() const { return _frameIdx < _frames.size(); }
 
   // Check to see whether the return value of GetCurrentKeyFrame is valid
   bool CurrentFrameIsValid(const TimeStamp_t relativeStreamingTime_ms) const {
@@ -168,7 +145,7 @@ public:
   int TrackLength() const { return static_cast<int>(_frames.size()); }
 
 
-  void Clear() { _frames.clear(); _frameIter = _frames.end(); }
+  void Clear() { _frames.clear(); _frameIdx = 0; }
 
   // Clear all frames up to, but not including, the current one.
   void ClearUpToCurrent();
@@ -176,24 +153,24 @@ public:
   // Append Track to current track
   void AppendTrack(const Track& appendTrack, const TimeStamp_t appendStartTime_ms);
 
+  // Append Track to current track, moving its keyframes instead of copying them. appendTrack is left empty.
+  void AppendTrack(Track&& appendTrack, const TimeStamp_t appendStartTime_ms);
+
   // Moves the frameIter forward to the keyframe that should be set for the given time
   // NOTE: This function only moves the track forward
   void AdvanceTrack(const TimeStamp_t toTime_ms);
 
 
 
-  std::list<FRAME_TYPE>& GetAllFrames() { return _frames;}
+  FrameList& GetAllFrames() { return _frames;}
 
 private:
 
-  using FrameList = std::list<FRAME_TYPE>;
-  using FrameListIter = typename std::list<FRAME_TYPE>::iterator;
-
-  // List of frames
+  // Frames, sorted by trigger time
   FrameList _frames;
 
-  // Pointer to current position
-  FrameListIter _frameIter = _frames.begin();
+  // Index of current position (_frames.size() when there are no frames left)
+  size_t _frameIdx = 0;
 
   Result AddKeyFrameToBackHelper(const FRAME_TYPE& keyFrame, FRAME_TYPE* &prevKeyFrame);
   Result AddKeyFrameByTimeHelper(const FRAME_TYPE& keyFrame, FRAME_TYPE* &prevKeyFrame);
@@ -208,22 +185,22 @@ private:
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::MoveToStart()
 {
-  _frameIter = _frames.begin();
+  _frameIdx = 0;
 }
 
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::MoveToNextKeyFrame()
 {
-  if(_frameIter != _frames.end()) {
-    ++_frameIter;
+  if(_frameIdx < _frames.size()) {
+    ++_frameIdx;
   }
 }
   
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::MoveToPrevKeyFrame()
 {
-  if(_frameIter != _frames.begin()) {
-    --_frameIter;
+  if(_frameIdx > 0) {
+    --_frameIdx;
   }
 }
   
@@ -235,29 +212,26 @@ void Track<FRAME_TYPE>::MoveToLastKeyFrame()
     return;
   }
   
-  // Jump to end and then move back one
-  _frameIter = _frames.end();
-  --_frameIter;
+  _frameIdx = _frames.size() - 1;
 }
   
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::MoveToEnd()
 {
-  _frameIter = _frames.end();
+  _frameIdx = _frames.size();
 }
   
 template<typename FRAME_TYPE>
 const FRAME_TYPE* Track<FRAME_TYPE>::GetNextKeyFrame() const
 {
-  DEV_ASSERT(_frameIter != _frames.end(), "Frame iterator should not be at end");
+  DEV_ASSERT(HasFramesLeft(), "Frame iterator should not be at end");
   
-  auto nextIter = _frameIter;
-  ++nextIter;
+  const size_t nextIdx = _frameIdx + 1;
   
-  if(nextIter == _frames.end()) {
+  if(nextIdx >= _frames.size()) {
     return nullptr;
   } else {
-    return &(*nextIter);
+    return &(_frames[nextIdx]);
   }
 }
 
@@ -304,18 +278,19 @@ Result Track<FRAME_TYPE>::AddKeyFrameToBackHelper(const FRAME_TYPE& keyFrame,
     return RESULT_FAIL;
   }
   
-  if(!_frames.empty()) {
-    prevKeyFrame = &(_frames.back());
-  } else {
-    prevKeyFrame = nullptr;
-  }
+  // If the track had already played out, keep it that way (only an empty track starts at the new keyframe)
+  const bool wasAtEnd = !_frames.empty() && !HasFramesLeft();
 
   _frames.emplace_back(keyFrame);
 
-  // If we just added the first keyframe we need to reset the frameIter to point
-  // back to the beginning.
-  if(_frames.size() == 1) {
-    _frameIter = _frames.begin();
+  // Look up the previous keyframe after adding, since adding may have reallocated
+  const size_t numFrames = _frames.size();
+  if(numFrames > 1) {
+    prevKeyFrame = &(_frames[numFrames - 2]);
+  }
+
+  if(wasAtEnd) {
+    _frameIdx = numFrames;
   }
 
   return RESULT_OK;
@@ -353,30 +328,37 @@ Result Track<FRAME_TYPE>::AddKeyFrameByTimeHelper(const FRAME_TYPE& keyFrame,
     return RESULT_FAIL;
   }
 
-  auto desiredTrigger = keyFrame.GetTriggerTime_ms();
+  const auto desiredTrigger = keyFrame.GetTriggerTime_ms();
   
-  auto framePlaceIter = _frames.begin();
-  while (framePlaceIter != _frames.end() && framePlaceIter->GetTriggerTime_ms() <= desiredTrigger)
+  // Frames are sorted by trigger time, so find the first one that triggers after the new one
+  const auto framePlaceIter = std::upper_bound(_frames.begin(), _frames.end(), desiredTrigger,
+                                               [](const TimeStamp_t triggerTime, const FRAME_TYPE& frame) {
+                                                 return triggerTime < frame.GetTriggerTime_ms();
+                                               });
+  const size_t insertIdx = static_cast<size_t>(framePlaceIter - _frames.begin());
+
+  // Don't put another key frame at the same time as an existing one
+  if((insertIdx > 0) && (_frames[insertIdx - 1].GetTriggerTime_ms() == desiredTrigger))
   {
-    // Don't put another key frame at the same time as an existing one
-    if (framePlaceIter->GetTriggerTime_ms() == desiredTrigger)
-    {
-      PRINT_NAMED_ERROR("Animation.Track.AddKeyFrameByTime.DuplicateTime",
-                        "There is already a frame at time %u in %s track.",
-                        desiredTrigger, keyFrame.GetClassName().c_str());
-      return RESULT_FAIL;
-    }
-    prevKeyFrame = &(*framePlaceIter); // return previous keyframe
-    ++framePlaceIter;
+    PRINT_NAMED_ERROR("Animation.Track.AddKeyFrameByTime.DuplicateTime",
+                      "There is already a frame at time %u in %s track.",
+                      desiredTrigger, keyFrame.GetClassName().c_str());
+    return RESULT_FAIL;
   }
   
+  const bool wasEmpty = _frames.empty();
+
   _frames.insert(framePlaceIter, keyFrame);
 
-  // If we just added the first keyframe (e.g. after deleting the last remaining
-  // keyframe in a "Live" track), we need to reset the frameIter to point
-  // back to the beginning.
-  if(_frames.size() == 1) {
-    _frameIter = _frames.begin();
+  // Keep the current position on the same keyframe. If we just added the first keyframe (e.g. after deleting
+  // the last remaining keyframe in a "Live" track), it starts at the beginning.
+  if(!wasEmpty && (insertIdx <= _frameIdx)) {
+    ++_frameIdx;
+  }
+
+  // Look up the previous keyframe after inserting, since inserting may have reallocated
+  if(insertIdx > 0) {
+    prevKeyFrame = &(_frames[insertIdx - 1]);
   }
 
   return RESULT_OK;
@@ -542,6 +524,7 @@ Result Track<FRAME_TYPE>::AddNewKeyFrameToBack(const FRAME_TYPE& newKeyFrame)
                             _frames.back().GetTriggerTime_ms(), nextToLastFrame->GetTriggerTime_ms());
         
         _frames.pop_back();
+        _frameIdx = std::min(_frameIdx, _frames.size());
         lastResult = RESULT_FAIL;
       }
     }
@@ -553,15 +536,14 @@ Result Track<FRAME_TYPE>::AddNewKeyFrameToBack(const FRAME_TYPE& newKeyFrame)
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::ClearUpToCurrent()
 {
-  auto iter = _frames.begin();
-  while(iter != _frameIter) {
-    iter = _frames.erase(iter);
-  }
+  _frames.erase(_frames.begin(), _frames.begin() + _frameIdx);
+  _frameIdx = 0;
 }
 
 template<class FRAME_TYPE>
 void Track<FRAME_TYPE>::AppendTrack(const Track<FRAME_TYPE>& appendTrack, const TimeStamp_t appendStartTime_ms)
 {
+  _frames.reserve(_frames.size() + appendTrack._frames.size());
   for (const FRAME_TYPE& aFrame : appendTrack._frames) {
     FRAME_TYPE newFrame(aFrame);
     TimeStamp_t triggerTime = newFrame.GetTriggerTime_ms();
@@ -572,6 +554,43 @@ void Track<FRAME_TYPE>::AppendTrack(const Track<FRAME_TYPE>& appendTrack, const
   }
 }
 
+template<class FRAME_TYPE>
+void Track<FRAME_TYPE>::AppendTrack(Track<FRAME_TYPE>&& appendTrack, const TimeStamp_t appendStartTime_ms)
+{
+  FrameList& appendFrames = appendTrack._frames;
+  if (appendFrames.empty()) {
+    return;
+  }
+
+  // Let the copying version report the frames that don't fit
+  if (_frames.size() + appendFrames.size() > ConstMaxFramesPerTrack()) {
+    AppendTrack(static_cast<const Track<FRAME_TYPE>&>(appendTrack), appendStartTime_ms);
+    appendTrack.Clear();
+    return;
+  }
+
+  for (FRAME_TYPE& aFrame : appendFrames) {
+    aFrame.SetTriggerTime_ms(aFrame.GetTriggerTime_ms() + appendStartTime_ms);
+  }
+
+  // The first keyframe goes through AddKeyFrameToBack so that per-type bookkeeping against our current last
+  // keyframe (e.g. body motion stop messages, procedural face durations) still happens. The remaining keyframes
+  // were already set up relative to each other in appendTrack, so they are moved over as they are.
+  if ( RESULT_OK != AddKeyFrameToBack(appendFrames.front()) ) {
+    PRINT_NAMED_ERROR("Track.AppendTrack.AddKeyFrameToBack.Failure", "");
+  }
+
+  const bool wasAtEnd = !HasFramesLeft();
+  _frames.insert(_frames.end(),
+                 std::make_move_iterator(appendFrames.begin() + 1),
+                 std::make_move_iterator(appendFrames.end()));
+  if (wasAtEnd) {
+    _frameIdx = _frames.size();
+  }
+
+  appendTrack.Clear();
+}
+
 template<class FRAME_TYPE>
 void Track<FRAME_TYPE>::AdvanceTrack(const TimeStamp_t toTime_ms)
 {
@@ -586,21 +605,21 @@ template<class FRAME_TYPE>
 void Track<FRAME_TYPE>::AdvanceTrackHelper(const TimeStamp_t toTime_ms)
 {
   const auto upperBound = _frames.size() + 1;
-  BOUNDED_WHILE(upperBound, _frameIter != _frames.end()) {
+  BOUNDED_WHILE(upperBound, HasFramesLeft()) {
     // Ensure tracks don't overlap
     if(ANKI_DEV_CHEATS){
       if(GetNextKeyFrame() != nullptr){
-        if((_frameIter->GetTimestampActionComplete_ms() > toTime_ms) &&
+        if((_frames[_frameIdx].GetTimestampActionComplete_ms() > toTime_ms) &&
            (GetNextKeyFrame()->IsTimeToPlay(toTime_ms))){
           PRINT_NAMED_ERROR("Track.AdvanceTrack.KeyframeStillActiveButTimeToPlayNextFrame",
                             "Keyframe lasts till %u, but next frame wants to start at %u",
-                            _frameIter->GetTimestampActionComplete_ms(), toTime_ms);
+                            _frames[_frameIdx].GetTimestampActionComplete_ms(), toTime_ms);
         }
       }
     }
     
-    if(_frameIter->GetTimestampActionComplete_ms() <= toTime_ms){
-      _frameIter++;
+    if(_frames[_frameIdx].GetTimestampActionComplete_ms() <= toTime_ms){
+      ++_frameIdx;
     }else{
       break;
     }
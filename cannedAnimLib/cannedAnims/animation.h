@@ -187,7 +187,12 @@ private:
 template<class KeyFrameType>
 Result Animation::AddKeyFrameToBack(const KeyFrameType& kf)
 {
-  auto* oldKF = GetTrack<KeyFrameType>().GetLastKeyFrame();
+  // The track's storage may reallocate when the frame is added, so read what's needed from the old last frame now
+  // instead of holding on to it
+  const auto* oldKF = GetTrack<KeyFrameType>().GetLastKeyFrame();
+  const bool followsOldKF = (oldKF != nullptr) && (kf.GetTriggerTime_ms() == 0);
+  const TimeStamp_t oldActionComplete_ms = followsOldKF ? oldKF->GetTimestampActionComplete_ms() : 0;
+
   Result addResult = GetTrack<KeyFrameType>().AddKeyFrameToBack(kf);
   if(RESULT_OK != addResult) {
     PRINT_NAMED_ERROR("Animation.AddKeyFrameToBack.Failed", "AnimationName:%s",
@@ -197,9 +202,9 @@ Result Animation::AddKeyFrameToBack(const KeyFrameType& kf)
 
   auto* newKF = GetTrack<KeyFrameType>().GetLastKeyFrame();
 
-  if((oldKF != nullptr) &&
+  if(followsOldKF &&
      (newKF->GetTriggerTime_ms() == 0)){
-    newKF->SetTriggerTime_ms(oldKF->GetTimestampActionComplete_ms());
+    newKF->SetTriggerTime_ms(oldActionComplete_ms);
   }
 
   return addResult;
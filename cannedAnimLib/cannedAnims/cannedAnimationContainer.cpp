@@ -15,7 +15,9 @@
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 #include "cannedAnimLib/baseTypes/track.h"
 #include "cannedAnimLib/cannedAnims/cannedAnimationLoader.h"
+#include "cannedAnimLib/proceduralFace/proceduralFace.h"
 
+#include "util/console/consoleInterface.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/logging/logging.h"
 
@@ -24,6 +26,13 @@
 namespace Anki {
 namespace Vector {
 
+namespace {
+// Maximum number of lazily decoded animations kept in memory (0 = keep everything that was ever requested).
+// Evicting an animation invalidates any Animation* previously returned for it, so only lower this if callers
+// re-fetch animations instead of holding on to the pointers (the animation streamer keeps its neutral face one).
+CONSOLE_VAR(u32, kMaxDecodedLazyAnimations, "Animations", 0);
+}
+
 #if ANKI_DEV_CHEATS
 
 CannedAnimationContainer* s_cubeAnimContainer = nullptr;
@@ -35,7 +44,7 @@ void SetNewTapHeight(ConsoleFunctionContextRef context)
   if(s_cubeAnimContainer != nullptr){
     Animation* anim = s_cubeAnimContainer->GetAnimation(kCubeSpinnerAnimationName);
     auto& track = anim->GetTrack<LiftHeightKeyFrame>();
-    std::list<LiftHeightKeyFrame>& frames = track.GetAllKeyframes();
+    auto& frames = track.GetAllKeyframes();
     auto iter = frames.begin();
     iter++;
     iter->OverrideHeight(kAdjustHeightOfSpinnerLift);
@@ -64,8 +73,9 @@ CannedAnimationContainer::~CannedAnimationContainer()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CannedAnimationContainer::HasAnimation(const std::string& name) const
 {
-  auto retVal = _animations.find(name);
-  return retVal != _animations.end();
+  std::lock_guard<std::mutex> lock(_mutex);
+  return (_animations.find(name) != _animations.end()) ||
+         (_lazyAnimations.find(name) != _lazyAnimations.end());
 }
 
 
@@ -80,6 +90,18 @@ Animation* CannedAnimationContainer::GetAnimation(const std::string& name)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Animation* CannedAnimationContainer::GetAnimation(const std::string& name) const
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter != _lazyAnimations.end()) {
+    LazyAnimation& lazyAnim = lazyIter->second;
+    if(!lazyAnim.isDecoded) {
+      return DecodeLazyAnimation(name, lazyAnim);
+    }
+    // Mark as most recently used
+    _decodedLazyAnimations.splice(_decodedLazyAnimations.begin(), _decodedLazyAnimations, lazyAnim.decodedIter);
+  }
+
   const Animation* animPtr = nullptr;
   
   auto retVal = _animations.find(name);
@@ -95,16 +117,83 @@ const Animation* CannedAnimationContainer::GetAnimation(const std::string& name)
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Animation* CannedAnimationContainer::DecodeLazyAnimation(const std::string& name,
+                                                               LazyAnimation& lazyAnim) const
+{
+  // Same as the eager loader: don't warn about clipped face parameters in canned data
+  ProceduralFace::EnableClippingWarning(false);
+  Animation animation(name);
+  std::string animName = name;
+  const Result defineResult = animation.DefineFromFlatBuf(animName, lazyAnim.animClip, lazyAnim.seqContainer);
+  ProceduralFace::EnableClippingWarning(true);
+  if(CannedAnimationLoader::SanityCheck(defineResult, animation, animName) != RESULT_OK) {
+    // The eager loader never adds animations that fail, so forget this one rather than failing on every request
+    PRINT_NAMED_ERROR("CannedAnimationContainer.DecodeLazyAnimation.Failed",
+                      "Failed to decode animation '%s', removing it",
+                      name.c_str());
+    _lazyAnimations.erase(name);
+    return nullptr;
+  }
+
+  auto emplaced = _animations.emplace(name, std::move(animation));
+
+  _decodedLazyAnimations.push_front(name);
+  lazyAnim.decodedIter = _decodedLazyAnimations.begin();
+  lazyAnim.isDecoded = true;
+
+  EvictDecodedAnimations(name);
+
+  return &emplaced.first->second;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::EvictDecodedAnimations(const std::string& keepName) const
+{
+  if(kMaxDecodedLazyAnimations == 0) {
+    return;
+  }
+
+  while((_decodedLazyAnimations.size() > kMaxDecodedLazyAnimations) &&
+        (_decodedLazyAnimations.back() != keepName))
+  {
+    const std::string& evictName = _decodedLazyAnimations.back();
+    _animations.erase(evictName);
+    _lazyAnimations[evictName].isDecoded = false;
+    _decodedLazyAnimations.pop_back();
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CannedAnimationContainer::RemoveAnimation(const std::string& name)
+{
+  bool removed = (_animations.erase(name) > 0);
+
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter != _lazyAnimations.end()) {
+    if(lazyIter->second.isDecoded) {
+      _decodedLazyAnimations.erase(lazyIter->second.decodedIter);
+    }
+    _lazyAnimations.erase(lazyIter);
+    removed = true;
+  }
+
+  return removed;
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CannedAnimationContainer::AddAnimation(Animation&& animation, bool& outOverwriting)
 {
   const std::string& name = animation.GetName();
 
+  std::lock_guard<std::mutex> lock(_mutex);
+
   // Replace animation with the given one because this
   // is mainly for animators testing new animations
-  auto iter = _animations.find(name);
-  if(iter != _animations.end()) {
-    _animations.erase(iter);
+  if(RemoveAnimation(name)) {
     outOverwriting = true;
   }
 
@@ -112,13 +201,41 @@ void CannedAnimationContainer::AddAnimation(Animation&& animation, bool& outOver
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::AddLazyAnimation(const std::string& name,
+                                                const CozmoAnim::AnimClip* animClip,
+                                                const std::shared_ptr<const void>& fileData,
+                                                Vision::SpriteSequenceContainer* seqContainer,
+                                                bool& outOverwriting)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if(RemoveAnimation(name)) {
+    outOverwriting = true;
+  }
+
+  LazyAnimation& lazyAnim = _lazyAnimations[name];
+  lazyAnim.animClip = animClip;
+  lazyAnim.fileData = fileData;
+  lazyAnim.seqContainer = seqContainer;
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::vector<std::string> CannedAnimationContainer::GetAnimationNames()
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+
   std::vector<std::string> v;
-  v.reserve(_animations.size());
-  for (std::unordered_map<std::string, Animation>::iterator i=_animations.begin(); i != _animations.end(); ++i) {
-    v.push_back(i->first);
+  v.reserve(_animations.size() + _lazyAnimations.size());
+  for (const auto& entry : _lazyAnimations) {
+    v.push_back(entry.first);
+  }
+  for (const auto& entry : _animations) {
+    // Decoded lazy animations were already added above
+    if (_lazyAnimations.find(entry.first) == _lazyAnimations.end()) {
+      v.push_back(entry.first);
+    }
   }
   return v;
 }
@@ -16,11 +16,22 @@
 #define ANKI_COZMO_CANNED_ANIMATION_CONTAINER_H
 
 #include "cannedAnimLib/cannedAnims/animation.h"
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+namespace CozmoAnim {
+struct AnimClip;
+}
+
 namespace Anki {
 
+namespace Vision {
+class SpriteSequenceContainer;
+}
+
 namespace Vector {
 
 class CannedAnimationContainer
@@ -36,11 +47,51 @@ public:
   // If adding the new animation overwrites an existing animation, outOverwriting will be set to true
   void AddAnimation(Animation&& animation, bool& outOverwriting);
 
+  // Register an animation whose FlatBuffer definition lives in (memory mapped) file data. The Animation is only
+  // decoded the first time it is requested via GetAnimation(). fileData keeps the underlying buffer alive and is
+  // shared by all clips from the same file. Same overwrite semantics as AddAnimation().
+  void AddLazyAnimation(const std::string& name,
+                        const CozmoAnim::AnimClip* animClip,
+                        const std::shared_ptr<const void>& fileData,
+                        Vision::SpriteSequenceContainer* seqContainer,
+                        bool& outOverwriting);
+
   std::vector<std::string> GetAnimationNames();
   
 private:
   using AnimMap = std::unordered_map<std::string, Animation>;
-  std::unordered_map<std::string, Animation> _animations;
+  using DecodedList = std::list<std::string>;
+
+  struct LazyAnimation
+  {
+    const CozmoAnim::AnimClip*       animClip     = nullptr;
+    std::shared_ptr<const void>      fileData;
+    Vision::SpriteSequenceContainer* seqContainer = nullptr;
+    bool                             isDecoded    = false;
+    DecodedList::iterator            decodedIter;
+  };
+
+  // Decodes a lazy animation into _animations. An animation that fails to decode is removed, and nullptr returned.
+  // Expects _mutex to be held.
+  const Animation* DecodeLazyAnimation(const std::string& name, LazyAnimation& lazyAnim) const;
+
+  // Drops least recently used decoded lazy animations down to the console var limit, never touching keepName.
+  // Expects _mutex to be held.
+  void EvictDecodedAnimations(const std::string& keepName) const;
+
+  // Removes an existing animation with this name, both decoded and lazy. Expects _mutex to be held.
+  bool RemoveAnimation(const std::string& name);
+
+  // Decoded animations are cached in here as well, so lookups are mutable even from const accessors
+  mutable AnimMap _animations;
+
+  mutable std::unordered_map<std::string, LazyAnimation> _lazyAnimations;
+
+  // Names of decoded lazy animations, most recently used at the front. Animations added directly through
+  // AddAnimation() are never in here, so they are never evicted.
+  mutable DecodedList _decodedLazyAnimations;
+
+  mutable std::mutex _mutex;
   
 }; // class CannedAnimationContainer
   
@@ -21,12 +21,16 @@
 
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/dispatchWorker/dispatchWorker.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/time/universalTime.h"
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #define LOG_CHANNEL   "RobotDataLoader"
 
@@ -38,6 +42,39 @@ namespace{
 // based on recent profiling. Some sections below are called out specifically, the rest makes up the remainder.
 // These should add up to be less than or equal to 1.0!
 static constexpr float kAnimationsLoadingRatio = 0.7f;
+
+// When set, binary animation files are memory mapped and only indexed by name at load time. Each animation is
+// decoded from the mapped FlatBuffer the first time it is requested from the container.
+CONSOLE_VAR(bool, kLazyLoadBinaryAnimations, "Animations", true);
+
+// Maps the whole file read-only. The returned pointer unmaps it once the last reference goes away.
+std::shared_ptr<const void> MapFile(const std::string& path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat attrib{0};
+  if ((fstat(fd, &attrib) != 0) || (attrib.st_size <= 0)) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t len = static_cast<size_t>(attrib.st_size);
+  void* data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the fd is closed
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<const void>(data, [len](const void* ptr) {
+    munmap(const_cast<void*>(ptr), len);
+  });
+}
 }
 
 
@@ -203,16 +240,26 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
 
   if (binFile) {
 
-    // Read the binary file
-    auto binFileContents = Util::FileUtils::ReadFileAsBinary(path);
-    if (binFileContents.size() == 0) {
-      LOG_ERROR("CannedAnimationLoader.LoadAnimationFile.BinaryDataEmpty", "Found no data in %s", path.c_str());
-      return;
+    // Either map the binary file (the mapping is kept alive by the container until all its animations are gone)
+    // or, if lazy loading is off or mapping fails, read it in full
+    std::shared_ptr<const void> mappedFile;
+    std::vector<uint8_t> binFileContents;
+    const unsigned char* binData = nullptr;
+    if (kLazyLoadBinaryAnimations) {
+      mappedFile = MapFile(path);
+      binData = static_cast<const unsigned char*>(mappedFile.get());
+      if (nullptr == binData) {
+        LOG_WARNING("CannedAnimationLoader.LoadAnimationFile.MapFileFailed",
+                    "Could not map %s, reading and decoding it up front instead", path.c_str());
+      }
     }
-    unsigned char *binData = binFileContents.data();
     if (nullptr == binData) {
-      LOG_ERROR("CannedAnimationLoader.LoadAnimationFile.BinaryDataNull", "Found no data in %s", path.c_str());
-      return;
+      binFileContents = Util::FileUtils::ReadFileAsBinary(path);
+      if (binFileContents.size() == 0) {
+        LOG_ERROR("CannedAnimationLoader.LoadAnimationFile.BinaryDataEmpty", "Found no data in %s", path.c_str());
+        return;
+      }
+      binData = binFileContents.data();
     }
     auto animClips = CozmoAnim::GetAnimClips(binData);
     if (nullptr == animClips) {
@@ -239,7 +286,17 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
       // TODO: Should this mutex lock happen here or immediately before this for loop (COZMO-8766)?
       std::lock_guard<std::mutex> guard(_parallelLoadingMutex);
 
-      DefineFromFlatBuf(animClip, strName, container);
+      if (mappedFile) {
+        bool outOverwriting = false;
+        container->AddLazyAnimation(strName, animClip, mappedFile, _spriteSequenceContainer, outOverwriting);
+        if (outOverwriting) {
+          PRINT_NAMED_WARNING("CannedAnimationLoader.LoadAnimationFile.OverwritingExistingAnimation",
+                              "Container already had an animation named %s, overwriting",
+                              strName.c_str());
+        }
+      } else {
+        DefineFromFlatBuf(animClip, strName, container);
+      }
     }
 
   } else {
@@ -341,7 +398,7 @@ Result CannedAnimationLoader::DefineFromJson(const Json::Value& jsonRoot, std::s
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result CannedAnimationLoader::SanityCheck(Result lastResult, Animation& animation, std::string& animationName) const
+Result CannedAnimationLoader::SanityCheck(Result lastResult, Animation& animation, std::string& animationName)
 {
   if(animation.GetName() != animationName) {
     PRINT_NAMED_ERROR("CannedAnimationContainer.DefineFromJson",
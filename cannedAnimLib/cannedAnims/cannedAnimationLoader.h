@@ -66,6 +66,10 @@ public:
 
   AnimDirInfo CollectAnimFiles(const std::vector<std::string>& paths);
 
+  // Checks the result of defining an animation, and that it got the expected name. Also used by the container
+  // for animations it decodes lazily.
+  static Result SanityCheck(Result lastResult, Animation& animation, std::string& animationName);
+
 private:
   
   // params passed in by data loader class
@@ -90,7 +94,6 @@ private:
 
   Result DefineFromJson(const Json::Value& jsonRoot, std::string& loadedAnimName, CannedAnimationContainer* container);
   Result DefineFromFlatBuf(const CozmoAnim::AnimClip* animClip, std::string& animName, CannedAnimationContainer* container);  
-  Result SanityCheck(Result lastResult, Animation& animation, std::string& animationName) const;
 
 };
 
@@ -21,6 +21,8 @@
 #include "coretech/vision/shared/spriteCache/spriteCache.h"
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "Animations"
 
 namespace Anki{
@@ -44,6 +46,10 @@ const char* kHeightKey        = "height";
 // Legacy support
 const char* kFaceKeyFrameAssetNameKey = "animName";
 
+// Number of keyframes GetCurrentKeyFrame() will step through from the last accessed keyframe
+// before falling back to a binary search, e.g. after a large jump forward in time
+constexpr size_t kMaxLinearKeyFrameSteps = 4;
+
 constexpr TimeStamp_t kOverrideIndefinitely = std::numeric_limits<TimeStamp_t>::infinity();
 
 // Fwd declare local helper
@@ -473,9 +479,8 @@ bool GetFrameFromSpriteSequenceHelper(const Vision::SpriteSequence& sequence,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SpriteBoxTrack::SpriteBoxTrack()
 : _lastAccessTime_ms(0)
-, _firstKeyFrameTime_ms(std::numeric_limits<TimeStamp_t>::max())
-, _lastKeyFrameTime_ms(0)
-, _iteratorsAreValid(false)
+, _cursorIsValid(false)
+, _cursorIdx(0)
 , _remappedAssetID(Vision::SpritePathMap::kInvalidSpriteID)
 {
 }
@@ -485,10 +490,9 @@ SpriteBoxTrack::SpriteBoxTrack(const SpriteBoxTrack& other)
 :_track(other._track)
 // last access should not copy
 , _lastAccessTime_ms(0)
-, _firstKeyFrameTime_ms(other._firstKeyFrameTime_ms)
-, _lastKeyFrameTime_ms(other._lastKeyFrameTime_ms)
-// Remaps and iterators do not copy
-, _iteratorsAreValid(false)
+// Remaps and cursor do not copy
+, _cursorIsValid(false)
+, _cursorIdx(0)
 , _remappedAssetID(Vision::SpritePathMap::kInvalidSpriteID)
 {
 }
@@ -496,71 +500,99 @@ SpriteBoxTrack::SpriteBoxTrack(const SpriteBoxTrack& other)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SpriteBoxTrack::InsertKeyFrame(Vision::SpriteBoxKeyFrame&& spriteBox)
 {
-  _iteratorsAreValid = false;
-  TimeStamp_t triggerTime_ms = spriteBox.triggerTime_ms;
-  if(_track.insert(std::move(spriteBox)).second){
-    if(_firstKeyFrameTime_ms > triggerTime_ms){
-      _firstKeyFrameTime_ms = triggerTime_ms;
-    }
-    if (_lastKeyFrameTime_ms < triggerTime_ms){
-      _lastKeyFrameTime_ms = triggerTime_ms;
-    }
+  // Keyframes almost always arrive in time order (loading, AppendTracks, SDK streaming), so just append
+  if(_track.empty() || (_track.back().triggerTime_ms < spriteBox.triggerTime_ms)){
+    _track.push_back(std::move(spriteBox));
     return true;
   }
 
-  return false;
+  const TimeStamp_t triggerTime_ms = spriteBox.triggerTime_ms;
+  auto insertIter = std::lower_bound(_track.begin(), _track.end(), triggerTime_ms,
+                                     [](const Vision::SpriteBoxKeyFrame& keyFrame, const TimeStamp_t time_ms){
+                                       return keyFrame.triggerTime_ms < time_ms;
+                                     });
+  if(insertIter->triggerTime_ms == triggerTime_ms){
+    // Duplicate
+    return false;
+  }
+
+  const size_t insertIdx = std::distance(_track.begin(), insertIter);
+  _track.insert(insertIter, std::move(spriteBox));
+
+  // Keyframes at or after the insertion point moved up by one
+  if(insertIdx <= _cursorIdx){
+    _cursorIsValid = false;
+  }
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SpriteBoxTrack::ClearUpToTime(const TimeStamp_t toTime_ms)
 {
-  if(_track.empty()){
-    // Make sure we don't try to increment an end() iterator
+  if(_track.empty() || (toTime_ms < _track.front().triggerTime_ms)){
     return;
   }
 
-  // Find the current set of keyframes
-  auto currentKeyFrameIter = _track.begin();
-  auto nextKeyFrameIter = ++_track.begin();
+  // Keep the current keyframe, drop everything before it
+  auto currentKeyFrameIter = std::upper_bound(_track.begin(), _track.end(), toTime_ms,
+                                              [](const TimeStamp_t time_ms, const Vision::SpriteBoxKeyFrame& keyFrame){
+                                                return time_ms < keyFrame.triggerTime_ms;
+                                              });
+  --currentKeyFrameIter;
+
+  const size_t numToErase = std::distance(_track.begin(), currentKeyFrameIter);
+  if(numToErase > 0){
+    _track.erase(_track.begin(), currentKeyFrameIter);
 
-  while( (_track.end() != nextKeyFrameIter) && (nextKeyFrameIter->triggerTime_ms <= toTime_ms) ){
-    ++currentKeyFrameIter;
-    ++nextKeyFrameIter;
+    if(_cursorIdx >= numToErase){
+      _cursorIdx -= numToErase;
+    } else {
+      _cursorIsValid = false;
+    }
   }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t SpriteBoxTrack::FindKeyFrameIndex(const TimeStamp_t timeSinceAnimStart_ms)
+{
+  size_t searchStartIdx = 0;
 
-  bool modifiedTrack = false;
-  if(_track.begin() != currentKeyFrameIter){
-    currentKeyFrameIter = _track.erase(_track.begin(), currentKeyFrameIter);
-    modifiedTrack = true;
-    _firstKeyFrameTime_ms = _track.begin()->triggerTime_ms;
+  // Use the last access as a search start point (if appropriate) to optimize search for linear playback
+  if(_cursorIsValid && (timeSinceAnimStart_ms >= _lastAccessTime_ms)){
+    searchStartIdx = _cursorIdx;
+    for(size_t step = 0; step < kMaxLinearKeyFrameSteps; ++step){
+      const size_t nextIdx = searchStartIdx + 1;
+      if( (nextIdx == _track.size()) || (_track[nextIdx].triggerTime_ms > timeSinceAnimStart_ms) ){
+        return searchStartIdx;
+      }
+      searchStartIdx = nextIdx;
+    }
   }
 
-  _iteratorsAreValid &= !modifiedTrack;
+  // First keyframe after the requested time. Since the search starts at a keyframe at or before that time,
+  // the one before it is the current keyframe.
+  auto nextKeyFrameIter = std::upper_bound(_track.begin() + searchStartIdx, _track.end(), timeSinceAnimStart_ms,
+                                           [](const TimeStamp_t time_ms, const Vision::SpriteBoxKeyFrame& keyFrame){
+                                             return time_ms < keyFrame.triggerTime_ms;
+                                           });
+  return std::distance(_track.begin(), nextKeyFrameIter) - 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SpriteBoxTrack::GetCurrentKeyFrame(const TimeStamp_t timeSinceAnimStart_ms, Vision::SpriteBoxKeyFrame& outKeyFrame)
 {
-  if(_track.empty() || (timeSinceAnimStart_ms < _firstKeyFrameTime_ms) ){
+  if(_track.empty() || (timeSinceAnimStart_ms < _track.front().triggerTime_ms) ){
     // Nothing to draw yet
     return false;
   }
 
-  // Use the last access as a search start point (if appropriate) to optimize search for linear playback
-  if(!_iteratorsAreValid || (timeSinceAnimStart_ms < _lastAccessTime_ms) ){
-    // Rewind
-    _currentKeyFrameIter = _track.begin();
-    _nextKeyFrameIter = ++_track.begin();
-    _iteratorsAreValid = true;
-  }
+  _cursorIdx = FindKeyFrameIndex(timeSinceAnimStart_ms);
+  _cursorIsValid = true;
   _lastAccessTime_ms = timeSinceAnimStart_ms;
 
-  // Find the current set of keyframes
-  while( (_track.end() != _nextKeyFrameIter) && (_nextKeyFrameIter->triggerTime_ms <= timeSinceAnimStart_ms) ){
-    ++_currentKeyFrameIter;
-    ++_nextKeyFrameIter;
-  }
-  outKeyFrame = *_currentKeyFrameIter;
+  const size_t nextIdx = _cursorIdx + 1;
+  outKeyFrame = _track[_cursorIdx];
 
   // "Clear" keyframes override everything, including remaps and "Empty"s. Render nothing for this keyframe
   if(Vision::SpritePathMap::kClearSpriteBoxID == outKeyFrame.assetID){
@@ -579,15 +611,15 @@ bool SpriteBoxTrack::GetCurrentKeyFrame(const TimeStamp_t timeSinceAnimStart_ms,
   }
 
   if( (timeSinceAnimStart_ms == outKeyFrame.triggerTime_ms) ||
-      (_track.end() == _nextKeyFrameIter) )
+      (_track.size() == nextIdx) )
   {
     // No interpolation required/possible
     return true;
   }
 
   // Interpolate between keyframes as appropriate for timestamp
-  const auto& currentKeyFrame = *_currentKeyFrameIter;
-  const auto& nextKeyFrame = *_nextKeyFrameIter;
+  const auto& currentKeyFrame = _track[_cursorIdx];
+  const auto& nextKeyFrame = _track[nextIdx];
 
   const float interpRatio = ( (float)(timeSinceAnimStart_ms - currentKeyFrame.triggerTime_ms) /
                               (float)(nextKeyFrame.triggerTime_ms - currentKeyFrame.triggerTime_ms) );
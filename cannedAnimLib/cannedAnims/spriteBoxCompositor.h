@@ -21,8 +21,8 @@
 #include "coretech/vision/shared/spriteCache/spriteWrapper.h"
 #include "coretech/vision/shared/spritePathMap.h"
 
-#include <set>
 #include <unordered_map>
+#include <vector>
 
 // Fwd Decl
 namespace CozmoAnim {
@@ -118,7 +118,7 @@ private:
 
   bool _overrideAllSpritesToEyeHue;
 
-  // Map from SpriteBoxName to set of keyframes ordered by triggerTime_ms
+  // Map from SpriteBoxName to track of keyframes ordered by triggerTime_ms
   using SpriteBoxMap = std::unordered_map<Vision::SpriteBoxName, SpriteBoxTrack>;
   std::unique_ptr<SpriteBoxMap> _spriteBoxMap;
 
@@ -127,28 +127,23 @@ private:
 class SpriteBoxTrack
 {
 public:
-  // Sort SpriteBoxKeyFrames by triggerTime_ms within a set. This also implies that
-  // for a given SpriteBoxName, two KeyFrames are considered duplicates if they have
-  // the same triggerTime_ms. Ergo, multiple keyframes for the same SBName and trigger
-  // time are not allowed.
-  struct SpriteBoxKeyFrameCompare{
-    bool operator()(const Vision::SpriteBoxKeyFrame& lhs, const Vision::SpriteBoxKeyFrame& rhs) const {
-      return lhs.triggerTime_ms < rhs.triggerTime_ms;
-    }
-  };
-
-  using SpriteBoxKeyFrameSet = std::set<Vision::SpriteBoxKeyFrame, SpriteBoxKeyFrameCompare>;
-  using TrackIterator = SpriteBoxKeyFrameSet::iterator;
+  // SpriteBoxKeyFrames are kept sorted by triggerTime_ms. This also implies that for a
+  // given SpriteBoxName, two KeyFrames are considered duplicates if they have the same
+  // triggerTime_ms. Ergo, multiple keyframes for the same SBName and trigger time are
+  // not allowed.
+  using SpriteBoxKeyFrameList = std::vector<Vision::SpriteBoxKeyFrame>;
 
   SpriteBoxTrack();
   SpriteBoxTrack(const SpriteBoxTrack& other);
 
+  // Amortized O(1) when keyframes are added in time order, which is the common case
   bool InsertKeyFrame(Vision::SpriteBoxKeyFrame&& spriteBox);
   bool IsEmpty() const { return _track.empty(); }
   void ClearUpToTime(const TimeStamp_t toTime_ms);
 
+  // O(1) amortized for monotonically increasing times, O(log n) otherwise
   bool GetCurrentKeyFrame(const TimeStamp_t timeSinceAnimStart_ms, Vision::SpriteBoxKeyFrame& outKeyFrame);
-  const SpriteBoxKeyFrameSet& GetKeyFrames() const { return _track; }
+  const SpriteBoxKeyFrameList& GetKeyFrames() const { return _track; }
 
   void SetAssetRemap(const Vision::SpritePathMap::AssetID remappedAssetID){ _remappedAssetID = remappedAssetID; }
   void ClearAssetRemap(){ _remappedAssetID = Vision::SpritePathMap::kInvalidSpriteID; }
@@ -158,15 +153,17 @@ private:
   SpriteBoxTrack& operator=(SpriteBoxTrack&& other); // Move assignment
   SpriteBoxTrack& operator=(const SpriteBoxTrack& other); // Copy assignment
 
-  SpriteBoxKeyFrameSet _track;
+  // Returns the index of the last keyframe at or before timeSinceAnimStart_ms, starting the search
+  // from the last accessed keyframe when time hasn't gone backwards. Track must not be empty, and
+  // the time must not be before the first keyframe.
+  size_t FindKeyFrameIndex(const TimeStamp_t timeSinceAnimStart_ms);
+
+  SpriteBoxKeyFrameList _track;
 
   TimeStamp_t _lastAccessTime_ms;
-  TimeStamp_t _firstKeyFrameTime_ms;
-  TimeStamp_t _lastKeyFrameTime_ms;
 
-  bool _iteratorsAreValid;
-  TrackIterator _currentKeyFrameIter;
-  TrackIterator _nextKeyFrameIter;
+  bool   _cursorIsValid;
+  size_t _cursorIdx;
 
   Vision::SpritePathMap::AssetID _remappedAssetID;
 };
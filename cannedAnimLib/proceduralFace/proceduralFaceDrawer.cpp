@@ -9,6 +9,14 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/math/math.h"
@@ -48,6 +56,9 @@ namespace Vector {
   CONSOLE_VAR_ENUM(uint8_t, kProcFace_AntiAliasingFilter,         CONSOLE_GROUP, (uint8_t)Filter::BoxFilter, "None,Box,Gaussian");
   CONSOLE_VAR_RANGED(f32,   kProcFace_AntiAliasingSigmaFraction,  CONSOLE_GROUP, 0.5f, 0.0f, 1.0f);
 
+  // Number of final faces each drawer keeps around (about 35kB each)
+  CONSOLE_VAR_RANGED(s32,   kProcFace_RenderCacheSize,            CONSOLE_GROUP, 8, 0, 32);
+
 
 #if PROCEDURALFACE_GLOW_FEATURE
   CONSOLE_VAR_RANGED(f32, kProcFace_GlowSizeMultiplier,           CONSOLE_GROUP, 1.f, 0.f, 1.f);
@@ -74,21 +85,63 @@ namespace Vector {
 
   #undef CONSOLE_GROUP
 
-  // Initialize static vars
+  namespace {
+    // Rectangles here cover the pixels [x, x+width) x [y, y+height)
+    Rectangle<s32> ToPixelRect(const Rectangle<f32>& bbox)
+    {
+      // Eye bounding box corners can be fractional (e.g. padded by half the antialiasing size), and DrawEye writes
+      // every pixel from the truncated top left corner up to and including the bottom right one. Rounding outwards
+      // always covers all of those.
+      const s32 xMin = static_cast<s32>(std::floor(bbox.GetX()));
+      const s32 yMin = static_cast<s32>(std::floor(bbox.GetY()));
+      const s32 xMax = static_cast<s32>(std::ceil(bbox.GetXmax()));
+      const s32 yMax = static_cast<s32>(std::ceil(bbox.GetYmax()));
+      return Rectangle<s32>(xMin, yMin, xMax - xMin + 1, yMax - yMin + 1);
+    }
 
-#if PROCEDURALFACE_GLOW_FEATURE
-  Vision::Image ProceduralFaceDrawer::_glowImg;
-#endif
-  Vision::Image ProceduralFaceDrawer::_eyeShape; // temporary working surface, I8
+    bool IsEmptyRect(const Rectangle<s32>& rect)
+    {
+      return (rect.GetWidth() <= 0) || (rect.GetHeight() <= 0);
+    }
+
+    Rectangle<s32> UnionRect(const Rectangle<s32>& a, const Rectangle<s32>& b)
+    {
+      if(IsEmptyRect(a)) {
+        return b;
+      } else if(IsEmptyRect(b)) {
+        return a;
+      }
+      const s32 xMin = std::min(a.GetX(), b.GetX());
+      const s32 yMin = std::min(a.GetY(), b.GetY());
+      const s32 xMax = std::max(a.GetX() + a.GetWidth(), b.GetX() + b.GetWidth());
+      const s32 yMax = std::max(a.GetY() + a.GetHeight(), b.GetY() + b.GetHeight());
+      return Rectangle<s32>(xMin, yMin, xMax - xMin, yMax - yMin);
+    }
+
+    bool RectsOverlap(const Rectangle<s32>& a, const Rectangle<s32>& b)
+    {
+      return (!IsEmptyRect(a) && !IsEmptyRect(b) &&
+              (a.GetX() < b.GetX() + b.GetWidth()) && (b.GetX() < a.GetX() + a.GetWidth()) &&
+              (a.GetY() < b.GetY() + b.GetHeight()) && (b.GetY() < a.GetY() + a.GetHeight()));
+    }
 
-  struct ProceduralFaceDrawer::FaceCache ProceduralFaceDrawer::_faceCache;
+    void ClearRect(Vision::Image& img, const Rectangle<s32>& rect)
+    {
+      if(!IsEmptyRect(rect)) {
+        img.GetROI(rect).FillWith(0);
+      }
+    }
+  }
 
-  Rectangle<f32> ProceduralFaceDrawer::_leftBBox;
-  Rectangle<f32> ProceduralFaceDrawer::_rightBBox;
-  s32 ProceduralFaceDrawer::_faceColMin;
-  s32 ProceduralFaceDrawer::_faceColMax;
-  s32 ProceduralFaceDrawer::_faceRowMin;
-  s32 ProceduralFaceDrawer::_faceRowMax;
+  ProceduralFaceDrawer::ProceduralFaceDrawer()
+  {
+  }
+
+  ProceduralFaceDrawer& ProceduralFaceDrawer::GetSharedDrawer()
+  {
+    static ProceduralFaceDrawer sharedDrawer;
+    return sharedDrawer;
+  }
 
   Matrix_3x3f ProceduralFaceDrawer::GetTransformationMatrix(f32 angleDeg, f32 scaleX, f32 scaleY,
                                                             f32 tX, f32 tY, f32 x0, f32 y0)
@@ -167,7 +220,7 @@ namespace Vector {
     return noiseImg;
   }
 
-  const Array2d<u8>& ProceduralFaceDrawer::GetNoiseImage(const Util::RandomGenerator& rng)
+  const Array2d<u8>& ProceduralFaceDrawer::GetNoiseImage(const Util::RandomGenerator& rng, s32 noiseIndex)
   {
     // NOTE: Since this is called separately for each eye, this looks better if we use an odd number of images
     static_assert(kNumNoiseImages % 2 == 1, "Use odd number of noise images");
@@ -186,6 +239,7 @@ namespace Vector {
     kProcFace_NoiseMaxLightness = Anki::Util::Clamp(kProcFace_NoiseMaxLightness, kProcFace_NoiseMinLightness, 2.f);
   #endif // REMOTE_CONSOLE_ENABLED
 
+    // Note: regenerating the images is not thread safe, but only happens when tweaking the console vars
     static f32 kProcFace_NoiseMinLightness_old = kProcFace_NoiseMinLightness;
     static f32 kProcFace_NoiseMaxLightness_old = kProcFace_NoiseMaxLightness;
     if(kProcFace_NoiseMinLightness_old != kProcFace_NoiseMinLightness || kProcFace_NoiseMaxLightness_old != kProcFace_NoiseMaxLightness) {
@@ -198,14 +252,7 @@ namespace Vector {
       kProcFace_NoiseMaxLightness_old = kProcFace_NoiseMaxLightness;
     }
 
-    if(kProcFace_NoiseNumFrames == 0) {
-      return kNoiseImages[0];
-    } else {
-      // Cycle circularly through the set of noise images
-      static s32 index = 0;
-      index = (index + 1) % kProcFace_NoiseNumFrames;
-      return kNoiseImages[index];
-    }
+    return kNoiseImages[noiseIndex];
   }
 #endif // PROCEDURALFACE_NOISE_FEATURE
 
@@ -220,11 +267,11 @@ namespace Vector {
       switch(kProcFace_AntiAliasingFilter) {
         case (uint8_t)Filter::BoxFilter:
         {
-          static Vision::Image temp(shape.GetNumRows(), shape.GetNumCols());
-          temp.FillWith(0);
-          Vision::Image tempImage = temp.GetROI(boundingBoxS32);
+          _antiAliasingImg.Allocate(shape.GetNumRows(), shape.GetNumCols());
+          _antiAliasingImg.FillWith(0);
+          Vision::Image tempImage = _antiAliasingImg.GetROI(boundingBoxS32);
           shapeROI.BoxFilter(tempImage, kProcFace_AntiAliasingSize);
-          std::swap(shape, temp);
+          std::swap(shape, _antiAliasingImg);
           break;
         }
         case (uint8_t)Filter::GaussianFilter:
@@ -658,36 +705,210 @@ namespace Vector {
   void ProceduralFaceDrawer::DrawFace(const ProceduralFace& faceData,
                                       const Util::RandomGenerator& rng,
                                       Vision::ImageRGB565& output)
+  {
+    GetSharedDrawer().Draw(faceData, rng, output);
+  } // DrawFace()
+
+  void ProceduralFaceDrawer::DrawFace(const ProceduralFace& faceData,
+                                      const Util::RandomGenerator& rng,
+                                      Vision::ImageRGB565& output,
+                                      std::vector<Rectangle<s32>>& out_dirtyRects)
+  {
+    GetSharedDrawer().Draw(faceData, rng, output, out_dirtyRects);
+  } // DrawFace()
+
+  void ProceduralFaceDrawer::Draw(const ProceduralFace& faceData,
+                                  const Util::RandomGenerator& rng,
+                                  Vision::ImageRGB565& output)
+  {
+    Draw(faceData, ProceduralFace::GetHue(), ProceduralFace::GetSaturation(), rng, output, _dirtyRects);
+  } // Draw()
+
+  void ProceduralFaceDrawer::Draw(const ProceduralFace& faceData,
+                                  const Util::RandomGenerator& rng,
+                                  Vision::ImageRGB565& output,
+                                  std::vector<Rectangle<s32>>& out_dirtyRects)
+  {
+    Draw(faceData, ProceduralFace::GetHue(), ProceduralFace::GetSaturation(), rng, output, out_dirtyRects);
+  } // Draw()
+
+  void ProceduralFaceDrawer::Draw(const ProceduralFace& faceData,
+                                  Value hue,
+                                  Value saturation,
+                                  const Util::RandomGenerator& rng,
+                                  Vision::ImageRGB565& output)
+  {
+    Draw(faceData, hue, saturation, rng, output, _dirtyRects);
+  } // Draw()
+
+  void ProceduralFaceDrawer::Draw(const ProceduralFace& faceData,
+                                  Value hue,
+                                  Value saturation,
+                                  const Util::RandomGenerator& rng,
+                                  Vision::ImageRGB565& output,
+                                  std::vector<Rectangle<s32>>& out_dirtyRects)
   {
     ANKI_CPU_PROFILE("DrawFace");
 
+    if(PROCEDURALFACE_NOISE_FEATURE && (kProcFace_NoiseNumFrames > 0)) {
+      // Cycle circularly through the set of noise images
+      _noiseIndex = (_noiseIndex + 1) % kProcFace_NoiseNumFrames;
+    } else {
+      _noiseIndex = 0;
+    }
+
+    // Scanline distortion is random, so those faces can't be reused
+    const bool useCache = (kProcFace_RenderCacheSize > 0) && (faceData.GetScanlineDistorter() == nullptr);
+    FaceKey key;
+    size_t hash = 0;
+    if(useCache) {
+      key = GetFaceKey(faceData, hue, saturation, _noiseIndex);
+      hash = GetFaceKeyHash(key);
+      if(DrawFromCache(key, hash, output)) {
+        if(&out_dirtyRects != &_dirtyRects) {
+          out_dirtyRects = _dirtyRects;
+        }
+        return;
+      }
+    }
+
+    _dirtyRects.clear();
+    _wholeFaceDirty = false;
+
     bool dirty = false; // set to true to force all stages to render, previous pipeline
     dirty = DrawEyes(faceData, dirty);
-    dirty = ApplyScanlines(_faceCache.img8[_faceCache.finalFace], faceData.GetScanlineOpacity(), dirty);
+    if(ApplyScanlines(_faceCache.img8[_faceCache.finalFace], faceData.GetScanlineOpacity(), false)) {
+      dirty = true;
+      _wholeFaceDirty = true;
+    }
     dirty = DistortScanlines(faceData, dirty);
     dirty = ApplyNoise(rng, dirty);
-    dirty = ConvertColorspace(faceData, output, dirty);
-  } // DrawFace()
+    dirty = ConvertColorspace(hue, saturation, output, dirty);
+
+    if(useCache) {
+      AddToCache(key, hash);
+    }
+
+    if(&out_dirtyRects != &_dirtyRects) {
+      out_dirtyRects = _dirtyRects;
+    }
+  } // Draw()
+
+  ProceduralFaceDrawer::FaceKey ProceduralFaceDrawer::GetFaceKey(const ProceduralFace& faceData,
+                                                                 Value hue, Value saturation, s32 noiseIndex)
+  {
+    FaceKey key;
+    const auto& leftParams  = faceData.GetParameters(WhichEye::Left);
+    const auto& rightParams = faceData.GetParameters(WhichEye::Right);
+    auto keyIter = std::copy(leftParams.begin(), leftParams.end(), key.begin());
+    keyIter = std::copy(rightParams.begin(), rightParams.end(), keyIter);
+
+    *keyIter++ = faceData.GetFaceAngle();
+    *keyIter++ = faceData.GetFacePosition().x();
+    *keyIter++ = faceData.GetFacePosition().y();
+    *keyIter++ = faceData.GetFaceScale().x();
+    *keyIter++ = faceData.GetFaceScale().y();
+    *keyIter++ = hue;
+    *keyIter++ = saturation;
+    *keyIter++ = faceData.GetScanlineOpacity();
+    *keyIter++ = static_cast<Value>(noiseIndex);
+#if PROCEDURALFACE_NOISE_FEATURE
+    // Changing these regenerates the noise images
+    *keyIter++ = kProcFace_NoiseMinLightness;
+    *keyIter++ = kProcFace_NoiseMaxLightness;
+#else
+    *keyIter++ = 0.f;
+    *keyIter++ = 0.f;
+#endif
+    DEV_ASSERT(keyIter == key.end(), "ProceduralFaceDrawer.GetFaceKey.WrongKeySize");
+
+    return key;
+  }
+
+  size_t ProceduralFaceDrawer::GetFaceKeyHash(const FaceKey& key)
+  {
+    // FNV-1a over the raw values. Equal values with different bits (e.g. -0 and 0) only cost a cache miss.
+    size_t hash = 14695981039346656037ull;
+    const u8* bytes = reinterpret_cast<const u8*>(key.data());
+    for(size_t i=0; i < sizeof(FaceKey); ++i) {
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+  bool ProceduralFaceDrawer::DrawFromCache(const FaceKey& key, size_t hash, Vision::ImageRGB565& output)
+  {
+    auto iter = std::find_if(_renderedFaces.begin(), _renderedFaces.end(), [&key, hash](const RenderedFace& face) {
+      return (face.hash == hash) && (face.key == key);
+    });
+    if(iter == _renderedFaces.end()) {
+      return false;
+    }
+
+    ANKI_CPU_PROFILE("DrawFaceFromCache");
+
+    // Mark as most recently used
+    _renderedFaces.splice(_renderedFaces.begin(), _renderedFaces, iter);
+    const RenderedFace& renderedFace = _renderedFaces.front();
+
+    // Everything that was or is now drawn changed
+    _dirtyRects.clear();
+    const Rectangle<s32> dirtyRect = UnionRect(_faceCache.finalRect, renderedFace.finalRect);
+    if(!IsEmptyRect(dirtyRect)) {
+      _dirtyRects.push_back(dirtyRect);
+    }
+
+    renderedFace.img565.CopyTo(_faceCache.img565);
+    _faceCache.img565Valid = true;
+    _faceCache.finalRect = renderedFace.finalRect;
+
+    // The stage images no longer match img565, so the next face drawn by the pipeline is converted in full
+    _faceCache.convertedFace = -1;
+
+    _faceCache.img565.CopyTo(output);
+    return true;
+  }
+
+  void ProceduralFaceDrawer::AddToCache(const FaceKey& key, size_t hash)
+  {
+    const size_t maxNumFaces = static_cast<size_t>(kProcFace_RenderCacheSize);
+    while(_renderedFaces.size() > maxNumFaces) {
+      _renderedFaces.pop_back();
+    }
+
+    if(_renderedFaces.size() == maxNumFaces) {
+      // Reuse the least recently used entry, and its image memory
+      _renderedFaces.splice(_renderedFaces.begin(), _renderedFaces, std::prev(_renderedFaces.end()));
+    } else {
+      _renderedFaces.emplace_front();
+    }
+
+    RenderedFace& renderedFace = _renderedFaces.front();
+    renderedFace.hash = hash;
+    renderedFace.key = key;
+    _faceCache.img565.CopyTo(renderedFace.img565);
+    renderedFace.finalRect = _faceCache.finalRect;
+  }
 
   bool ProceduralFaceDrawer::DrawEyes(const ProceduralFace& faceData, bool dirty)
   {
     ANKI_CPU_PROFILE("DrawEyes");
 
-    if(!dirty) {
-      
-      if (_faceCache.faceData.GetParameters(WhichEye::Left) != faceData.GetParameters(WhichEye::Left) ||
-          _faceCache.faceData.GetParameters(WhichEye::Right) != faceData.GetParameters(WhichEye::Right) ||
-          _faceCache.faceData.GetFaceAngle() != faceData.GetFaceAngle() ||
-          _faceCache.faceData.GetFacePosition() != faceData.GetFacePosition() ||
-          _faceCache.faceData.GetFaceScale() != faceData.GetFaceScale() ||
-          !Util::IsFltNear(_faceCache.faceData.GetHue(), faceData.GetHue()) ||
-          !Util::IsFltNear(_faceCache.faceData.GetSaturation(), faceData.GetSaturation())) {
-        // Something changed, we must draw
-        dirty = true;
-      }
-    }
+    // Hue and saturation only affect the colorspace conversion, which checks them itself
+    const bool faceChanged = (dirty ||
+                              !_faceCache.eyesValid ||
+                              _faceCache.faceData.GetFaceAngle() != faceData.GetFaceAngle() ||
+                              _faceCache.faceData.GetFacePosition() != faceData.GetFacePosition() ||
+                              _faceCache.faceData.GetFaceScale() != faceData.GetFaceScale());
+    const bool leftChanged  = (faceChanged ||
+                               _faceCache.faceData.GetParameters(WhichEye::Left) != faceData.GetParameters(WhichEye::Left));
+    const bool rightChanged = (faceChanged ||
+                               _faceCache.faceData.GetParameters(WhichEye::Right) != faceData.GetParameters(WhichEye::Right));
+
+    if(leftChanged || rightChanged) {
+      // Something changed, we must draw
+      dirty = true;
 
-    if(dirty) {
       // Update parameters used to generate this cached image
       _faceCache.faceData.SetParameters(WhichEye::Left, faceData.GetParameters(WhichEye::Left));
       _faceCache.faceData.SetParameters(WhichEye::Right, faceData.GetParameters(WhichEye::Right));
@@ -700,8 +921,8 @@ namespace Vector {
       // Eyes are always first, assign first element in face cache
       _faceCache.finalFace = _faceCache.eyes = 0;
       DEV_ASSERT(_faceCache.finalFace < _faceCache.kSize, "ProceduralFaceDrawer.DistortScanlines.FaceCacheTooSmall");
-      _faceCache.img8[_faceCache.eyes].Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH); // Will do nothing if already the right size
-      _faceCache.img8[_faceCache.eyes].FillWith(0);
+      Vision::Image& eyesImg = _faceCache.img8[_faceCache.eyes];
+      eyesImg.Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH); // Will do nothing if already the right size
 
       // Create a full-face warp matrix if needed and provide it to the eye-rendering call
       const Matrix_3x3f* W_facePtr = nullptr;
@@ -721,8 +942,35 @@ namespace Vector {
         W_facePtr = &W_face;
       }
       
-      DrawEye(_faceCache.faceData, WhichEye::Left,  W_facePtr, _faceCache.img8[_faceCache.eyes], _leftBBox);
-      DrawEye(_faceCache.faceData, WhichEye::Right, W_facePtr, _faceCache.img8[_faceCache.eyes], _rightBBox);
+      // If only one eye changed and what it drew last time doesn't overlap the other eye, only that eye needs
+      // to be cleared and redrawn. Eyes are combined with max(), so the result is the same as redrawing both.
+      const Rectangle<s32> prevLeftRect  = ToPixelRect(_leftBBox);
+      const Rectangle<s32> prevRightRect = ToPixelRect(_rightBBox);
+      const bool eyesOverlapped = RectsOverlap(prevLeftRect, prevRightRect);
+
+      if(!leftChanged && !eyesOverlapped) {
+        ClearRect(eyesImg, prevRightRect);
+        DrawEye(_faceCache.faceData, WhichEye::Right, W_facePtr, eyesImg, _rightBBox);
+        _dirtyRects.push_back(UnionRect(prevRightRect, ToPixelRect(_rightBBox)));
+      } else if(!rightChanged && !eyesOverlapped) {
+        ClearRect(eyesImg, prevLeftRect);
+        DrawEye(_faceCache.faceData, WhichEye::Left, W_facePtr, eyesImg, _leftBBox);
+        _dirtyRects.push_back(UnionRect(prevLeftRect, ToPixelRect(_leftBBox)));
+      } else {
+        // Only the previous eyes can be non-zero, so there is no need to clear the whole image
+        if(_faceCache.eyesValid) {
+          ClearRect(eyesImg, _faceCache.eyesRect);
+        } else {
+          eyesImg.FillWith(0);
+        }
+        DrawEye(_faceCache.faceData, WhichEye::Left,  W_facePtr, eyesImg, _leftBBox);
+        DrawEye(_faceCache.faceData, WhichEye::Right, W_facePtr, eyesImg, _rightBBox);
+        _dirtyRects.push_back(_faceCache.eyesRect);
+        _dirtyRects.push_back(UnionRect(ToPixelRect(_leftBBox), ToPixelRect(_rightBBox)));
+      }
+
+      _faceCache.eyesRect = UnionRect(ToPixelRect(_leftBBox), ToPixelRect(_rightBBox));
+      _faceCache.eyesValid = true;
       
       const std::array<Quad2f,2> leftRightQuads{{ Quad2f(_leftBBox), Quad2f(_rightBBox) }};
       
@@ -767,6 +1015,7 @@ namespace Vector {
       //       scanline distortion applied to the original output rather than a face that has already
       //       had scanline distortion applied.
       dirty = true;
+      _wholeFaceDirty = true;
 
       _faceCache.finalFace = _faceCache.distortedFace = _faceCache.eyes+1;
       DEV_ASSERT(_faceCache.finalFace < _faceCache.kSize, "ProceduralFaceDrawer, face cache too small.");
@@ -826,7 +1075,9 @@ namespace Vector {
         _faceCache.img8[_faceCache.finalFace].FillWith(0);
       }
 
+      // Noise changes every frame, so the whole face has to be converted again
       dirty = true;
+      _wholeFaceDirty = true;
 
       // Assign a new face cache for noise, the reason for the changes.
       // If the eyes haven't changed, the face hasn't changed and no-scanline distorter
@@ -836,76 +1087,105 @@ namespace Vector {
       // ^ might not be desirable with the neon version. May incur cache penalty when pulling images from memory twice
       // instead of just once...
       
-      const Array2d<u8>& noiseImg = GetNoiseImage(rng);
+      const Array2d<u8>& noiseImg = GetNoiseImage(rng, _noiseIndex);
 
       for(s32 i=_faceRowMin; i<=_faceRowMax; ++i) {
-
-        const u8* noiseImg_i = noiseImg.GetRow(i);
-        const u8* eyeShape_i = _faceCache.img8[_faceCache.distortedFace].GetRow(i);
-        u8* faceImg_i = _faceCache.img8[_faceCache.finalFace].GetRow(i);
-
-        noiseImg_i += _faceColMin;
-        eyeShape_i += _faceColMin;
-        faceImg_i += _faceColMin;
-
-        s32 j = _faceColMin;
-#ifdef __ARM_NEON__
-        const s32 kNumElementsProcessed = 16;
-        for(; j <= _faceColMax-(kNumElementsProcessed-1); j += kNumElementsProcessed)
-        {
-          uint8x16_t eye = vld1q_u8(eyeShape_i);
-          eyeShape_i += kNumElementsProcessed;
-
-          uint8x16_t noise = vld1q_u8(noiseImg_i);
-          noiseImg_i += kNumElementsProcessed;
-
-          // Multiply eye values by noise and expand to u16
-          uint16x8_t value1 = vmull_u8(vget_low_u8(eye), vget_low_u8(noise));
-          uint16x8_t value2 = vmull_u8(vget_high_u8(eye), vget_high_u8(noise));
-          // Saturating narrowing right shift by 7 (divide by 128)
-          uint8x8_t output1 = vqshrn_n_u16(value1, 7);
-          uint8x8_t output2 = vqshrn_n_u16(value2, 7);
-          // Combine back into u8x16
-          uint8x16_t output = vcombine_u8(output1, output2);
-
-          vst1q_u8(faceImg_i, output);
-          faceImg_i += kNumElementsProcessed;
-        }
-#endif
-     
-        for(; j<=_faceColMax; ++j) {
-          *faceImg_i = Util::numeric_cast_clamped<u8>((static_cast<u16>(*eyeShape_i) * static_cast<u16>(*noiseImg_i)) >> 7);
-          ++noiseImg_i;
-          ++eyeShape_i;
-          ++faceImg_i;
-        }
+        ApplyNoiseToRow(_faceCache.img8[_faceCache.distortedFace].GetRow(i) + _faceColMin,
+                        noiseImg.GetRow(i) + _faceColMin,
+                        _faceCache.img8[_faceCache.finalFace].GetRow(i) + _faceColMin,
+                        _faceColMax - _faceColMin + 1);
       }
     }
 
     return dirty;
   } // ApplyNoise()
 
-  bool ProceduralFaceDrawer::ConvertColorspace(const ProceduralFace& faceData, Vision::ImageRGB565& output, bool dirty)
+  void ProceduralFaceDrawer::ApplyNoiseToRow(const u8* eyeShape, const u8* noise, u8* output, s32 numElements)
+  {
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    const s32 kNumElementsProcessed = 16;
+    for(; j <= numElements-kNumElementsProcessed; j += kNumElementsProcessed)
+    {
+      uint8x16_t eye = vld1q_u8(eyeShape + j);
+      uint8x16_t noiseValues = vld1q_u8(noise + j);
+
+      // Multiply eye values by noise and expand to u16
+      uint16x8_t value1 = vmull_u8(vget_low_u8(eye), vget_low_u8(noiseValues));
+      uint16x8_t value2 = vmull_u8(vget_high_u8(eye), vget_high_u8(noiseValues));
+      // Saturating narrowing right shift by 7 (divide by 128)
+      uint8x8_t output1 = vqshrn_n_u16(value1, 7);
+      uint8x8_t output2 = vqshrn_n_u16(value2, 7);
+      // Combine back into u8x16
+      vst1q_u8(output + j, vcombine_u8(output1, output2));
+    }
+#elif defined(__SSE2__)
+    const s32 kNumElementsProcessed = 16;
+    const __m128i kZeros = _mm_setzero_si128();
+    for(; j <= numElements-kNumElementsProcessed; j += kNumElementsProcessed)
+    {
+      const __m128i eye = _mm_loadu_si128(reinterpret_cast<const __m128i*>(eyeShape + j));
+      const __m128i noiseValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(noise + j));
+
+      // Expand to u16 and multiply eye values by noise (255*255 still fits in u16)
+      const __m128i value1 = _mm_mullo_epi16(_mm_unpacklo_epi8(eye, kZeros), _mm_unpacklo_epi8(noiseValues, kZeros));
+      const __m128i value2 = _mm_mullo_epi16(_mm_unpackhi_epi8(eye, kZeros), _mm_unpackhi_epi8(noiseValues, kZeros));
+      // Divide by 128 and narrow back to u8 with saturation (results are at most 508, so signed packing is fine)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j),
+                       _mm_packus_epi16(_mm_srli_epi16(value1, 7), _mm_srli_epi16(value2, 7)));
+    }
+#endif
+
+    ApplyNoiseToRowScalar(eyeShape + j, noise + j, output + j, numElements - j);
+  } // ApplyNoiseToRow()
+
+  void ProceduralFaceDrawer::ApplyNoiseToRowScalar(const u8* eyeShape, const u8* noise, u8* output, s32 numElements)
+  {
+    for(s32 j = 0; j < numElements; ++j) {
+      output[j] = Util::numeric_cast_clamped<u8>((static_cast<u16>(eyeShape[j]) * static_cast<u16>(noise[j])) >> 7);
+    }
+  } // ApplyNoiseToRowScalar()
+
+  bool ProceduralFaceDrawer::ConvertColorspace(Value hue, Value saturation, Vision::ImageRGB565& output, bool dirty)
   {
     ANKI_CPU_PROFILE("ConvertColorspace");
     
-    output.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
-    output.FillWith(Vision::PixelRGB(0,0,0));
+    if(!_faceCache.img565Valid) {
+      _faceCache.img565.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+      _faceCache.img565.FillWith(Vision::PixelRGB(0,0,0));
+      _faceCache.img565Valid = true;
+      dirty = true;
+      _wholeFaceDirty = true;
+    }
 
-    if(!dirty) {
-      if (!Util::IsFltNear(_faceCache.faceData.GetHue(), faceData.GetHue()) ||
-          !Util::IsFltNear(_faceCache.faceData.GetSaturation(), faceData.GetSaturation())) {
-        // Something changed, we must draw
-        dirty = true;
-      }
+    if(_faceCache.finalFace != _faceCache.convertedFace) {
+      // A different stage produced the final image than last time (e.g. distortion just stopped)
+      dirty = true;
+      _wholeFaceDirty = true;
+    }
+
+    if (!Util::IsFltNear(_faceCache.hue, hue) ||
+        !Util::IsFltNear(_faceCache.saturation, saturation)) {
+      // Something changed, we must draw
+      dirty = true;
+      _wholeFaceDirty = true;
+    }
+
+    // The final image is only non-zero inside the face bounds
+    const Rectangle<s32> faceRect(_faceColMin, _faceRowMin, _faceColMax-_faceColMin+1, _faceRowMax-_faceRowMin+1);
+
+    if(_wholeFaceDirty) {
+      // Also covers whatever was drawn last time, so it gets cleared
+      _dirtyRects.clear();
+      _dirtyRects.push_back(UnionRect(_faceCache.finalRect, faceRect));
     }
 
     if (dirty) {
       // Update parameters used to generate this cached image
-      _faceCache.faceData.SetHue(faceData.GetHue());
-      _faceCache.faceData.SetSaturation(faceData.GetSaturation());
+      _faceCache.hue = hue;
+      _faceCache.saturation = saturation;
 
-      const f32 hueFactor = faceData.GetHue();
+      const f32 hueFactor = hue;
       DEV_ASSERT(Util::InRange(hueFactor, 0.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidHue");
       const u8 drawHue = ROUND(255.f*hueFactor);
 
@@ -914,17 +1194,28 @@ namespace Vector {
       satFactor *= faceData.GetParameter(whichEye, Parameter::Saturation);
 #endif
 #if PROCEDURALFACE_PROCEDURAL_SATURATION
-      satFactor *= faceData.GetSaturation();
+      satFactor *= saturation;
 #endif
       DEV_ASSERT(Util::InRange(satFactor, -1.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidSaturation");
       const u8 drawSat = ROUND(255.f * satFactor);
 
-      // ... otherwise convert final image, limited by bounding box, to RGB565
-      Rectangle<s32> eyesROI(_faceColMin, _faceRowMin, _faceColMax-_faceColMin+1, _faceRowMax-_faceRowMin+1);
-      Vision::ImageRGB565 roi = output.GetROI(eyesROI);
-      _faceCache.img8[_faceCache.finalFace].GetROI(eyesROI).ConvertV2RGB565(drawHue, drawSat, roi);
+      // ... otherwise convert the changed regions of the final image to RGB565
+      for(const auto& dirtyRect : _dirtyRects) {
+        if(!IsEmptyRect(dirtyRect)) {
+          Vision::ImageRGB565 roi = _faceCache.img565.GetROI(dirtyRect);
+          _faceCache.img8[_faceCache.finalFace].GetROI(dirtyRect).ConvertV2RGB565(drawHue, drawSat, roi);
+        }
+      }
+
+      _faceCache.finalRect = faceRect;
+      _faceCache.convertedFace = _faceCache.finalFace;
     }
 
+    // Drop empty regions so callers only see what actually changed
+    _dirtyRects.erase(std::remove_if(_dirtyRects.begin(), _dirtyRects.end(), IsEmptyRect), _dirtyRects.end());
+
+    _faceCache.img565.CopyTo(output);
+
     return dirty;
   } // ConvertColorspace()
 
@@ -7,6 +7,9 @@
 #include "cannedAnimLib/proceduralFace/proceduralFaceModifierTypes.h"
 #include "coretech/vision/engine/image.h"
 
+#include <list>
+#include <vector>
+
 namespace Anki {
   
   // Forward declaration:
@@ -24,6 +27,8 @@ namespace Vector {
   {
   public:
 
+    ProceduralFaceDrawer();
+
     //  The face rendering pipeline consists of stages, each depending on the previous stage,
     //  e.g. drawing each eye, transforming the face, adding scanlines, distortion, noise,
     //  with the final image converting to a RGB565 texture to be sent to the robot.
@@ -59,6 +64,19 @@ namespace Vector {
     //
     //  ApplyScanlines is a special case as it is part of the public API and used elsewhere,
     //  its functionality has been retained and does not affect the face cache.
+    //
+    //  On top of the per-stage caching, the eyes stage only clears and redraws an eye whose
+    //  parameters changed, as long as its previous bounding box doesn't overlap the other eye.
+    //  The regions that changed are tracked through the pipeline and only those are converted
+    //  into the cached RGB565 face, and reported to the caller as dirty rectangles. Stages that
+    //  touch the whole face (scanline distortion, noise, hue/saturation changes) mark the whole
+    //  face dirty.
+    //
+    //  All of this state belongs to a drawer instance, so separate instances can render on separate
+    //  threads. Each instance also keeps a small LRU of final RGB565 faces, keyed on the parameters
+    //  (and noise frame) they were rendered from, so repeated expressions such as blinks are copied
+    //  from the cache instead of going through the pipeline again. Faces with scanline distortion
+    //  are random and never cached.
 
     // Closes eyes and switches interlacing. Call until it returns false, which
     // indicates there are no more blink frames and the face is back in its
@@ -66,8 +84,26 @@ namespace Vector {
     // the previous state.
     static bool GetNextBlinkFrame(ProceduralFace& faceData, BlinkState& out_blinkState, TimeStamp_t& out_offset);
     
-    // Actually draw the face with the current parameters
+    // Actually draw the face with the current parameters, using a drawer shared by all callers of this
+    // static version (i.e. only call these from the animation thread)
     static void DrawFace(const ProceduralFace& faceData, const Util::RandomGenerator& rng, Vision::ImageRGB565& output);
+
+    // Same as above, also returning the regions of output which differ from the previously drawn face
+    static void DrawFace(const ProceduralFace& faceData, const Util::RandomGenerator& rng, Vision::ImageRGB565& output,
+                         std::vector<Rectangle<s32>>& out_dirtyRects);
+
+    // Instance versions of the above, with this drawer's own caches
+    void Draw(const ProceduralFace& faceData, const Util::RandomGenerator& rng, Vision::ImageRGB565& output);
+    void Draw(const ProceduralFace& faceData, const Util::RandomGenerator& rng, Vision::ImageRGB565& output,
+              std::vector<Rectangle<s32>>& out_dirtyRects);
+
+    // Same as above, but with the given hue and saturation instead of the global ones (see ProceduralFace::GetHue()),
+    // which are only safe to read from the animation thread
+    void Draw(const ProceduralFace& faceData, ProceduralFace::Value hue, ProceduralFace::Value saturation,
+              const Util::RandomGenerator& rng, Vision::ImageRGB565& output);
+    void Draw(const ProceduralFace& faceData, ProceduralFace::Value hue, ProceduralFace::Value saturation,
+              const Util::RandomGenerator& rng, Vision::ImageRGB565& output,
+              std::vector<Rectangle<s32>>& out_dirtyRects);
     
     // Applies scanlines to the input image.
     // Although the type of the input image is ImageRGB, it should be an HSV image, i.e.
@@ -76,6 +112,11 @@ namespace Vector {
     static bool ApplyScanlines(Vision::ImageRGB& imageHsv, const float opacity, bool dirty = true);
     static bool ApplyScanlines(Vision::Image& image8, const float opacity, bool dirty = true);
 
+    // Multiplies numElements eye values by noise values (fixed point, 128 = 1.0) into output, saturating at 255.
+    // Uses NEON/SSE2 where available, the scalar version is the reference it has to match.
+    static void ApplyNoiseToRow(const u8* eyeShape, const u8* noise, u8* output, s32 numElements);
+    static void ApplyNoiseToRowScalar(const u8* eyeShape, const u8* noise, u8* output, s32 numElements);
+
   private:
 
     using Parameter = ProceduralEyeParameter;
@@ -85,22 +126,27 @@ namespace Vector {
     // Despite taking in an ImageRGB, note that this method actually draws in HSV and
     // is just using ImageRGB as a "3 channel image" since we don't (yet) have an ImageHSV.
     // The resulting face image is converted to RGB by DrawFace at the end.
-    static void DrawEye(const ProceduralFace& faceData, WhichEye whichEye, const Matrix_3x3f* W_facePtr,
-                        Vision::Image& faceHsv, Rectangle<f32>& eyeBoundingBox);
+    void DrawEye(const ProceduralFace& faceData, WhichEye whichEye, const Matrix_3x3f* W_facePtr,
+                 Vision::Image& faceHsv, Rectangle<f32>& eyeBoundingBox);
     
     static Matrix_3x3f GetTransformationMatrix(f32 angleDeg, f32 scaleX, f32 scaleY,
                                                f32 tX, f32 tY, f32 x0 = 0.f, f32 y0 = 0.f);
     
 #if PROCEDURALFACE_GLOW_FEATURE
-    static Vision::Image _glowImg;
+    Vision::Image _glowImg;
 #endif
-    static Vision::Image _eyeShape;
+    Vision::Image _eyeShape;
+    Vision::Image _antiAliasingImg;
 
-    static struct FaceCache {
+    struct FaceCache {
     public:
       // Stored face data, the data here was used to generate the cache values and images below
       ProceduralFace faceData;
 
+      // Hue and saturation img565 was converted with
+      Value hue = -1.f;
+      Value saturation = -1.f;
+
       // Static images to do all our drawing in, the final image will be converted to RGB565
       // at the end. These is treated as an HSV images, potentially one per stage in the face
       // pipeline
@@ -110,27 +156,66 @@ namespace Vector {
       int eyes;
       int distortedFace;
       int finalFace;
+
+      // Whether img8[eyes] and img565 hold a previously drawn face. Only eyesRect and finalRect
+      // can be non-zero in them, respectively
+      bool eyesValid = false;
+      bool img565Valid = false;
+      Rectangle<s32> eyesRect;
+      Rectangle<s32> finalRect;
+      int convertedFace = -1; // finalFace when img565 was last updated
     } _faceCache;
 
+    // Parameters a face is rendered from: both eyes, face angle/position/scale, hue, saturation,
+    // scanline opacity, noise frame and noise lightness range
+    static constexpr size_t kNumEyeParams = static_cast<size_t>(Parameter::NumParameters);
+    using FaceKey = std::array<Value, 2*kNumEyeParams + 11>;
+
+    struct RenderedFace {
+      size_t hash;
+      FaceKey key;
+      Vision::ImageRGB565 img565;
+      Rectangle<s32> finalRect;
+    };
+
+    // Most recently used first
+    std::list<RenderedFace> _renderedFaces;
+
+    // Regions changed by the current DrawFace call, or the whole face if _wholeFaceDirty
+    std::vector<Rectangle<s32>> _dirtyRects;
+    bool _wholeFaceDirty = false;
+
     // Bounding boxes, left eye, right eye, combined left/right eyes
-    static Rectangle<f32> _leftBBox;
-    static Rectangle<f32> _rightBBox;
+    Rectangle<f32> _leftBBox;
+    Rectangle<f32> _rightBBox;
 
     // Note 1: Not a Rectangle<s32> as SetX() and SetY() move the rectangle rather than resize it
     // Note 2: Any stage that modifies the bounding box is responsible for determining if there is NothingToDraw
-    static s32 _faceColMin;
-    static s32 _faceColMax;
-    static s32 _faceRowMin;
-    static s32 _faceRowMax;
+    s32 _faceColMin = 0;
+    s32 _faceColMax = 0;
+    s32 _faceRowMin = 0;
+    s32 _faceRowMax = 0;
+
+    // Index of the noise image used for the current face
+    s32 _noiseIndex = 0;
+
+    static ProceduralFaceDrawer& GetSharedDrawer();
+
+    static FaceKey GetFaceKey(const ProceduralFace& faceData, Value hue, Value saturation, s32 noiseIndex);
+    static size_t GetFaceKeyHash(const FaceKey& key);
+
+    // Returns true and fills output from the cache if this face was rendered recently
+    bool DrawFromCache(const FaceKey& key, size_t hash, Vision::ImageRGB565& output);
+    void AddToCache(const FaceKey& key, size_t hash);
 
-    static void ApplyAntiAliasing(Vision::Image& shape, float minX, float minY, float maxX, float maxY);
-    static bool DrawEyes(const ProceduralFace& faceData, bool dirty);
-    static bool DistortScanlines(const ProceduralFace& faceData, bool dirty);
-    static bool ApplyNoise(const Util::RandomGenerator& rng, bool dirty);
-    static bool ConvertColorspace(const ProceduralFace& faceData, Vision::ImageRGB565& output, bool dirty);
+    void ApplyAntiAliasing(Vision::Image& shape, float minX, float minY, float maxX, float maxY);
+    bool DrawEyes(const ProceduralFace& faceData, bool dirty);
+    bool DistortScanlines(const ProceduralFace& faceData, bool dirty);
+    bool ApplyNoise(const Util::RandomGenerator& rng, bool dirty);
+    bool ConvertColorspace(Value hue, Value saturation, Vision::ImageRGB565& output, bool dirty);
 
 #if PROCEDURALFACE_NOISE_FEATURE
-    static const Array2d<u8>& GetNoiseImage(const Util::RandomGenerator& rng);
+    static const Array2d<u8>& GetNoiseImage(const Util::RandomGenerator& rng, s32 noiseIndex);
 #endif
 
 #if PROCEDURALFACE_SCANLINE_FEATURE
@@ -0,0 +1,13 @@
+# Prebuilt libopus, used for encoding streamed mic audio
+# Sets OPUS_INCLUDE_PATHS and OPUS_LIBS for the current platform
+
+if (VICOS)
+    set(OPUS_HOME "${CMAKE_SOURCE_DIR}/3rd/opus/vicos")
+elseif (MACOSX)
+    set(OPUS_HOME "${CMAKE_SOURCE_DIR}/3rd/opus/mac")
+else()
+    message(FATAL_ERROR "No prebuilt opus library for this platform (expected VICOS or MACOSX)")
+endif()
+
+set(OPUS_INCLUDE_PATHS "${OPUS_HOME}/include")
+set(OPUS_LIBS "${OPUS_HOME}/lib/libopus.a")
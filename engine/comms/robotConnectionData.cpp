@@ -93,6 +93,17 @@ void RobotConnectionData::PushArrivedMessage(const uint8_t* buffer, uint32_t num
 
   UpdateQueueSizeStatistics();    
 }
+
+void RobotConnectionData::PushArrivedMessage(std::vector<uint8_t>&& data, const Util::TransportAddress& address)
+{
+  {
+    std::lock_guard<std::mutex> lockGuard(_messageMutex);
+    _arrivedMessages.emplace_back(std::move(data), address, TRACK_INCOMING_PACKET_LATENCY_TIMESTAMP_MS());
+    _queueSize += _arrivedMessages.back().GetMemorySize();
+  }
+
+  UpdateQueueSizeStatistics();
+}
   
 void RobotConnectionData::ReceiveData(const uint8_t* buffer, unsigned int size, const Util::TransportAddress& sourceAddress)
 {
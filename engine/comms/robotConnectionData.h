@@ -39,6 +39,8 @@ public:
   bool HasMessages();
   RobotConnectionMessageData PopNextMessage();
   void PushArrivedMessage(const uint8_t* buffer, uint32_t numBytes, const Util::TransportAddress& address);
+  // Takes ownership of a buffer holding one data message, so it's queued without copying
+  void PushArrivedMessage(std::vector<uint8_t>&& data, const Util::TransportAddress& address);
   void Clear();
   void QueueConnectionDisconnect();
 
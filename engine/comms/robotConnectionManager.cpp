@@ -35,6 +35,10 @@ namespace Vector {
 
 namespace {
 static const int kNumQueueSizeStatsToSendToDas = 4000;
+
+// Most packets that can be waiting in the pool. Normally only a few are in flight at once, but a burst after a
+// slow tick can pull in many more, which we don't want to keep around.
+static const size_t kMaxNumFreeBuffers = 64;
 }
 
 RobotConnectionManager::RobotConnectionManager(RobotManager* robotManager)
@@ -162,17 +166,21 @@ void RobotConnectionManager::ProcessArrivedMessages()
 {
   static const Util::TransportAddress addr;
   while (_udpClient.IsConnected()) {
-    char buf[MAX_PACKET_BUFFER_SIZE];
-    const ssize_t n = _udpClient.Recv(buf, sizeof(buf));
+    // Receive directly into a pooled buffer, which then gets handed along without copying
+    std::vector<uint8_t> buf = AcquireBuffer();
+    const ssize_t n = _udpClient.Recv((char *) buf.data(), buf.size());
     if (n < 0) {
       LOG_ERROR("RobotConnectionManager.ProcessArrivedMessages", "Read error from robot");
+      ReleaseData(std::move(buf));
       break;
     } else if (n == 0) {
       //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Nothing to read");
+      ReleaseData(std::move(buf));
       break;
     } else {
-      //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Read %zd/%lu from robot", n, sizeof(buf));
-      _currentConnectionData->PushArrivedMessage((const uint8_t *) buf, (uint32_t) n, addr);
+      //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Read %zd/%lu from robot", n, buf.size());
+      buf.resize(n);
+      _currentConnectionData->PushArrivedMessage(std::move(buf), addr);
     }
   }
 
@@ -289,13 +297,38 @@ bool RobotConnectionManager::PopData(std::vector<uint8_t>& data_out)
     return false;
   }
 
+  // Hang on to the buffer being replaced rather than freeing it
+  std::vector<uint8_t> previousData = std::move(data_out);
   data_out = std::move(_readyData.front());
   _readyData.pop_front();
+  ReleaseData(std::move(previousData));
   return true;
 }
 
+void RobotConnectionManager::ReleaseData(std::vector<uint8_t>&& data)
+{
+  if ((data.capacity() >= MAX_PACKET_BUFFER_SIZE) && (_freeBuffers.size() < kMaxNumFreeBuffers)) {
+    _freeBuffers.push_back(std::move(data));
+  }
+}
+
+std::vector<uint8_t> RobotConnectionManager::AcquireBuffer()
+{
+  std::vector<uint8_t> buffer;
+  if (!_freeBuffers.empty()) {
+    buffer = std::move(_freeBuffers.back());
+    _freeBuffers.pop_back();
+  }
+  // Doesn't reallocate for pooled buffers, which already have the capacity
+  buffer.resize(MAX_PACKET_BUFFER_SIZE);
+  return buffer;
+}
+
 void RobotConnectionManager::ClearData()
 {
+  for (auto& data : _readyData) {
+    ReleaseData(std::move(data));
+  }
   _readyData.clear();
 }
 
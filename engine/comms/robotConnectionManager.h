@@ -63,8 +63,12 @@ public:
 
   bool SendData(const uint8_t* buffer, unsigned int size);
 
+  // Moves the next message into data_out. The buffer previously held by data_out is returned to the packet pool.
   bool PopData(std::vector<uint8_t>& data_out);
 
+  // Returns a buffer to the packet pool once its message has been handled
+  void ReleaseData(std::vector<uint8_t>&& data);
+
   void ClearData();
 
   const Anki::Util::Stats::StatsAccumulator& GetQueuedTimes_ms() const;
@@ -90,10 +94,18 @@ private:
   void HandleDisconnectMessage(RobotConnectionMessageData& nextMessage);
   void HandleConnectionRequestMessage(RobotConnectionMessageData& nextMessage);
 
+  // Get a buffer with room for one packet, from the pool if possible
+  std::vector<uint8_t> AcquireBuffer();
+
   std::unique_ptr<RobotConnectionData>      _currentConnectionData;
   RobotManager*                             _robotManager = nullptr;
   std::deque<std::vector<uint8_t>>          _readyData;
 
+  // Packet buffers that have been handled and can be reused. Each packet is received straight into one of these,
+  // then the buffer is moved through the queues to the message handler and back here, so steady state traffic
+  // (e.g. the robot state stream) doesn't copy or allocate.
+  std::vector<std::vector<uint8_t>>         _freeBuffers;
+
 #if TRACK_INCOMING_PACKET_LATENCY
   Util::Stats::RecentStatsAccumulator _queuedTimes_ms = 100; // how many ms between packet arriving and it being passed onto game
 #endif // TRACK_INCOMING_PACKET_LATENCY
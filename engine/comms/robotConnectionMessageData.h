@@ -50,6 +50,15 @@ public:
   , _timeReceived_ms(timeReceived_ms)
 #endif // TRACK_INCOMING_PACKET_LATENCY
   { }
+
+  // This constructor handles messages with data, taking ownership of a buffer that already holds it
+  RobotConnectionMessageData(std::vector<uint8_t>&& data, const Util::TransportAddress& address, Util::NetTimeStamp timeReceived_ms)
+  : _rawMessageData(std::move(data))
+  , _address(address)
+#if TRACK_INCOMING_PACKET_LATENCY
+  , _timeReceived_ms(timeReceived_ms)
+#endif // TRACK_INCOMING_PACKET_LATENCY
+  { }
   
   // This constructor handles messages with information about connection state
   RobotConnectionMessageData(RobotConnectionMessageType newType, const Util::TransportAddress& address, Util::NetTimeStamp timeReceived_ms)
@@ -25,6 +25,7 @@
 #include "engine/cozmoContext.h"
 #include "engine/cozmoEngine.h"
 #include "engine/debug/cladLoggerProvider.h"
+#include "engine/debug/devLoggingSystem.h"
 #include "engine/events/ankiEvent.h"
 #include "engine/externalInterface/externalInterface.h"
 #include "engine/factory/factoryTestLogger.h"
@@ -392,6 +393,10 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
 
   _context->GetRobotTest()->Update();
 
+  if (nullptr != DevLoggingSystem::GetInstance()) {
+    DevLoggingSystem::GetInstance()->Update();
+  }
+
   // Handle UI
   if (!_uiWasConnected && _uiMsgHandler->HasDesiredNumUiDevices()) {
     LOG_INFO("CozmoEngine.Update.UIConnected", "UI has connected");
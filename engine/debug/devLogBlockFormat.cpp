@@ -0,0 +1,231 @@
+/**
+* File: devLogBlockFormat
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Block format for the raw message logs
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#include "engine/debug/devLogBlockFormat.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Anki {
+namespace Vector {
+namespace DevLogBlockFormat {
+
+namespace {
+  // LZ4 block format constraints: matches are at least 4 bytes, the last 5 bytes are always literals and the last
+  // match has to start at least 12 bytes before the end
+  constexpr size_t   kMinMatch      = 4;
+  constexpr size_t   kLastLiterals  = 5;
+  constexpr size_t   kMatchLimit    = 12;
+  constexpr size_t   kMaxOffset     = 0xFFFF;
+  constexpr uint32_t kHashLog       = 12;
+
+  inline uint32_t Read32(const uint8_t* ptr)
+  {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+  }
+
+  inline uint32_t Hash(uint32_t sequence)
+  {
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+  }
+
+  // Lengths that don't fit in a token nibble continue in extra bytes of 255 until one is smaller
+  inline void AppendLength(size_t length, std::string& dst)
+  {
+    while (length >= 255) {
+      dst.push_back((char)255);
+      length -= 255;
+    }
+    dst.push_back((char)length);
+  }
+
+  void AppendSequence(const uint8_t* literals, size_t numLiterals, size_t offset, size_t matchLength,
+                      std::string& dst)
+  {
+    const size_t matchCode = (matchLength > 0) ? (matchLength - kMinMatch) : 0;
+    const uint8_t token = (uint8_t)((std::min<size_t>(numLiterals, 15) << 4) | std::min<size_t>(matchCode, 15));
+    dst.push_back((char)token);
+    if (numLiterals >= 15) {
+      AppendLength(numLiterals - 15, dst);
+    }
+    dst.append(reinterpret_cast<const char*>(literals), numLiterals);
+
+    if (matchLength > 0) {
+      dst.push_back((char)(offset & 0xFF));
+      dst.push_back((char)(offset >> 8));
+      if (matchCode >= 15) {
+        AppendLength(matchCode - 15, dst);
+      }
+    }
+  }
+
+  // Reads the rest of a length started in a token, returns false if it runs off the end
+  inline bool ReadLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length)
+  {
+    uint8_t byte = 255;
+    while (byte == 255) {
+      if (ip >= ipEnd) {
+        return false;
+      }
+      byte = *ip++;
+      length += byte;
+    }
+    return true;
+  }
+}
+
+void CompressLZ4(const uint8_t* src, size_t srcSize, std::string& dst)
+{
+  size_t anchor = 0;
+
+  if (srcSize > kMatchLimit) {
+    // Positions + 1 of the last sequence seen with each hash, so that 0 means none
+    std::vector<uint32_t> hashTable(1 << kHashLog, 0);
+
+    const size_t searchEnd = srcSize - kMatchLimit;
+    const size_t matchEnd  = srcSize - kLastLiterals;
+    size_t pos = 0;
+    while (pos <= searchEnd) {
+      const uint32_t sequence = Read32(src + pos);
+      uint32_t& entry = hashTable[Hash(sequence)];
+      const size_t candidate = entry;
+      entry = (uint32_t)(pos + 1);
+
+      if ((candidate == 0) || ((pos - (candidate - 1)) > kMaxOffset) || (Read32(src + candidate - 1) != sequence)) {
+        ++pos;
+        continue;
+      }
+
+      const size_t matchPos = candidate - 1;
+      size_t matchLength = kMinMatch;
+      while ((pos + matchLength < matchEnd) && (src[matchPos + matchLength] == src[pos + matchLength])) {
+        ++matchLength;
+      }
+
+      AppendSequence(src + anchor, pos - anchor, pos - matchPos, matchLength, dst);
+      pos += matchLength;
+      anchor = pos;
+    }
+  }
+
+  // Whatever is left goes out as literals, with no match
+  AppendSequence(src + anchor, srcSize - anchor, 0, 0, dst);
+}
+
+bool DecompressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+  const uint8_t* ip = src;
+  const uint8_t* const ipEnd = src + srcSize;
+  size_t op = 0;
+
+  while (ip < ipEnd) {
+    const uint8_t token = *ip++;
+
+    size_t numLiterals = token >> 4;
+    if ((numLiterals == 15) && !ReadLength(ip, ipEnd, numLiterals)) {
+      return false;
+    }
+    if ((numLiterals > (size_t)(ipEnd - ip)) || (numLiterals > dstSize - op)) {
+      return false;
+    }
+    if (numLiterals > 0) {
+      // dst can be null when nothing is expected at all
+      memcpy(dst + op, ip, numLiterals);
+    }
+    ip += numLiterals;
+    op += numLiterals;
+
+    // The last sequence has no match
+    if (ip == ipEnd) {
+      break;
+    }
+
+    if (ipEnd - ip < 2) {
+      return false;
+    }
+    const size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if ((offset == 0) || (offset > op)) {
+      return false;
+    }
+
+    size_t matchLength = token & 0x0F;
+    if ((matchLength == 15) && !ReadLength(ip, ipEnd, matchLength)) {
+      return false;
+    }
+    matchLength += kMinMatch;
+    if (matchLength > dstSize - op) {
+      return false;
+    }
+
+    // Matches can overlap what they're writing, so this has to go byte by byte
+    const uint8_t* match = dst + op - offset;
+    for (size_t i = 0; i < matchLength; ++i) {
+      dst[op + i] = match[i];
+    }
+    op += matchLength;
+  }
+
+  return (op == dstSize);
+}
+
+void EncodeBlock(const uint8_t* records, size_t recordsSize,
+                 uint32_t numRecords, uint32_t firstTimestamp_ms, uint32_t lastTimestamp_ms,
+                 bool compress, std::string& out)
+{
+  BlockHeader header;
+  header.numRecords = numRecords;
+  header.firstTimestamp_ms = firstTimestamp_ms;
+  header.lastTimestamp_ms = lastTimestamp_ms;
+  header.rawSize = (uint32_t)recordsSize;
+
+  const size_t headerPos = out.size();
+  out.append(sizeof(header), '\0');
+
+  if (compress) {
+    CompressLZ4(records, recordsSize, out);
+    if (out.size() - headerPos - sizeof(header) < recordsSize) {
+      header.flags = kBlockFlagLZ4;
+    } else {
+      // Didn't help, store it as is
+      out.resize(headerPos + sizeof(header));
+    }
+  }
+
+  if (header.flags == kBlockFlagNone) {
+    out.append(reinterpret_cast<const char*>(records), recordsSize);
+  }
+
+  header.storedSize = (uint32_t)(out.size() - headerPos - sizeof(header));
+  memcpy(&out[headerPos], &header, sizeof(header));
+}
+
+bool DecodeBlock(const BlockHeader& header, const uint8_t* stored, std::vector<uint8_t>& records_out)
+{
+  records_out.resize(header.rawSize);
+  if (header.flags & kBlockFlagLZ4) {
+    return DecompressLZ4(stored, header.storedSize, records_out.data(), records_out.size());
+  }
+
+  if (header.storedSize != header.rawSize) {
+    return false;
+  }
+  if (header.rawSize > 0) {
+    memcpy(records_out.data(), stored, header.rawSize);
+  }
+  return true;
+}
+
+} // end namespace DevLogBlockFormat
+} // end namespace Vector
+} // end namespace Anki
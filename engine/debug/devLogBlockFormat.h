@@ -0,0 +1,76 @@
+/**
+* File: devLogBlockFormat
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Block format for the raw message logs. Records (a uint32 total size, a uint32 timestamp and the packed
+*              message, same as the old unbatched logs) are written in batches, each preceded by a BlockHeader. The
+*              header holds the time range and size of the block, so a reader can step from header to header
+*              without decoding anything. Block payloads are optionally compressed using the LZ4 block format.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogBlockFormat_H_
+#define __Cozmo_Basestation_Debug_DevLogBlockFormat_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+namespace DevLogBlockFormat {
+
+// "DLB1" in a little endian file. Read as an old style record size this is far beyond any valid size, which is how
+// readers tell the two formats apart.
+static constexpr uint32_t kBlockMagic = 0x31424C44;
+
+// Each record starts with its total size (including these 8 bytes) and a timestamp
+static constexpr uint32_t kRecordHeaderSize = sizeof(uint32_t) * 2;
+
+// There is no exact limit on the largest size a message could be, so these are really rough sanity checks for readers
+static constexpr uint32_t kLargestReasonableRecordSize = 4 * 1024;
+static constexpr uint32_t kLargestReasonableBlockSize  = 16 * 1024 * 1024;
+
+enum BlockFlags : uint16_t {
+  kBlockFlagNone = 0,
+  kBlockFlagLZ4  = 1 << 0,
+};
+
+struct BlockHeader
+{
+  uint32_t magic              = kBlockMagic;
+  uint16_t flags              = kBlockFlagNone;
+  uint16_t reserved           = 0;
+  uint32_t numRecords         = 0;
+  uint32_t firstTimestamp_ms  = 0;
+  uint32_t lastTimestamp_ms   = 0;
+  uint32_t rawSize            = 0; // size of the records once decoded
+  uint32_t storedSize         = 0; // size of the payload following this header in the file
+};
+static_assert(sizeof(BlockHeader) == 28, "BlockHeader is written to disk as is, so it can't have padding");
+
+// Appends a header and the (possibly compressed) records to out. Compression is skipped if it doesn't save anything.
+void EncodeBlock(const uint8_t* records, size_t recordsSize,
+                 uint32_t numRecords, uint32_t firstTimestamp_ms, uint32_t lastTimestamp_ms,
+                 bool compress, std::string& out);
+
+// Decodes a payload stored with header into records_out. Returns false if the payload is corrupt.
+bool DecodeBlock(const BlockHeader& header, const uint8_t* stored, std::vector<uint8_t>& records_out);
+
+// LZ4 block format, without any framing. Compress appends to dst. Decompress needs the exact decompressed size and
+// returns false on malformed input.
+void CompressLZ4(const uint8_t* src, size_t srcSize, std::string& dst);
+bool DecompressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+} // end namespace DevLogBlockFormat
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogBlockFormat_H_
@@ -0,0 +1,383 @@
+/**
+* File: devLogMappedReader
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Random access reader for one raw message log directory
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#include "engine/debug/devLogMappedReader.h"
+#include "engine/debug/devLogBlockFormat.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // Old logs have no blocks, so their records are indexed in runs of this many
+  static constexpr size_t kBareRecordsPerEntry = 256;
+
+  // Maps the whole file read-only. The returned pointer unmaps it once the last reference goes away.
+  std::shared_ptr<const void> MapFile(const std::string& path, size_t& size_out)
+  {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat attrib{0};
+    if ((fstat(fd, &attrib) != 0) || (attrib.st_size <= 0)) {
+      close(fd);
+      return nullptr;
+    }
+
+    const size_t len = static_cast<size_t>(attrib.st_size);
+    void* data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after the fd is closed
+    close(fd);
+
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+
+    // Logs are mostly read front to back
+    madvise(data, len, MADV_SEQUENTIAL);
+
+    size_out = len;
+    return std::shared_ptr<const void>(data, [len](const void* ptr) {
+      munmap(const_cast<void*>(ptr), len);
+    });
+  }
+
+  inline bool RecordSizeMakesSense(uint32_t sizeInBytes, size_t bytesAvailable)
+  {
+    return (sizeInBytes > DevLogBlockFormat::kRecordHeaderSize) &&
+           (sizeInBytes <= DevLogBlockFormat::kLargestReasonableRecordSize) &&
+           (sizeInBytes <= bytesAvailable);
+  }
+}
+
+DevLogMappedReader::DevLogMappedReader(const std::string& directory)
+: _directory(directory)
+{
+}
+
+bool DevLogMappedReader::Init()
+{
+  _files.clear();
+  _index.clear();
+  _records = nullptr;
+  _recordsSize = 0;
+  _readPos = 0;
+  _entryIdx = 0;
+
+  if (!Util::FileUtils::DirectoryExists(_directory))
+  {
+    PRINT_NAMED_ERROR("DevLogMappedReader.Init.InvalidDirectory", "Directory %s not found", _directory.c_str());
+    return false;
+  }
+
+  // Same file discovery as DevLogReader: the rolling logger names files so that they sort in time order
+  auto fileList = Util::FileUtils::FilesInDirectory(_directory, true, "log");
+  std::sort(fileList.begin(), fileList.end());
+
+  for (const auto& path : fileList)
+  {
+    MappedFile file;
+    file.path = path;
+    file.mapping = MapFile(path, file.size);
+    if (file.mapping == nullptr)
+    {
+      PRINT_NAMED_WARNING("DevLogMappedReader.Init.MapFailed", "Could not map %s, skipping it", path.c_str());
+      continue;
+    }
+
+    _files.push_back(std::move(file));
+    IndexFile(_files.size() - 1);
+  }
+
+  if (_index.empty())
+  {
+    return false;
+  }
+
+  if (!LoadEntry(0))
+  {
+    // Reading will skip past it
+    PRINT_NAMED_WARNING("DevLogMappedReader.Init.CorruptEntry", "First records in %s are corrupt", _directory.c_str());
+  }
+  return true;
+}
+
+bool DevLogMappedReader::IndexFile(size_t fileIdx)
+{
+  using namespace DevLogBlockFormat;
+
+  const MappedFile& file = _files[fileIdx];
+  const uint8_t* data = file.GetData();
+  const size_t size = file.size;
+
+  size_t pos = 0;
+  while (pos + sizeof(uint32_t) <= size)
+  {
+    uint32_t firstWord = 0;
+    memcpy(&firstWord, data + pos, sizeof(firstWord));
+
+    if (firstWord == kBlockMagic)
+    {
+      // The block header already has everything the index needs, so the payload isn't even touched
+      BlockHeader header;
+      if (pos + sizeof(header) > size)
+      {
+        PRINT_NAMED_WARNING("DevLogMappedReader.IndexFile.TruncatedBlock", "%s", file.path.c_str());
+        return false;
+      }
+      memcpy(&header, data + pos, sizeof(header));
+
+      const size_t blockSize = sizeof(header) + header.storedSize;
+      const bool sizeMakesSense = (header.rawSize <= kLargestReasonableBlockSize) &&
+                                  (header.storedSize <= kLargestReasonableBlockSize) &&
+                                  (pos + blockSize <= size);
+      if (!sizeMakesSense)
+      {
+        PRINT_NAMED_WARNING("DevLogMappedReader.IndexFile.InvalidBlock", "%s at offset %zu", file.path.c_str(), pos);
+        return false;
+      }
+
+      if (header.numRecords > 0)
+      {
+        IndexEntry entry;
+        entry.firstTimestamp_ms = header.firstTimestamp_ms;
+        entry.lastTimestamp_ms = header.lastTimestamp_ms;
+        entry.fileIdx = fileIdx;
+        entry.offset = pos;
+        entry.size = blockSize;
+        entry.isBlock = true;
+        _index.push_back(entry);
+      }
+      pos += blockSize;
+      continue;
+    }
+
+    // Bare records, from a log written before blocks existed
+    IndexEntry entry;
+    entry.fileIdx = fileIdx;
+    entry.offset = pos;
+    size_t numRecords = 0;
+    bool isCorrupt = false;
+    while ((numRecords < kBareRecordsPerEntry) && (pos + kRecordHeaderSize <= size))
+    {
+      uint32_t recordHeader[2];
+      memcpy(recordHeader, data + pos, sizeof(recordHeader));
+      if (recordHeader[0] == kBlockMagic)
+      {
+        break;
+      }
+      if (!RecordSizeMakesSense(recordHeader[0], size - pos))
+      {
+        isCorrupt = true;
+        break;
+      }
+
+      if (numRecords == 0)
+      {
+        entry.firstTimestamp_ms = recordHeader[1];
+      }
+      entry.lastTimestamp_ms = recordHeader[1];
+      pos += recordHeader[0];
+      ++numRecords;
+    }
+
+    if (numRecords > 0)
+    {
+      entry.size = pos - entry.offset;
+      _index.push_back(entry);
+    }
+
+    if (isCorrupt)
+    {
+      PRINT_NAMED_WARNING("DevLogMappedReader.IndexFile.InvalidRecord", "%s at offset %zu", file.path.c_str(), pos);
+      return false;
+    }
+
+    if (numRecords == 0)
+    {
+      // Fewer bytes left than a record header, e.g. the log was cut off mid-write
+      PRINT_NAMED_WARNING("DevLogMappedReader.IndexFile.TruncatedRecord", "%s at offset %zu", file.path.c_str(), pos);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool DevLogMappedReader::LoadEntry(size_t entryIdx)
+{
+  using namespace DevLogBlockFormat;
+
+  _entryIdx = entryIdx;
+  _readPos = 0;
+  _records = nullptr;
+  _recordsSize = 0;
+
+  const IndexEntry& entry = _index[entryIdx];
+  const uint8_t* start = _files[entry.fileIdx].GetData() + entry.offset;
+
+  if (!entry.isBlock)
+  {
+    _records = start;
+    _recordsSize = entry.size;
+    return true;
+  }
+
+  BlockHeader header;
+  memcpy(&header, start, sizeof(header));
+  const uint8_t* stored = start + sizeof(header);
+
+  if (header.flags == kBlockFlagNone)
+  {
+    // Uncompressed blocks are read straight out of the mapping
+    if (header.storedSize != header.rawSize)
+    {
+      return false;
+    }
+    _records = stored;
+    _recordsSize = header.rawSize;
+    return true;
+  }
+
+  if (!DecodeBlock(header, stored, _decodedBlock))
+  {
+    return false;
+  }
+  _records = _decodedBlock.data();
+  _recordsSize = _decodedBlock.size();
+  return true;
+}
+
+bool DevLogMappedReader::EnsureRecordAvailable()
+{
+  while (_readPos >= _recordsSize)
+  {
+    if (_entryIdx + 1 >= _index.size())
+    {
+      return false;
+    }
+    if (!LoadEntry(_entryIdx + 1))
+    {
+      PRINT_NAMED_WARNING("DevLogMappedReader.EnsureRecordAvailable.CorruptEntry",
+                          "Skipping records from %u to %u ms",
+                          _index[_entryIdx].firstTimestamp_ms, _index[_entryIdx].lastTimestamp_ms);
+    }
+  }
+  return true;
+}
+
+bool DevLogMappedReader::PeekNextTime(uint32_t& time_ms_out)
+{
+  while (EnsureRecordAvailable())
+  {
+    uint32_t recordHeader[2] = {0, 0};
+    const size_t remaining = _recordsSize - _readPos;
+    if (remaining >= sizeof(recordHeader))
+    {
+      memcpy(recordHeader, _records + _readPos, sizeof(recordHeader));
+    }
+    if (RecordSizeMakesSense(recordHeader[0], remaining))
+    {
+      time_ms_out = recordHeader[1];
+      return true;
+    }
+
+    // Give up on the rest of this entry, its record sizes can't be trusted
+    PRINT_NAMED_WARNING("DevLogMappedReader.PeekNextTime.InvalidRecord",
+                        "Skipping the rest of the records up to %u ms", _index[_entryIdx].lastTimestamp_ms);
+    _readPos = _recordsSize;
+  }
+  return false;
+}
+
+bool DevLogMappedReader::ReadNext(Record& record_out)
+{
+  uint32_t timestamp_ms = 0;
+  if (!PeekNextTime(timestamp_ms))
+  {
+    return false;
+  }
+
+  // PeekNextTime has checked the size
+  uint32_t sizeInBytes = 0;
+  memcpy(&sizeInBytes, _records + _readPos, sizeof(sizeInBytes));
+
+  record_out.timestamp_ms = timestamp_ms;
+  record_out.data = _records + _readPos + DevLogBlockFormat::kRecordHeaderSize;
+  record_out.size = sizeInBytes - DevLogBlockFormat::kRecordHeaderSize;
+  _readPos += sizeInBytes;
+  return true;
+}
+
+bool DevLogMappedReader::SeekToTime(uint32_t time_ms)
+{
+  if (_index.empty())
+  {
+    return false;
+  }
+
+  // Timestamps only ever increase through a log, so the entries are sorted by time too
+  const auto it = std::partition_point(_index.begin(), _index.end(), [time_ms](const IndexEntry& entry) {
+    return entry.lastTimestamp_ms < time_ms;
+  });
+
+  if (it == _index.end())
+  {
+    // Past the end, so leave the reader there
+    LoadEntry(_index.size() - 1);
+    _readPos = _recordsSize;
+    return false;
+  }
+
+  if (!LoadEntry(static_cast<size_t>(it - _index.begin())))
+  {
+    PRINT_NAMED_WARNING("DevLogMappedReader.SeekToTime.CorruptEntry", "Seeking past records from %u to %u ms",
+                        it->firstTimestamp_ms, it->lastTimestamp_ms);
+  }
+
+  // The entry holds at most one block worth of records, so a scan is fine from here
+  uint32_t nextTime_ms = 0;
+  Record record;
+  while (PeekNextTime(nextTime_ms))
+  {
+    if (nextTime_ms >= time_ms)
+    {
+      return true;
+    }
+    ReadNext(record);
+  }
+  return false;
+}
+
+uint32_t DevLogMappedReader::GetFirstTime_ms() const
+{
+  return _index.empty() ? 0 : _index.front().firstTimestamp_ms;
+}
+
+uint32_t DevLogMappedReader::GetFinalTime_ms() const
+{
+  return _index.empty() ? 0 : _index.back().lastTimestamp_ms;
+}
+
+} // end namespace Vector
+} // end namespace Anki
@@ -0,0 +1,110 @@
+/**
+* File: devLogMappedReader
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Random access reader for one raw message log directory (e.g. robotToEngine). All the log files are
+*              memory mapped and indexed by timestamp up front, so seeking is a binary search plus a scan of at most
+*              one block, and reading hands out pointers into the mapping instead of copying. Reads both the block
+*              format and older logs of bare records. Unlike DevLogReader this doesn't keep a playback clock; callers
+*              pull records as fast as they like.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogMappedReader_H_
+#define __Cozmo_Basestation_Debug_DevLogMappedReader_H_
+
+#include "util/helpers/noncopyable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class DevLogMappedReader : Util::noncopyable {
+public:
+  explicit DevLogMappedReader(const std::string& directory);
+
+  const std::string& GetDirectoryName() const { return _directory; }
+
+  // Maps and indexes every log file in the directory, and positions the reader at the start.
+  // Returns false if there is nothing to read.
+  bool Init();
+
+  // Time range covered by the log
+  uint32_t GetFirstTime_ms() const;
+  uint32_t GetFinalTime_ms() const;
+
+  size_t GetNumIndexEntries() const { return _index.size(); }
+
+  struct Record
+  {
+    uint32_t       timestamp_ms = 0;
+    const uint8_t* data         = nullptr; // valid until the next call that moves the reader
+    size_t         size         = 0;
+  };
+
+  // Positions the reader at the first record with a timestamp of time_ms or later. Returns false if there isn't one.
+  bool SeekToTime(uint32_t time_ms);
+
+  // Reads the record at the current position and moves past it. Returns false at the end of the log. Corrupt blocks
+  // are skipped with a warning.
+  bool ReadNext(Record& record_out);
+
+  // Timestamp of the record ReadNext would return, without moving. Returns false at the end of the log.
+  bool PeekNextTime(uint32_t& time_ms_out);
+
+private:
+  // A contiguous run of records: either one block, or (for old logs) a fixed number of bare records
+  struct IndexEntry
+  {
+    uint32_t firstTimestamp_ms = 0;
+    uint32_t lastTimestamp_ms  = 0;
+    size_t   fileIdx           = 0;
+    size_t   offset            = 0;  // of the block header, or of the first bare record
+    size_t   size              = 0;  // bytes in the file, including any block header
+    bool     isBlock           = false;
+  };
+
+  struct MappedFile
+  {
+    std::string                 path;
+    std::shared_ptr<const void> mapping;
+    size_t                      size = 0;
+
+    const uint8_t* GetData() const { return static_cast<const uint8_t*>(mapping.get()); }
+  };
+
+  std::string             _directory;
+  std::vector<MappedFile> _files;
+  std::vector<IndexEntry> _index;
+
+  // Current position: an index entry and an offset into its records
+  size_t         _entryIdx = 0;
+  size_t         _readPos  = 0;
+  const uint8_t* _records  = nullptr;
+  size_t         _recordsSize = 0;
+
+  // Decoded records of the current entry, if it's a compressed block
+  std::vector<uint8_t> _decodedBlock;
+
+  bool IndexFile(size_t fileIdx);
+
+  // Makes entryIdx current, decoding it if needed. Returns false if it's corrupt.
+  bool LoadEntry(size_t entryIdx);
+
+  // Loads the next entry once the current one is used up. Returns false at the end of the log.
+  bool EnsureRecordAvailable();
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogMappedReader_H_
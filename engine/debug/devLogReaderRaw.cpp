@@ -10,50 +10,141 @@
 *
 */
 #include "engine/debug/devLogReaderRaw.h"
+#include "engine/debug/devLogBlockFormat.h"
 #include "util/logging/logging.h"
 
+#include <cstring>
+
 namespace Anki {
 namespace Vector {
   
+namespace {
+  static constexpr uint32_t kMetaDataSize = DevLogBlockFormat::kRecordHeaderSize;
+  static constexpr uint32_t kLargestReasonableDataSize = DevLogBlockFormat::kLargestReasonableRecordSize;
+  static constexpr uint32_t kLargestReasonableBlockSize = DevLogBlockFormat::kLargestReasonableBlockSize;
+}
+
 bool DevLogReaderRaw::FillLogData(std::ifstream& fileHandle, LogData& logData_out) const
 {
-  uint32_t sizeInBytes = 0;
-  fileHandle.read(reinterpret_cast<char*>(&sizeInBytes), sizeof(sizeInBytes));
+  // Blocks can technically be empty, so keep going until there's a record
+  while (_blockReadPos >= _blockRecords.size())
+  {
+    uint32_t sizeInBytes = 0;
+    fileHandle.read(reinterpret_cast<char*>(&sizeInBytes), sizeof(sizeInBytes));
+    if (!fileHandle.good())
+    {
+      return false;
+    }
+    
+    if (sizeInBytes == DevLogBlockFormat::kBlockMagic)
+    {
+      if (!ReadBlock(fileHandle))
+      {
+        return false;
+      }
+      continue;
+    }
+    
+    // Not a block, so this is a log written before blocks existed, with records one after another
+    
+    // Verify the size makes sense
+    bool sizeMakesSense = (sizeInBytes > kMetaDataSize) && (sizeInBytes <= kLargestReasonableDataSize);
+    DEV_ASSERT(sizeMakesSense, "DevLogReaderRaw.FillLogData.InvalidSize");
+    if (!sizeMakesSense)
+    {
+      // This indicates there's some problem with the data, so bail on this file
+      return false;
+    }
+    
+    // After reading the size try to read in the timestamp
+    fileHandle.read(reinterpret_cast<char*>(&logData_out._timestamp_ms), sizeof(logData_out._timestamp_ms));
+    if (!fileHandle.good())
+    {
+      return false;
+    }
+    
+    // Update our size to remove the metadata so we can copy the right number of bytes remaining
+    sizeInBytes -= kMetaDataSize;
+    
+    logData_out._data.resize(sizeInBytes);
+    fileHandle.read(reinterpret_cast<char*>(logData_out._data.data()), sizeInBytes);
+    if (!fileHandle.good())
+    {
+      return false;
+    }
+    
+    return true;
+  }
+  
+  return FillLogDataFromBlock(logData_out);
+}
+
+bool DevLogReaderRaw::ReadBlock(std::ifstream& fileHandle) const
+{
+  // The magic has already been read
+  DevLogBlockFormat::BlockHeader header;
+  const size_t kMagicSize = sizeof(header.magic);
+  fileHandle.read(reinterpret_cast<char*>(&header) + kMagicSize, sizeof(header) - kMagicSize);
   if (!fileHandle.good())
   {
     return false;
   }
   
-  static constexpr uint32_t metaDataSize = sizeof(sizeInBytes) + sizeof(logData_out._timestamp_ms);
-  // There is no exact limit on the largest size a message could be, so this is a really a rough sanity check
-  static constexpr uint32_t kLargestReasonableDataSize = 4 * 1024;
-  
-  // Verify the size makes sense
-  bool sizeMakesSense = (sizeInBytes > metaDataSize) && (sizeInBytes <= kLargestReasonableDataSize);
-  DEV_ASSERT(sizeMakesSense, "DevLogReaderRaw.FillLogData.InvalidSize");
+  const bool sizeMakesSense = (header.rawSize <= kLargestReasonableBlockSize) &&
+                              (header.storedSize <= kLargestReasonableBlockSize);
+  DEV_ASSERT(sizeMakesSense, "DevLogReaderRaw.ReadBlock.InvalidSize");
   if (!sizeMakesSense)
   {
-    // This indicates there's some problem with the data, so bail on this file
     return false;
   }
   
-  // After reading the size try to read in the timestamp
-  fileHandle.read(reinterpret_cast<char*>(&logData_out._timestamp_ms), sizeof(logData_out._timestamp_ms));
+  std::vector<uint8_t> stored(header.storedSize);
+  fileHandle.read(reinterpret_cast<char*>(stored.data()), stored.size());
   if (!fileHandle.good())
   {
     return false;
   }
   
-  // Update our size to remove the metadata so we can copy the right number of bytes remaining
-  sizeInBytes -= metaDataSize;
+  _blockReadPos = 0;
+  if (!DevLogBlockFormat::DecodeBlock(header, stored.data(), _blockRecords))
+  {
+    PRINT_NAMED_WARNING("DevLogReaderRaw.ReadBlock.Corrupt",
+                        "Could not decode block of %u records starting at %u ms",
+                        header.numRecords, header.firstTimestamp_ms);
+    _blockRecords.clear();
+    return false;
+  }
+  
+  return true;
+}
+
+bool DevLogReaderRaw::FillLogDataFromBlock(LogData& logData_out) const
+{
+  const size_t remaining = _blockRecords.size() - _blockReadPos;
+  const uint8_t* record = _blockRecords.data() + _blockReadPos;
+  
+  uint32_t recordHeader[2] = {0, 0};
+  if (remaining >= sizeof(recordHeader))
+  {
+    memcpy(recordHeader, record, sizeof(recordHeader));
+  }
+  const uint32_t sizeInBytes = recordHeader[0];
   
-  logData_out._data.resize(sizeInBytes);
-  fileHandle.read(reinterpret_cast<char*>(logData_out._data.data()), sizeInBytes);
-  if (!fileHandle.good())
+  const bool sizeMakesSense = (sizeInBytes > kMetaDataSize) && (sizeInBytes <= kLargestReasonableDataSize) &&
+                              (sizeInBytes <= remaining);
+  DEV_ASSERT(sizeMakesSense, "DevLogReaderRaw.FillLogDataFromBlock.InvalidSize");
+  if (!sizeMakesSense)
   {
+    // Like with bare records, a bad size means the data is broken, so bail on this file
+    _blockRecords.clear();
+    _blockReadPos = 0;
     return false;
   }
   
+  logData_out._timestamp_ms = recordHeader[1];
+  logData_out._data.assign(record + kMetaDataSize, record + sizeInBytes);
+  _blockReadPos += sizeInBytes;
+  
   return true;
 }
 
@@ -22,9 +22,19 @@ public:
   using DevLogReader::DevLogReader;
   
 protected:
-  // Extract next chunk of data out of the current file handle
+  // Extract next chunk of data out of the current file handle. Reads both the block format (see
+  // devLogBlockFormat.h) and older logs made of bare records.
   // Returns success
   virtual bool FillLogData(std::ifstream& fileHandle, LogData& logData_out) const override;
+
+private:
+  // Decoded records of the block currently being read, and how far into them we are. Blocks never span files, so
+  // this is always used up by the time the file ends.
+  mutable std::vector<uint8_t> _blockRecords;
+  mutable size_t               _blockReadPos = 0;
+
+  bool ReadBlock(std::ifstream& fileHandle) const;
+  bool FillLogDataFromBlock(LogData& logData_out) const;
 };
 
 } // end namespace Vector
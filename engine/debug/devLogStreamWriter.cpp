@@ -0,0 +1,126 @@
+/**
+* File: devLogStreamWriter
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Batched writer for one stream of raw message logs
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#include "engine/debug/devLogStreamWriter.h"
+
+#include "util/console/consoleInterface.h"
+#include "util/dispatchQueue/dispatchQueue.h"
+#include "util/logging/rollingFileLogger.h"
+
+#include <thread>
+
+namespace Anki {
+namespace Vector {
+
+// LZ4 compress blocks before writing them. Usually shrinks the logs several times over for little CPU, on the
+// logging queue rather than the engine thread.
+CONSOLE_VAR(bool, kDevLogCompressBlocks, "DevLogging", true);
+
+// Blocks are written out once they hold this much, or once their first message is older than
+// kDevLogMaxBlockAge_ms. Bigger blocks mean fewer, larger writes to flash.
+CONSOLE_VAR_RANGED(uint32_t, kDevLogBlockSize_KB, "DevLogging", 64, 4, 1024);
+CONSOLE_VAR_RANGED(uint32_t, kDevLogMaxBlockAge_ms, "DevLogging", 2000, 0, 60000);
+
+DevLogStreamWriter::DevLogStreamWriter(Util::Dispatch::Queue* queue, const std::string& baseDirectory)
+: _queue(queue)
+, _log(new Util::RollingFileLogger(queue, baseDirectory))
+{
+}
+
+DevLogStreamWriter::~DevLogStreamWriter()
+{
+  // By now the queue has been stopped (see ~DevLoggingSystem), so nothing else can touch the spare
+  delete _spareBlock.exchange(nullptr);
+}
+
+void DevLogStreamWriter::Lock()
+{
+  while (_appending.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+}
+
+void DevLogStreamWriter::Flush()
+{
+  Lock();
+  if (_activeBlock && (_activeBlock->numRecords > 0)) {
+    HandOffActiveBlock();
+  }
+  Unlock();
+}
+
+void DevLogStreamWriter::FlushIfOld(uint32_t now_ms)
+{
+  Lock();
+  if (_activeBlock && (_activeBlock->numRecords > 0) && IsActiveBlockOld(now_ms)) {
+    HandOffActiveBlock();
+  }
+  Unlock();
+}
+
+bool DevLogStreamWriter::IsActiveBlockOld(uint32_t now_ms) const
+{
+  return (now_ms - _activeBlock->firstTimestamp_ms) >= kDevLogMaxBlockAge_ms;
+}
+
+uint8_t* DevLogStreamWriter::Reserve(size_t numBytes, uint32_t timestamp_ms)
+{
+  if (_activeBlock && (_activeBlock->numRecords > 0)) {
+    const bool isFull = (_activeBlock->records.size() + numBytes) > (kDevLogBlockSize_KB * 1024);
+    if (isFull || IsActiveBlockOld(timestamp_ms)) {
+      HandOffActiveBlock();
+    }
+  }
+
+  if (!_activeBlock) {
+    _activeBlock.reset(_spareBlock.exchange(nullptr, std::memory_order_acquire));
+    if (!_activeBlock) {
+      _activeBlock.reset(new Block);
+      _activeBlock->records.reserve(kDevLogBlockSize_KB * 1024);
+    }
+  }
+
+  Block& block = *_activeBlock;
+  if (block.numRecords == 0) {
+    block.firstTimestamp_ms = timestamp_ms;
+  }
+  block.lastTimestamp_ms = timestamp_ms;
+  ++block.numRecords;
+
+  const size_t offset = block.records.size();
+  block.records.resize(offset + numBytes);
+  return block.records.data() + offset;
+}
+
+void DevLogStreamWriter::HandOffActiveBlock()
+{
+  Block* block = _activeBlock.release();
+  Util::Dispatch::Async(_queue, [this, block] {
+    WriteBlock(block);
+  });
+}
+
+void DevLogStreamWriter::WriteBlock(Block* block)
+{
+  _encodedBlock.clear();
+  DevLogBlockFormat::EncodeBlock(block->records.data(), block->records.size(),
+                                 block->numRecords, block->firstTimestamp_ms, block->lastTimestamp_ms,
+                                 kDevLogCompressBlocks, _encodedBlock);
+  _log->Write(_encodedBlock);
+
+  // Give the buffer back for reuse. If the logging thread hasn't taken the last one yet, there's no need for two.
+  block->records.clear();
+  block->numRecords = 0;
+  delete _spareBlock.exchange(block, std::memory_order_release);
+}
+
+} // end namespace Vector
+} // end namespace Anki
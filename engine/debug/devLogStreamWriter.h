@@ -0,0 +1,117 @@
+/**
+* File: devLogStreamWriter
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Batched writer for one stream of raw message logs. Messages are packed straight into an in-memory block
+*              on the logging thread; full (or old enough) blocks are handed to the dev logging queue, which encodes
+*              them (see devLogBlockFormat.h) and writes them out through a RollingFileLogger. Logging a message
+*              never allocates or touches the disk.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogStreamWriter_H_
+#define __Cozmo_Basestation_Debug_DevLogStreamWriter_H_
+
+#include "engine/debug/devLogBlockFormat.h"
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations
+namespace Anki {
+  namespace Util {
+    class RollingFileLogger;
+    namespace Dispatch {
+      class Queue;
+    }
+  }
+}
+
+namespace Anki {
+namespace Vector {
+
+class DevLogStreamWriter : Util::noncopyable {
+public:
+  DevLogStreamWriter(Util::Dispatch::Queue* queue, const std::string& baseDirectory);
+  ~DevLogStreamWriter();
+
+  // Appends one record holding the packed message. Safe from any thread, though each stream is normally only logged
+  // from the engine thread, in which case this never waits.
+  template<typename MsgType>
+  void Append(uint32_t timestamp_ms, const MsgType& message);
+
+  // Hands off whatever has been appended so far, even if the block isn't full
+  void Flush();
+
+  // Hands off the active block if its first message is too old by now. Otherwise a stream that goes quiet would hold
+  // on to its last messages until the next one arrives.
+  void FlushIfOld(uint32_t now_ms);
+
+private:
+  struct Block {
+    std::vector<uint8_t> records;
+    uint32_t numRecords        = 0;
+    uint32_t firstTimestamp_ms = 0;
+    uint32_t lastTimestamp_ms  = 0;
+  };
+
+  Util::Dispatch::Queue*                   _queue;
+  std::unique_ptr<Util::RollingFileLogger> _log;
+
+  // Only touched while _appending is held
+  std::unique_ptr<Block> _activeBlock;
+
+  // A written block handed back by the queue, so steady state logging reuses the same two buffers
+  std::atomic<Block*> _spareBlock{nullptr};
+
+  // Guards _activeBlock against a second logging thread. Uncontended in practice.
+  std::atomic_flag _appending = ATOMIC_FLAG_INIT;
+
+  // Only used on the queue
+  std::string _encodedBlock;
+
+  void Lock();
+  void Unlock() { _appending.clear(std::memory_order_release); }
+
+  // Returns space for numBytes at the end of the active block, handing the block off first if it's full or holds
+  // messages from too long ago. Must be called with the lock held.
+  uint8_t* Reserve(size_t numBytes, uint32_t timestamp_ms);
+
+  // Must be called with the lock held
+  bool IsActiveBlockOld(uint32_t now_ms) const;
+
+  // Must be called with the lock held
+  void HandOffActiveBlock();
+
+  // Called on the queue
+  void WriteBlock(Block* block);
+};
+
+template<typename MsgType>
+void DevLogStreamWriter::Append(uint32_t timestamp_ms, const MsgType& message)
+{
+  const size_t messageSize = message.Size();
+  const size_t totalSize = messageSize + DevLogBlockFormat::kRecordHeaderSize;
+
+  Lock();
+  uint8_t* data = Reserve(totalSize, timestamp_ms);
+
+  // Same layout as the old unbatched logs: total size, then the timestamp, then the message
+  const uint32_t header[2] = { static_cast<uint32_t>(totalSize), timestamp_ms };
+  memcpy(data, header, sizeof(header));
+  message.Pack(data + sizeof(header), messageSize);
+  Unlock();
+}
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogStreamWriter_H_
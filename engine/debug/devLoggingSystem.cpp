@@ -11,6 +11,7 @@
 */
 #include "engine/debug/devLoggingSystem.h"
 #include "engine/debug/devLoggerProvider.h"
+#include "engine/debug/devLogStreamWriter.h"
 #include "engine/util/file/archiveUtil.h"
 #include "coretech/common/engine/jsonTools.h"
 #include "clad/externalInterface/messageEngineToGame.h"
@@ -103,11 +104,11 @@ DevLoggingSystem::DevLoggingSystem(const std::string& baseDirectory, const std::
   ArchiveDirectories(_allLogsBaseDirectory, {appRunTimeString} );
   
   _devLoggingBaseDirectory = Util::FileUtils::FullFilePath({_allLogsBaseDirectory, appRunTimeString});
-  _gameToEngineLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kGameToEngineName})));
-  _engineToGameLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToGameName})));
-  _robotToEngineLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kRobotToEngineName})));
-  _engineToRobotLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToRobogName})));
-  _engineToVizLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToVizName})));
+  _gameToEngineLog.reset(new DevLogStreamWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kGameToEngineName})));
+  _engineToGameLog.reset(new DevLogStreamWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToGameName})));
+  _robotToEngineLog.reset(new DevLogStreamWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kRobotToEngineName})));
+  _engineToRobotLog.reset(new DevLogStreamWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToRobogName})));
+  _engineToVizLog.reset(new DevLogStreamWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToVizName})));
 
   // write apprun file
   CreateAppRunFile(appRunTimeString, appRunId);
@@ -269,35 +270,33 @@ void DevLoggingSystem::DeleteLog(const std::string& archiveFilename) const
 
 DevLoggingSystem::~DevLoggingSystem()
 {
+  // Write out the partial blocks before the queue goes away
+  for (auto* log : {_gameToEngineLog.get(), _engineToGameLog.get(), _robotToEngineLog.get(),
+                    _engineToRobotLog.get(), _engineToVizLog.get()})
+  {
+    if (log != nullptr)
+    {
+      log->Flush();
+    }
+  }
+
   Util::Dispatch::Stop(_queue);
   Util::Dispatch::Release(_queue);
 }
 
-template<typename MsgType>
-std::string DevLoggingSystem::PrepareMessage(const MsgType& message) const
+void DevLoggingSystem::Update()
 {
-  // We want to repackage the clad messages with some extra information at the start
-  // We'll add 4 bytes to hold the size and another 4 for the timestamp
-  static const std::size_t extraSize = sizeof(uint32_t) * 2;
-  const std::size_t messageSize = message.Size();
-  const std::size_t totalSize = messageSize + extraSize;
-  std::vector<uint8_t> messageVector(totalSize);
-  
-  uint8_t* data = messageVector.data();
-  
-  // First write in the size
-  *((uint32_t*)data) = static_cast<uint32_t>(totalSize);
-  data += sizeof(uint32_t);
-  
-  // Then write in the timestamp as a millisecond count since the app started running
-  *((uint32_t*)data) = GetAppRunMilliseconds();
-  data += sizeof(uint32_t);
-  
-  message.Pack(data, messageSize);
-  
-  return std::string(reinterpret_cast<char*>(messageVector.data()), totalSize);
+  const uint32_t now_ms = GetAppRunMilliseconds();
+  for (auto* log : {_gameToEngineLog.get(), _engineToGameLog.get(), _robotToEngineLog.get(),
+                    _engineToRobotLog.get(), _engineToVizLog.get()})
+  {
+    if (log != nullptr)
+    {
+      log->FlushIfOld(now_ms);
+    }
+  }
 }
-  
+
 uint32_t DevLoggingSystem::GetAppRunMilliseconds()
 {
   return Util::numeric_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(DevLoggingClock::now() - kAppRunStartTime).count());
@@ -315,7 +314,7 @@ void DevLoggingSystem::LogMessage(const ExternalInterface::MessageEngineToGame&
   }
 
   ANKI_CPU_PROFILE("LogMessage_EToG");
-  _engineToGameLog->Write(PrepareMessage(message));
+  _engineToGameLog->Append(GetAppRunMilliseconds(), message);
 }
   
 template<>
@@ -328,14 +327,14 @@ void DevLoggingSystem::LogMessage(const ExternalInterface::MessageGameToEngine&
   }
   
   ANKI_CPU_PROFILE("LogMessage_GToE");
-  _gameToEngineLog->Write(PrepareMessage(message));
+  _gameToEngineLog->Append(GetAppRunMilliseconds(), message);
 }
 
 template<>
 void DevLoggingSystem::LogMessage(const RobotInterface::EngineToRobot& message)
 {
   ANKI_CPU_PROFILE("LogMessage_EToR");
-  _engineToRobotLog->Write(PrepareMessage(message));
+  _engineToRobotLog->Append(GetAppRunMilliseconds(), message);
 }
 
 template<>
@@ -348,7 +347,7 @@ void DevLoggingSystem::LogMessage(const RobotInterface::RobotToEngine& message)
   }
   
   ANKI_CPU_PROFILE("LogMessage_RToE");
-  _robotToEngineLog->Write(PrepareMessage(message));
+  _robotToEngineLog->Append(GetAppRunMilliseconds(), message);
 }
     
 template<>
@@ -364,7 +363,7 @@ void DevLoggingSystem::LogMessage(const VizInterface::MessageViz& message)
   }
     
   ANKI_CPU_PROFILE("LogMessage_Viz");
-  _engineToVizLog->Write(PrepareMessage(message));
+  _engineToVizLog->Append(GetAppRunMilliseconds(), message);
 }
 
 } // end namespace Vector
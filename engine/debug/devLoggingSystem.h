@@ -27,6 +27,9 @@ namespace Anki {
   namespace Util {
     class ILoggerProvider;
   }
+  namespace Vector {
+    class DevLogStreamWriter;
+  }
 }
 
 namespace Anki {
@@ -50,6 +53,9 @@ public:
   
   template<typename MsgType>
   void LogMessage(const MsgType& message);
+
+  // Writes out partially filled blocks once they get too old, for streams that have gone quiet. Call regularly.
+  void Update();
   
   const std::string& GetDevLoggingBaseDirectory() const { return _devLoggingBaseDirectory; }
   
@@ -84,11 +90,11 @@ private:
   static const std::string kLogFileExtension;
 
   Util::Dispatch::Queue*                      _queue;
-  std::unique_ptr<Util::RollingFileLogger>    _gameToEngineLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToGameLog;
-  std::unique_ptr<Util::RollingFileLogger>    _robotToEngineLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToRobotLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToVizLog;
+  std::unique_ptr<DevLogStreamWriter>         _gameToEngineLog;
+  std::unique_ptr<DevLogStreamWriter>         _engineToGameLog;
+  std::unique_ptr<DevLogStreamWriter>         _robotToEngineLog;
+  std::unique_ptr<DevLogStreamWriter>         _engineToRobotLog;
+  std::unique_ptr<DevLogStreamWriter>         _engineToVizLog;
 
   std::string _allLogsBaseDirectory;
   std::string _devLoggingBaseDirectory;
@@ -101,9 +107,6 @@ private:
   void ArchiveDirectories(const std::string& baseDirectory, const std::vector<std::string>& excludeDirectories) const;
   static void ArchiveOneDirectory(const std::string& baseDirectory);
 
-  template<typename MsgType>
-  std::string PrepareMessage(const MsgType& message) const;
-  
   void CreateAppRunFile(const std::string& appRunTimeString, const std::string& appRunId);
 };
 
@@ -15,6 +15,7 @@
 
 #include "memoryMap/memoryMapTypes.h"
 #include "memoryMap/data/memoryMapData.h"
+#include "coretech/common/engine/math/ball.h"
 #include "coretech/common/engine/math/pose.h"
 
 namespace Anki {
@@ -60,10 +61,28 @@ public:
   
   // multi-ray variant of the `AnyOf` method implementation may optimize for this case
   virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const = 0;
+
+  // multi-ray variant that only checks whether each ray crosses any node of the given content types. Cheaper than
+  // a predicate for large batches, since no callback is needed per node
+  virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, MemoryMapTypes::EContentTypePackedType types) const = 0;
+
+  // returns true if any node intersecting the ball is a collision type. Equivalent to calling `AnyOf` with
+  // IsCollisionType, but implementations may answer most queries without traversing the map
+  virtual bool AnyCollisionInBall(const Ball2f& ball) const = 0;
   
   // Pack map data to broadcast
   virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const = 0;
 
+  // Pack only the leaves that changed after sinceVersion (as returned by a previous snapshot or delta). Returns
+  // false if the map no longer knows about all those changes, in which case a full snapshot should be sent instead
+  virtual bool GetBroadcastDelta(uint32_t sinceVersion, MemoryMapTypes::MapBroadcastDelta& delta) const = 0;
+
+  // let the map forget about changes up to the given version, once they have been broadcast
+  virtual void TrimChangeJournal(uint32_t upToVersion) = 0;
+
+  // changes are only recorded for GetBroadcastDelta while enabled, so only enable it while deltas are being sent
+  virtual void SetChangeJournalEnabled(bool enabled) = 0;
+
   // populate a list of all data that matches the predicate inside region
   virtual void FindContentIf(const NodePredicate& pred, MemoryMapTypes::MemoryMapDataConstList& output, const MemoryMapRegion& region = RealNumbers2f()) const = 0;
   
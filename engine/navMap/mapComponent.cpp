@@ -61,6 +61,10 @@ namespace Vector {
 // how often we request redrawing maps. Added because I think clad is getting overloaded with the amount of quads
 CONSOLE_VAR(float, kMapRenderRate_sec, "MapComponent", 0.25f);
 
+// send only changed quads to viz between full maps, and how often to send a full map anyway (e.g. for late joiners)
+CONSOLE_VAR(bool,  kMapVizSendDeltas, "MapComponent", true);
+CONSOLE_VAR(float, kMapVizKeyframePeriod_sec, "MapComponent", 5.0f);
+
 // kObjectRotationChangeToReport_deg: if the rotation of an object changes by this much, memory map will be notified
 CONSOLE_VAR(float, kObjectRotationChangeToReport_deg, "MapComponent", 10.0f);
 // kObjectPositionChangeToReport_mm: if the position of an object changes by this much, memory map will be notified
@@ -278,6 +282,10 @@ MapComponent::MapComponent()
 , _vizMessageDirty(true)
 , _gameMessageDirty(true)
 , _webMessageDirty(false) // web must request it
+, _vizMapOriginID(PoseOriginList::UnknownOriginID)
+, _vizMapInfo()
+, _vizMapVersion(0)
+, _nextVizKeyframeTime_s(0.0f)
 , _isRenderEnabled(false)
 , _broadcastRate_sec(-1.0f)
 , _enableProxCollisions(true)
@@ -343,13 +351,22 @@ void MapComponent::UpdateDependent(const RobotCompMap& dependentComps)
     // Check if we should broadcast changes to navMap to different channels
     const f32 currentTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
 
-    const bool shouldSendViz = (ENABLE_DRAWING && _vizMessageDirty && _isRenderEnabled) || _webMessageDirty;
+    const bool shouldSendViz = ENABLE_DRAWING && _vizMessageDirty && _isRenderEnabled;
+
+    // viz is the only consumer of the change journal, so don't pay for it unless deltas are being sent
+    currentNavMemoryMap->SetChangeJournalEnabled(ENABLE_DRAWING && _isRenderEnabled && kMapVizSendDeltas);
     const bool shouldSendSDK = _gameMessageDirty && (_broadcastRate_sec >= 0.0f);
     
+    // only pack the full map if some channel actually needs it this tick
     MemoryMapTypes::MapBroadcastData data;
-    if( shouldSendViz || shouldSendSDK ) {
-      currentNavMemoryMap->GetBroadcastInfo(data);
-    }
+    bool hasData = false;
+    auto getData = [&]() -> const MemoryMapTypes::MapBroadcastData& {
+      if( !hasData ) {
+        currentNavMemoryMap->GetBroadcastInfo(data);
+        hasData = true;
+      }
+      return data;
+    };
 
     // send viz Messages
     if ( shouldSendViz )
@@ -357,18 +374,30 @@ void MapComponent::UpdateDependent(const RobotCompMap& dependentComps)
       static f32 nextDrawTime_s = currentTime_s;
       const bool doViz = FLT_LE(nextDrawTime_s, currentTime_s);
       if( doViz ) {
-        BroadcastMapToViz(data);
+        const bool needsKeyframe = !kMapVizSendDeltas ||
+                                   (_vizMapOriginID != _currentMapOriginID) ||
+                                   FLT_LE(_nextVizKeyframeTime_s, currentTime_s);
+        const bool sentDelta = !needsKeyframe && BroadcastMapDeltaToViz(*currentNavMemoryMap);
+        if( !sentDelta ) {
+          BroadcastMapToViz(getData());
+          _vizMapOriginID = _currentMapOriginID;
+          _vizMapInfo = data.mapInfo;
+          _vizMapVersion = data.version;
+          _nextVizKeyframeTime_s = currentTime_s + kMapVizKeyframePeriod_sec;
+        }
 
+        // viz is the only consumer of deltas
+        currentNavMemoryMap->TrimChangeJournal(_vizMapVersion);
 
         // Reset the timer but don't accumulate error
         nextDrawTime_s += ((int) (currentTime_s - nextDrawTime_s) / kMapRenderRate_sec + 1) * kMapRenderRate_sec;
         _vizMessageDirty = false;
       }
+    }
 
-      if( _webMessageDirty ) {
-        BroadcastMapToWeb(data);
-        _webMessageDirty = false;
-      }
+    if( _webMessageDirty ) {
+      BroadcastMapToWeb(getData());
+      _webMessageDirty = false;
     }
 
     // send SDK messages
@@ -376,7 +405,7 @@ void MapComponent::UpdateDependent(const RobotCompMap& dependentComps)
     {
       static f32 nextBroadcastTime_s = currentTime_s;
       if (FLT_LE(nextBroadcastTime_s, currentTime_s)) {
-        BroadcastMapToSDK(data);
+        BroadcastMapToSDK(getData());
 
         // Reset the timer but don't accumulate error
         nextBroadcastTime_s += ((int) (currentTime_s - nextBroadcastTime_s) / _broadcastRate_sec + 1) * _broadcastRate_sec;
@@ -727,8 +756,11 @@ namespace {
   const size_t kQuadsPerMessage = kMaxBufferForQuads / sizeof(QuadInfoVector::value_type);
   const size_t kFullQuadsPerMessage = kMaxBufferForQuads / sizeof(QuadInfoFullVector::value_type);
 
+  const size_t kFullQuadsPerDeltaMessage = (kMaxBufferForQuads - sizeof(bool)) / sizeof(QuadInfoFullVector::value_type);
+
   static_assert(kQuadsPerMessage > 0,     "MapComponent.Broadcast.InvalidQuadsPerMessage");
   static_assert(kFullQuadsPerMessage > 0, "MapComponent.Broadcast.InvalidFullQuadsPerMessage");
+  static_assert(kFullQuadsPerDeltaMessage > 0, "MapComponent.Broadcast.InvalidFullQuadsPerDeltaMessage");
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -751,6 +783,46 @@ void MapComponent::BroadcastMapToViz(const MapBroadcastData& mapData) const
   _robot->Broadcast(MessageViz(MemoryMapMessageVizEnd(_currentMapOriginID)));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MapComponent::BroadcastMapDeltaToViz(const INavMap& map)
+{
+  using namespace VizInterface;
+
+  MapBroadcastDelta delta;
+  if ( !map.GetBroadcastDelta(_vizMapVersion, delta) ) {
+    return false;
+  }
+
+  // if the root moved or grew, quads are no longer comparable to what viz has
+  const bool sameRoot = (delta.mapInfo.rootDepth   == _vizMapInfo.rootDepth) &&
+                        (delta.mapInfo.rootSize_mm == _vizMapInfo.rootSize_mm) &&
+                        (delta.mapInfo.rootCenterX == _vizMapInfo.rootCenterX) &&
+                        (delta.mapInfo.rootCenterY == _vizMapInfo.rootCenterY) &&
+                        (delta.mapInfo.identifier  == _vizMapInfo.identifier);
+  if ( !sameRoot ) {
+    return false;
+  }
+
+  // removals first, since a removed quad can be replaced by a changed one with the same geometry
+  auto sendChunks = [this](const QuadInfoFullVector& quads, bool isRemoval) {
+    for(u32 seqNum = 0; seqNum*kFullQuadsPerDeltaMessage < quads.size(); seqNum++)
+    {
+      auto start = seqNum*kFullQuadsPerDeltaMessage;
+      auto end   = std::min(quads.size(), start + kFullQuadsPerDeltaMessage);
+      _robot->Broadcast(MessageViz(MemoryMapMessageVizDelta(_currentMapOriginID, isRemoval,
+        QuadInfoFullVector(quads.begin() + start, quads.begin() + end))));
+    }
+  };
+  sendChunks(delta.removedQuads, true);
+  sendChunks(delta.changedQuads, false);
+
+  // Send the end message so viz redraws
+  _robot->Broadcast(MessageViz(MemoryMapMessageVizEnd(_currentMapOriginID)));
+
+  _vizMapVersion = delta.version;
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
 {
@@ -868,9 +940,10 @@ void MapComponent::ClearRender()
 {
   if(ENABLE_DRAWING)
   {
-    // set map as dirty
+    // set map as dirty, and make sure viz gets a full map next time
     _vizMessageDirty = true;
     _gameMessageDirty = true;
+    _vizMapOriginID = PoseOriginList::UnknownOriginID;
   }
 }
 
@@ -1374,6 +1447,16 @@ bool MapComponent::CheckForCollisions(const BoundedConvexSet2f& region) const
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MapComponent::CheckForCollisions(const Ball2f& region) const
+{
+  const auto currentMap = GetCurrentMemoryMap();
+  if (currentMap) {
+    return currentMap->AnyCollisionInBall( region );
+  }
+  return false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool MapComponent::CheckForCollisions(const BoundedConvexSet2f& region, const MemoryMapTypes::NodePredicate& pred) const
 {
@@ -1516,9 +1599,9 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
   */
 
 
-  NodePredicate isCollisionType = [] (const auto& data) { return (data->type == EContentType::ObstacleProx) ||
-                                                                 (data->type == EContentType::ObstacleObservable) ||
-                                                                 (data->type == EContentType::ObstacleUnrecognized); };
+  const MemoryMapTypes::EContentTypePackedType collisionTypes = EContentTypeToFlag(EContentType::ObstacleProx) |
+                                                                 EContentTypeToFlag(EContentType::ObstacleObservable) |
+                                                                 EContentTypeToFlag(EContentType::ObstacleUnrecognized);
 
   std::vector<Point2f> validPoints;
   std::vector<Point2f> imagePoints;
@@ -1539,7 +1622,7 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
       imagePoints.push_back(std::move(imagePtOnGround));
     }
   }
-  std::vector<bool> collisionCheckResults = currentMap->AnyOf(robotPose.GetTranslation(), imagePoints, isCollisionType);
+  std::vector<bool> collisionCheckResults = currentMap->AnyOf(robotPose.GetTranslation(), imagePoints, collisionTypes);
 
   validPoints.reserve(imagePoints.size());
   for(int i=0; i<imagePoints.size(); ++i) {
@@ -109,6 +109,9 @@ public:
   void BroadcastMapToViz(const MemoryMapTypes::MapBroadcastData& mapData) const;
   void BroadcastMapToWeb(const MemoryMapTypes::MapBroadcastData& mapData) const;
   void BroadcastMapToSDK(const MemoryMapTypes::MapBroadcastData& mapData) const;
+
+  // Publish only what changed since the last map sent to Viz. Returns false if a full map needs to be sent instead
+  bool BroadcastMapDeltaToViz(const INavMap& map);
   
   // clear the space in the memory map between the robot and observed markers for the given object,
   // because if we saw the marker, it means there's nothing between us and the marker.
@@ -127,6 +130,7 @@ public:
 
   // return true of the specified region contains any objects of known collision types
   bool CheckForCollisions(const BoundedConvexSet2f& region) const;
+  bool CheckForCollisions(const Ball2f& region) const;
   bool CheckForCollisions(const BoundedConvexSet2f& region, const MemoryMapTypes::NodePredicate& pred) const;
 
   // returns the accumulated area of cells in mm^2 in the current map that satisfy the predicate (and region, if supplied)
@@ -235,6 +239,12 @@ private:
   bool                            _gameMessageDirty;
   bool                            _webMessageDirty;
   
+  // last full map or delta sent to viz, so that following updates can be sent as deltas
+  PoseOriginID_t                    _vizMapOriginID;
+  ExternalInterface::MemoryMapInfo  _vizMapInfo;
+  uint32_t                          _vizMapVersion;
+  float                             _nextVizKeyframeTime_s;
+
   bool                            _isRenderEnabled;
   float                           _broadcastRate_sec = -1.0f;      // (Negative means don't send)
 
@@ -0,0 +1,258 @@
+/**
+ * File: collisionGrid.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: See header.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "engine/navMap/memoryMap/collisionGrid.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // shrink/grow quad bounds by this much before rasterizing, so exactly aligned edges don't touch extra cells
+  constexpr float kEdgeTolerance_mm = 1e-3f;
+
+  // a cell center can be up to half a cell diagonal from any point inside it
+  const float kCellDiagonal_cells = std::sqrt(2.f);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CollisionGrid::TileKey CollisionGrid::GetTileKey(int32_t tileX, int32_t tileY)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(tileX)) << 32) | static_cast<uint32_t>(tileY);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int32_t CollisionGrid::GetCellCoord(float x_mm)
+{
+  return static_cast<int32_t>(std::floor(x_mm / kCellSize_mm));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CollisionGrid::Clear()
+{
+  _occupancy.clear();
+  std::lock_guard<std::mutex> lock(_distanceMutex);
+  _distances.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CollisionGrid::UpdateCells(const AxisAlignedQuad& quad, int delta, bool updateCovered)
+{
+  const Point2f& minV = quad.GetMinVertex();
+  const Point2f& maxV = quad.GetMaxVertex();
+
+  // any cell overlapping the quad is "touched"
+  const int32_t minTouchedX = GetCellCoord(minV.x() + kEdgeTolerance_mm);
+  const int32_t minTouchedY = GetCellCoord(minV.y() + kEdgeTolerance_mm);
+  const int32_t maxTouchedX = GetCellCoord(maxV.x() - kEdgeTolerance_mm);
+  const int32_t maxTouchedY = GetCellCoord(maxV.y() - kEdgeTolerance_mm);
+
+  // only cells entirely inside the quad are "covered"
+  const int32_t minCoveredX = static_cast<int32_t>(std::ceil((minV.x() - kEdgeTolerance_mm) / kCellSize_mm));
+  const int32_t minCoveredY = static_cast<int32_t>(std::ceil((minV.y() - kEdgeTolerance_mm) / kCellSize_mm));
+  const int32_t maxCoveredX = GetCellCoord(maxV.x() + kEdgeTolerance_mm) - 1;
+  const int32_t maxCoveredY = GetCellCoord(maxV.y() + kEdgeTolerance_mm) - 1;
+
+  // walk tile by tile so we only look up each tile once
+  for (int32_t tileY = GetTileCoord(minTouchedY); tileY <= GetTileCoord(maxTouchedY); ++tileY)
+  {
+    for (int32_t tileX = GetTileCoord(minTouchedX); tileX <= GetTileCoord(maxTouchedX); ++tileX)
+    {
+      const TileKey key = GetTileKey(tileX, tileY);
+      auto tileIter = _occupancy.find(key);
+      if (tileIter == _occupancy.end()) {
+        if (delta < 0) {
+          LOG_ERROR("CollisionGrid.UpdateCells.MissingTile", "Removing quad from empty tile (%d, %d)", tileX, tileY);
+          continue;
+        }
+        tileIter = _occupancy.emplace(key, OccupancyTile()).first;
+      }
+      OccupancyTile& tile = tileIter->second;
+
+      const int32_t tileMinX = tileX * kTileSize_cells;
+      const int32_t tileMinY = tileY * kTileSize_cells;
+      const int32_t x0 = std::max(minTouchedX, tileMinX);
+      const int32_t y0 = std::max(minTouchedY, tileMinY);
+      const int32_t x1 = std::min(maxTouchedX, tileMinX + kTileSize_cells - 1);
+      const int32_t y1 = std::min(maxTouchedY, tileMinY + kTileSize_cells - 1);
+
+      for (int32_t y = y0; y <= y1; ++y)
+      {
+        const bool rowCovered = updateCovered && (y >= minCoveredY) && (y <= maxCoveredY);
+        for (int32_t x = x0; x <= x1; ++x)
+        {
+          const int idx = (y - tileMinY) * kTileSize_cells + (x - tileMinX);
+          uint8_t& touched = tile.touched[idx];
+          if (delta > 0) {
+            tile.numTouched += (touched == 0);
+            ++touched;
+          } else if (touched > 0) {
+            --touched;
+            tile.numTouched -= (touched == 0);
+          }
+
+          if (rowCovered && (x >= minCoveredX) && (x <= maxCoveredX)) {
+            uint8_t& covered = tile.covered[idx];
+            covered = (delta > 0) ? covered + 1 : (covered > 0 ? covered - 1 : 0);
+          }
+        }
+      }
+
+      if (tile.numTouched == 0) {
+        _occupancy.erase(tileIter);
+      }
+
+      InvalidateDistances(tileX, tileY);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CollisionGrid::InvalidateDistances(int32_t tileX, int32_t tileY)
+{
+  std::lock_guard<std::mutex> lock(_distanceMutex);
+  for (int32_t dy = -1; dy <= 1; ++dy) {
+    for (int32_t dx = -1; dx <= 1; ++dx) {
+      _distances.erase( GetTileKey(tileX + dx, tileY + dy) );
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CollisionGrid::DistanceTile& CollisionGrid::GetDistanceTile(int32_t tileX, int32_t tileY) const
+{
+  static const DistanceTile kFarTile = [] {
+    DistanceTile t;
+    t.fill(kMaxDistance_cells);
+    return t;
+  }();
+
+  const TileKey key = GetTileKey(tileX, tileY);
+  const auto cachedIter = _distances.find(key);
+  if (cachedIter != _distances.end()) {
+    return cachedIter->second;
+  }
+
+  // gather the neighborhood. If nothing is nearby, every cell is saturated and there is no need to cache anything
+  std::array<const OccupancyTile*, 9> neighbors;
+  bool anyOccupied = false;
+  for (int32_t dy = -1; dy <= 1; ++dy) {
+    for (int32_t dx = -1; dx <= 1; ++dx) {
+      const auto iter = _occupancy.find( GetTileKey(tileX + dx, tileY + dy) );
+      const OccupancyTile* tile = (iter == _occupancy.end()) ? nullptr : &iter->second;
+      neighbors[(dy + 1) * 3 + (dx + 1)] = tile;
+      anyOccupied |= (tile != nullptr);
+    }
+  }
+
+  if (!anyOccupied) {
+    return kFarTile;
+  }
+
+  // two-pass chessboard distance transform over the tile plus a kMaxDistance_cells margin on every side. Anything
+  // outside the window is at least kMaxDistance_cells away from the tile, so it can't affect the saturated result.
+  constexpr int kMargin = kMaxDistance_cells;
+  constexpr int kWindow = kTileSize_cells + 2 * kMargin;
+  std::array<uint8_t, kWindow * kWindow> dist;
+
+  for (int wy = 0; wy < kWindow; ++wy) {
+    const int32_t cellY = tileY * kTileSize_cells - kMargin + wy;
+    const int32_t ny = GetTileCoord(cellY) - tileY;
+    const int32_t iy = GetCellInTile(cellY);
+    for (int wx = 0; wx < kWindow; ++wx) {
+      const int32_t cellX = tileX * kTileSize_cells - kMargin + wx;
+      const int32_t nx = GetTileCoord(cellX) - tileX;
+      const OccupancyTile* tile = neighbors[(ny + 1) * 3 + (nx + 1)];
+      const bool isTouched = (tile != nullptr) && (tile->touched[iy * kTileSize_cells + GetCellInTile(cellX)] > 0);
+      dist[wy * kWindow + wx] = isTouched ? 0 : kMaxDistance_cells;
+    }
+  }
+
+  auto relax = [&dist](int idx, int neighborIdx) {
+    dist[idx] = std::min<uint8_t>(dist[idx], std::min<int>(dist[neighborIdx] + 1, kMaxDistance_cells));
+  };
+
+  for (int wy = 0; wy < kWindow; ++wy) {
+    for (int wx = 0; wx < kWindow; ++wx) {
+      const int idx = wy * kWindow + wx;
+      if (wx > 0)                         { relax(idx, idx - 1); }
+      if (wy > 0) {
+        relax(idx, idx - kWindow);
+        if (wx > 0)                       { relax(idx, idx - kWindow - 1); }
+        if (wx < kWindow - 1)             { relax(idx, idx - kWindow + 1); }
+      }
+    }
+  }
+
+  for (int wy = kWindow - 1; wy >= 0; --wy) {
+    for (int wx = kWindow - 1; wx >= 0; --wx) {
+      const int idx = wy * kWindow + wx;
+      if (wx < kWindow - 1)               { relax(idx, idx + 1); }
+      if (wy < kWindow - 1) {
+        relax(idx, idx + kWindow);
+        if (wx < kWindow - 1)             { relax(idx, idx + kWindow + 1); }
+        if (wx > 0)                       { relax(idx, idx + kWindow - 1); }
+      }
+    }
+  }
+
+  DistanceTile& result = _distances[key];
+  for (int y = 0; y < kTileSize_cells; ++y) {
+    std::copy_n(&dist[(y + kMargin) * kWindow + kMargin], kTileSize_cells, &result[y * kTileSize_cells]);
+  }
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CollisionGrid::IsCovered(int32_t cellX, int32_t cellY) const
+{
+  const auto iter = _occupancy.find( GetTileKey(GetTileCoord(cellX), GetTileCoord(cellY)) );
+  if (iter == _occupancy.end()) {
+    return false;
+  }
+  return iter->second.covered[GetCellInTile(cellY) * kTileSize_cells + GetCellInTile(cellX)] > 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CollisionGrid::EQueryResult CollisionGrid::Query(const Ball2f& ball) const
+{
+  const Point2f& center = ball.GetCentroid();
+  const int32_t cellX = GetCellCoord(center.x());
+  const int32_t cellY = GetCellCoord(center.y());
+
+  // the center itself is inside collision content
+  if (IsCovered(cellX, cellY)) {
+    return EQueryResult::Collision;
+  }
+
+  uint8_t dist_cells = 0;
+  {
+    std::lock_guard<std::mutex> lock(_distanceMutex);
+    const DistanceTile& tile = GetDistanceTile(GetTileCoord(cellX), GetTileCoord(cellY));
+    dist_cells = tile[GetCellInTile(cellY) * kTileSize_cells + GetCellInTile(cellX)];
+  }
+
+  // chessboard distance between cell centers is a lower bound on their euclidean distance. Remove a cell diagonal
+  // to account for where the ball center is inside its cell, and where the content is inside the touched cell.
+  const float minClearance_mm = (static_cast<float>(dist_cells) - kCellDiagonal_cells) * kCellSize_mm;
+  if (minClearance_mm > ball.GetRadius()) {
+    return EQueryResult::Free;
+  }
+
+  return EQueryResult::Unknown;
+}
+
+} // namespace Vector
+} // namespace Anki
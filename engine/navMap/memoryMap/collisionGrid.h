@@ -0,0 +1,107 @@
+/**
+ * File: collisionGrid.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Sparse, tiled occupancy grid of collision-type content in the memory map, plus a lazily computed
+ *              distance-to-nearest-collision field. It is maintained incrementally from quad tree node change
+ *              notifications, and lets callers answer most small collision queries (e.g. the planner's robot
+ *              footprint checks) in O(1) without traversing the quad tree.
+ *
+ *              Occupancy is conservative: every cell touched by a node that may collide is marked, so a query can
+ *              only prove a region Free (nothing nearby) or in Collision (the center lies in a cell fully covered by
+ *              a node that always collides). Anything else is Unknown and should fall back to an exact quad tree query.
+ *              The split matters because some data (e.g. prox obstacles) changes its collision state in place,
+ *              without notifying the tree, so only its content type can be tracked.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef ANKI_COZMO_COLLISION_GRID_H
+#define ANKI_COZMO_COLLISION_GRID_H
+
+#include "engine/navMap/quadTree/quadTreeTypes.h"
+
+#include "coretech/common/engine/math/ball.h"
+#include "coretech/common/shared/types.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+namespace Anki {
+namespace Vector {
+
+class CollisionGrid
+{
+public:
+
+  enum class EQueryResult : uint8_t {
+    Free,       // guaranteed no collision content intersects the region
+    Collision,  // guaranteed some collision content intersects the region
+    Unknown     // too close to collision content to tell, use an exact query
+  };
+
+  CollisionGrid() = default;
+
+  // add or remove one node's footprint. Must be called with matching arguments, since overlapping footprints
+  // are reference counted (e.g. while a parent and its children exist during subdivision). alwaysCollides should
+  // only be set for content that is a collision regardless of its current state
+  void AddCollisionQuad(const AxisAlignedQuad& quad, bool alwaysCollides)    { UpdateCells(quad, +1, alwaysCollides); }
+  void RemoveCollisionQuad(const AxisAlignedQuad& quad, bool alwaysCollides) { UpdateCells(quad, -1, alwaysCollides); }
+
+  // check a ball against the grid. Safe to call concurrently with other queries, but not with Add/Remove
+  EQueryResult Query(const Ball2f& ball) const;
+
+  // drops all occupancy and cached distances
+  void Clear();
+
+private:
+
+  // cell size matches the smallest quad tree node, and distances saturate at kMaxDistance_cells, which bounds
+  // the largest radius that can be proven Free
+  static constexpr float   kCellSize_mm       = 8.f;
+  static constexpr int     kTileSize_cells    = 32;
+  static constexpr int     kNumTileCells      = kTileSize_cells * kTileSize_cells;
+  static constexpr uint8_t kMaxDistance_cells = 16;
+
+  static_assert(kMaxDistance_cells < kTileSize_cells, "Distance window can only extend into neighboring tiles");
+
+  using TileKey = uint64_t;
+
+  struct OccupancyTile {
+    std::array<uint8_t, kNumTileCells> touched{};  // count of nodes that may collide overlapping each cell at all
+    std::array<uint8_t, kNumTileCells> covered{};  // count of nodes that always collide fully containing each cell
+    int32_t numTouched = 0;                        // number of cells with touched > 0
+  };
+
+  // Chebyshev distance (in cells) from each cell to the nearest touched cell, saturated at kMaxDistance_cells
+  using DistanceTile = std::array<uint8_t, kNumTileCells>;
+
+  static TileKey GetTileKey(int32_t tileX, int32_t tileY);
+  static int32_t GetCellCoord(float x_mm);
+  static int32_t GetTileCoord(int32_t cell) { return (cell >= 0) ? (cell / kTileSize_cells) : ((cell + 1) / kTileSize_cells - 1); }
+  static int32_t GetCellInTile(int32_t cell) { return cell - GetTileCoord(cell) * kTileSize_cells; }
+
+  void UpdateCells(const AxisAlignedQuad& quad, int delta, bool updateCovered);
+
+  // drop cached distances for the tile and all neighbors whose distance window overlaps it
+  void InvalidateDistances(int32_t tileX, int32_t tileY);
+
+  // computes (if needed) and returns the distance tile. Requires _distanceMutex to be held
+  const DistanceTile& GetDistanceTile(int32_t tileX, int32_t tileY) const;
+
+  bool IsCovered(int32_t cellX, int32_t cellY) const;
+
+  std::unordered_map<TileKey, OccupancyTile> _occupancy;
+
+  // distances are computed lazily from (potentially) multiple reader threads
+  mutable std::mutex                                _distanceMutex;
+  mutable std::unordered_map<TileKey, DistanceTile> _distances;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // ANKI_COZMO_COLLISION_GRID_H
@@ -210,6 +210,28 @@ std::vector<bool> MemoryMap::AnyOf( const Point2f& start, const std::vector<Poin
   return _processor.AnyOfRays(start, ends, pred);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool> MemoryMap::AnyOf( const Point2f& start, const std::vector<Point2f>& ends, EContentTypePackedType types) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return _processor.AnyOfRays(start, ends, types);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::AnyCollisionInBall(const Ball2f& ball) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  switch ( _processor.GetCollisionGrid().Query(ball) ) {
+    case CollisionGrid::EQueryResult::Free:      { return false; }
+    case CollisionGrid::EQueryResult::Collision: { return true; }
+    case CollisionGrid::EQueryResult::Unknown:   { break; }
+  }
+
+  bool retv = false;
+  _quadTree.Fold( [&](const auto& node) { retv |= static_cast<const MemoryMapDataPtr&>(node.GetData())->IsCollisionType(); }, ball);
+  return retv;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float MemoryMap::GetArea(const NodePredicate& pred, const MemoryMapRegion& region) const
 {
@@ -229,8 +251,12 @@ bool MemoryMap::Insert(const MemoryMapRegion& r, const MemoryMapData& data)
   const auto& dataPtr = data.Clone();
   std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
 
-  NodeTransformFunction trfm = [&dataPtr] (const MemoryMapDataPtr& currentData) { 
-    currentData->SetLastObservedTime(dataPtr->GetLastObservedTime());
+  NodeTransformFunction trfm = [this, &dataPtr] (const MemoryMapDataPtr& currentData) { 
+    // unknown nodes all share the tree's default data, so it can't be stamped in place. Stamping a copy wouldn't stick
+    // either, since data of the same type compares equal and the node would keep the shared one
+    if ( !_quadTree.IsDefaultData(currentData) ) {
+      currentData->SetLastObservedTime(dataPtr->GetLastObservedTime());
+    }
     return currentData->CanOverrideSelfWithContent(dataPtr) ? dataPtr : currentData; 
   };
   return MONITOR_PERFORMANCE( _quadTree.Insert(r, trfm) );
@@ -244,26 +270,27 @@ bool MemoryMap::Insert(const MemoryMapRegion& r, NodeTransformFunction transform
   return MONITOR_PERFORMANCE( _quadTree.Insert(r, transform) );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExternalInterface::MemoryMapInfo MemoryMap::GetBroadcastMapInfo() const
+{
+  std::stringstream instanceId;
+  instanceId << "QuadTree_" << this;
+
+  return ExternalInterface::MemoryMapInfo(
+    _quadTree.GetMaxHeight(),
+    _quadTree.GetSideLen(),
+    _quadTree.GetCenter().x(),
+    _quadTree.GetCenter().y(),
+    1.f,
+    instanceId.str());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MemoryMap::GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const 
 { 
   // get data for each node
   QuadTreeTypes::FoldFunctorConst accumulator = 
-    [&info, this] (const QuadTreeNode& node) {
-      // if the root done, populate header info
-      if ( node.IsRootNode() ){
-        std::stringstream instanceId;
-        instanceId << "QuadTree_" << this;
-
-        info.mapInfo = ExternalInterface::MemoryMapInfo(
-          node.GetMaxHeight(),
-          node.GetSideLen(),
-          node.GetCenter().x(),
-          node.GetCenter().y(),
-          1.f,
-          instanceId.str());
-      }
-
+    [&info] (const QuadTreeNode& node) {
       // leaf node
       if ( !node.IsSubdivided() )
       {
@@ -283,8 +310,57 @@ void MemoryMap::GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const
     };
 
   std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  info.mapInfo = GetBroadcastMapInfo();
+  info.version = _processor.GetChangeVersion();
   _quadTree.Fold(accumulator);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::GetBroadcastDelta(uint32_t sinceVersion, MemoryMapTypes::MapBroadcastDelta& delta) const
+{
+  // a node's center is strictly inside it, and exactly on the corner of its children (if any), so probing with a
+  // tiny ball around it only finds the node itself if it is still a leaf
+  static const float kProbeRadius_mm = 0.01f;
+
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  delta.mapInfo = GetBroadcastMapInfo();
+  delta.version = _processor.GetChangeVersion();
+
+  return _processor.GetChangesSince(sinceVersion, [this, &delta] (const Point2f& center, float sideLen) {
+    const QuadTreeNode* leaf = nullptr;
+    QuadTreeTypes::FoldFunctorConst findLeaf = [&] (const QuadTreeNode& node) {
+      if ( !node.IsSubdivided() && (node.GetSideLen() == sideLen) && (node.GetCenter() == center) ) {
+        leaf = &node;
+      }
+    };
+    _quadTree.Fold(findLeaf, Ball2f(center, kProbeRadius_mm));
+
+    if ( leaf != nullptr ) {
+      delta.changedQuads.emplace_back(GetNodeVizColor(leaf->GetData()).AsRGBA(), center.x(), center.y(), sideLen);
+    } else {
+      delta.removedQuads.emplace_back(0, center.x(), center.y(), sideLen);
+    }
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MemoryMap::TrimChangeJournal(uint32_t upToVersion)
+{
+  std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
+  _processor.TrimChangeJournal(upToVersion);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MemoryMap::SetChangeJournalEnabled(bool enabled)
+{
+  // called every tick, so avoid the write lock unless something changes. Only the map owner toggles it
+  if ( _processor.IsChangeJournalEnabled() == enabled ) {
+    return;
+  }
+
+  std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
+  _processor.SetChangeJournalEnabled(enabled);
+}
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MemoryMap::FindContentIf(const NodePredicate& pred, MemoryMapDataConstList& output, const MemoryMapRegion& region) const
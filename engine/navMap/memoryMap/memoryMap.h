@@ -32,6 +32,7 @@ public:
   using FullContentArray       = MemoryMapTypes::FullContentArray;
   using MemoryMapRegion        = MemoryMapTypes::MemoryMapRegion;
   using MemoryMapDataConstList = MemoryMapTypes::MemoryMapDataConstList;
+  using EContentTypePackedType = MemoryMapTypes::EContentTypePackedType;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Construction/Destruction
@@ -72,6 +73,10 @@ public:
   // multi-ray variant of the AnyOf method
   // implementation may optimize for this case
   virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const override;
+  virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, EContentTypePackedType types) const override;
+
+  // collision check against the processor's collision grid, falling back to the tree when the grid can't tell
+  virtual bool AnyCollisionInBall(const Ball2f& ball) const override;
 
   // returns the accumulated area of cells that satisfy the predicate (and region, if supplied)
   virtual float GetArea(const NodePredicate& f, const MemoryMapRegion& r) const override;
@@ -79,7 +84,16 @@ public:
   // Broadcast the memory map
   virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const override;
 
+  // Broadcast only what changed, from the processor's change journal
+  virtual bool GetBroadcastDelta(uint32_t sinceVersion, MemoryMapTypes::MapBroadcastDelta& delta) const override;
+  virtual void TrimChangeJournal(uint32_t upToVersion) override;
+  virtual void SetChangeJournalEnabled(bool enabled) override;
+
 private:
+
+  // header info for broadcasting, taken from the root. Requires _writeAccess to be held
+  ExternalInterface::MemoryMapInfo GetBroadcastMapInfo() const;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Attributes
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -48,10 +48,20 @@ enum class EContentType : uint8_t {
 };
 
 struct MapBroadcastData {
-  MapBroadcastData() : mapInfo(), quadInfo() {}
+  MapBroadcastData() : mapInfo(), quadInfo(), version(0) {}
   ExternalInterface::MemoryMapInfo                  mapInfo;
   std::vector<ExternalInterface::MemoryMapQuadInfo> quadInfo;
   std::vector<ExternalInterface::MemoryMapQuadInfoFull> quadInfoFull;
+  uint32_t                                          version;  // change version of the map this snapshot matches
+};
+
+// leaf quads that changed since a given map version
+struct MapBroadcastDelta {
+  MapBroadcastDelta() : mapInfo(), version(0) {}
+  ExternalInterface::MemoryMapInfo                      mapInfo;
+  std::vector<ExternalInterface::MemoryMapQuadInfoFull> changedQuads;  // new leaves, or leaves with new content
+  std::vector<ExternalInterface::MemoryMapQuadInfoFull> removedQuads;  // leaves that no longer exist (color is unused)
+  uint32_t                                              version;
 };
 
 // Provide a custom hasher for unordered sets
@@ -39,15 +39,24 @@ QuadTree::QuadTree(
   std::function<void (const QuadTreeNode*)> destructorCallback,
   std::function<void (const QuadTreeNode*, const NodeContent&)> modifiedCallback
 )
+: QuadTreeNode(&_treeContext)
+, _treeContext(std::move(destructorCallback), std::move(modifiedCallback))
 {
   _sideLen            = kQuadTreeInitialRootSideLength;
   _maxHeight          = kQuadTreeInitialMaxDepth;
   _quadrant           = EQuadrant::Root;
   _address            = {};
   _boundingBox        = AxisAlignedQuad(_center - Point2f(_sideLen*.5f), _center + Point2f(_sideLen*.5));
+  _content            = _treeContext.defaultContent;
+}
 
-  _destructorCallback = destructorCallback;
-  _modifiedCallback   = modifiedCallback;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTree::~QuadTree()
+{
+  // the context is destroyed before the base node, so notify and release all nodes while it is still valid
+  _treeContext.destructorCallback(this);
+  ReleaseChildren();
+  _context = nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -58,6 +67,12 @@ float QuadTree::GetContentPrecisionMM() const
   return minSide_mm;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTree::IsDefaultData(const MemoryMapDataPtr& data) const
+{
+  return data.GetSharedPtr() == static_cast<const MemoryMapDataPtr&>(_treeContext.defaultContent).GetSharedPtr();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool QuadTree::Insert(const FoldableRegion& region, NodeTransformFunction transform)
 {
@@ -272,12 +287,19 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
     return false;
   }
 
+  // the processor tracks nodes by their geometry, so take the content out under the old bounds and put it back
+  // under the new ones
+  NodeContent rootContent = _content;
+  ForceSetContent( NodeContent(_context->defaultContent) );
+
   // the new center will be shifted in one or both axes, depending on xyIncrease
   // for example, if we left the root through the right, only the right side will expand, and the left will collapse,
   // but top and bottom will remain the same
   _center.x() = _center.x() + (xShift ? (xPlusAxisReq ? rootHalfLen : -rootHalfLen) : 0.0f);
   _center.y() = _center.y() + (yShift ? (yPlusAxisReq ? rootHalfLen : -rootHalfLen) : 0.0f);
   _boundingBox = AxisAlignedQuad(_center - Point2f(_sideLen * .5f), _center + Point2f(_sideLen * .5f) );
+
+  ForceSetContent( std::move(rootContent) );
   
   // if the root has children, update them, otherwise no further changes are necessary
   if ( IsSubdivided() )
@@ -288,8 +310,8 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
   
     if ( xShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      QuadTreeNode* oldChildren = _children;
+      _children = nullptr;
       Subdivide();
 
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
@@ -298,14 +320,17 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
       const size_t b2 = (Q2N) (!xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
 
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      _children[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      _children[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
+      // delete everything in oldChildren since we put the nodes we are keeping back into their new position
+      _context->FreeChildren(oldChildren);
     }
 
     if ( yShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      QuadTreeNode* oldChildren = _children;
+      _children = nullptr;
       Subdivide();
       
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
@@ -314,9 +339,11 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
       const size_t b2 = (Q2N) (!yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
 
+      _children[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      _children[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
       // delete everything in oldChildren since we put the nodes we are keeping back into their new position
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      _context->FreeChildren(oldChildren);
     }
   }
 
@@ -354,31 +381,35 @@ bool QuadTree::UpgradeRootLevel(const Point2f& direction, uint8_t maxRootLevel)
           +-------+-------+ - - - - - - - +
 */
 
+  // the processor tracks nodes by their geometry, so take my content out while I still have the old bounds. It is
+  // handed to the child that takes my place below
+  NodeContent rootContent = _content;
+  ForceSetContent( NodeContent(_context->defaultContent) );
+
   // reset this nodes parameters
   _center += Quadrant2Vec( Vec2Quadrant(direction) ) * _sideLen * 0.5f;
   _boundingBox = AxisAlignedQuad(_center - Point2f(_sideLen), _center + Point2f(_sideLen) );
   _sideLen *= 2.0f;
   ++_maxHeight;
   
-  // temporary take its children, then subdivide this node again
-  std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-  std::swap(oldChildren, _childrenPtr);
+  // temporary take its children, then subdivide this node again. This notifies the change under the new bounds
+  QuadTreeNode* oldChildren = _children;
+  _children = nullptr;
   Subdivide();
 
   // calculate the child that takes my place by using the opposite direction to expansion
   QuadTreeNode* childTakingMyPlace = GetChild( Vec2Quadrant(-direction) );
   
-  // set the new parent in my old children
-  for ( auto& childPtr : oldChildren ) {
-    childPtr->ChangeParent( childTakingMyPlace );
+  // set the new parent in my old children, and hand them over (the new child is a leaf, so it has none to lose)
+  if ( oldChildren != nullptr ) {
+    for ( size_t i = 0; i < kNumChildren; ++i ) {
+      oldChildren[i].ChangeParent( childTakingMyPlace );
+    }
+    childTakingMyPlace->_children = oldChildren;
   }
-  
-  // swap children with the temp
-  std::swap(childTakingMyPlace->_childrenPtr, oldChildren);
 
-  // set the content type I had in the child that takes my place, then reset my content
-  childTakingMyPlace->ForceSetContent( NodeContent(_content) );
-  ForceSetContent(MemoryMapDataPtr());
+  // set the content type I had in the child that takes my place
+  childTakingMyPlace->ForceSetContent( std::move(rootContent) );
 
   // log
   PRINT_CH_INFO("QuadTree", "QuadTree.UpdgradeRootLevel", "Root expanded to level %u. Allowing %.2fm", _maxHeight, MM_TO_M(_sideLen));
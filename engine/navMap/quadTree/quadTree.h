@@ -34,6 +34,7 @@ public:
     std::function<void (const QuadTreeNode*)> destructorCallback,
     std::function<void (const QuadTreeNode*, const NodeContent&)> modifiedCallback
   );
+  ~QuadTree();
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Accessors
@@ -43,6 +44,10 @@ public:
   // the region that the point generated to store the point could have an error of up to this length.
   float GetContentPrecisionMM() const;
 
+  // true if data is the payload shared by every unknown node in this tree. It must never be modified in place, since
+  // that would change all of those nodes at once
+  bool IsDefaultData(const MemoryMapDataPtr& data) const;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Operations
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -85,6 +90,13 @@ private:
   // maxRootLevel: it won't upgrade if the root is already higher level than the specified
   bool UpgradeRootLevel(const Point2f& direction, uint8_t maxRootLevel);
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Attributes
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // callbacks and node storage shared by every node in this tree
+  TreeContext _treeContext;
+
 }; // class
   
 } // namespace
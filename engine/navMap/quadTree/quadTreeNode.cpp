@@ -14,8 +14,12 @@
 #include "quadTreeNode.h"
 #include "engine/navMap/memoryMap/data/memoryMapData.h"
 
+#include "util/logging/logging.h"
 #include "util/math/math.h"
 
+#include <new>
+#include <type_traits>
+
 namespace Anki {
 namespace Vector {
 
@@ -27,24 +31,94 @@ static_assert( !std::is_move_constructible<QuadTreeNode>::value, "QuadTreeNode w
 namespace {
   // helper type for recursing on all children of this node
   static const RealNumbers2f kNodeRegion = RealNumbers2f();
+
+  // number of child blocks to allocate at once when the context runs out
+  constexpr size_t kChildBlocksPerChunk = 64;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// TreeContext
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// raw storage for one set of siblings
+struct QuadTreeNode::TreeContext::ChildBlock {
+  typename std::aligned_storage<sizeof(QuadTreeNode), alignof(QuadTreeNode)>::type nodes[kNumChildren];
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode::TreeContext::TreeContext(DestructorCallback&& onDestroyed, ModifiedCallback&& onModified)
+: destructorCallback(std::move(onDestroyed))
+, modifiedCallback(std::move(onModified))
+, defaultContent()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode::TreeContext::~TreeContext()
+{
+  DEV_ASSERT(_freeBlocks.size() == _chunks.size() * kChildBlocksPerChunk, "QuadTreeNode.TreeContext.LeakedChildren");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode* QuadTreeNode::TreeContext::AllocateChildren(const QuadTreeNode* parent)
+{
+  if ( _freeBlocks.empty() ) {
+    _chunks.emplace_back( new ChildBlock[kChildBlocksPerChunk] );
+    ChildBlock* chunk = _chunks.back().get();
+    for ( size_t i = kChildBlocksPerChunk; i > 0; --i ) {
+      _freeBlocks.push_back( &chunk[i-1] );
+    }
+  }
+
+  ChildBlock* block = _freeBlocks.back();
+  _freeBlocks.pop_back();
+
+  // quadrant enum values match the child indices
+  QuadTreeNode* children = reinterpret_cast<QuadTreeNode*>(block->nodes);
+  for ( size_t i = 0; i < kNumChildren; ++i ) {
+    new (&children[i]) QuadTreeNode(parent, static_cast<EQuadrant>(i));
+  }
+  return children;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::TreeContext::FreeChildren(QuadTreeNode* children)
+{
+  for ( size_t i = 0; i < kNumChildren; ++i ) {
+    children[i].~QuadTreeNode();
+  }
+  _freeBlocks.push_back( reinterpret_cast<ChildBlock*>(children) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// QuadTreeNode
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode::QuadTreeNode(TreeContext* context)
+: _children(nullptr)
+, _boundingBox({0,0}, {0,0})
+, _parent(nullptr)
+, _quadrant(EQuadrant::Root)
+, _context(context)
+{
+  ResetAddress();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
-: _boundingBox({0,0}, {0,0})
+: _children(nullptr)
+, _boundingBox({0,0}, {0,0})
 , _parent(parent)
 , _quadrant(quadrant)
+, _content(parent->_context->defaultContent)
+, _context(parent->_context)
 {
-  if (_parent) { 
-    float halfLen = _parent->GetSideLen() * .25f;
-    _sideLen      = _parent->GetSideLen() * .5f;
-    _center       = _parent->GetCenter() + Quadrant2Vec(_quadrant) * halfLen;
-    _maxHeight    = _parent->GetMaxHeight() - 1;
-    _boundingBox  = AxisAlignedQuad(_center - Point2f(halfLen), _center + Point2f(halfLen));
-
-    _destructorCallback = _parent->_destructorCallback;
-    _modifiedCallback   = _parent->_modifiedCallback;
-  }
+  float halfLen = _parent->GetSideLen() * .25f;
+  _sideLen      = _parent->GetSideLen() * .5f;
+  _center       = _parent->GetCenter() + Quadrant2Vec(_quadrant) * halfLen;
+  _maxHeight    = _parent->GetMaxHeight() - 1;
+  _boundingBox  = AxisAlignedQuad(_center - Point2f(halfLen), _center + Point2f(halfLen));
   
   ResetAddress();
 }
@@ -52,7 +126,20 @@ QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode::~QuadTreeNode()
 {
-  _destructorCallback(this);
+  // the QuadTree tears itself down and clears the context before its members (including the context) are destroyed
+  if ( _context != nullptr ) {
+    _context->destructorCallback(this);
+    ReleaseChildren();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::ReleaseChildren()
+{
+  if ( _children != nullptr ) {
+    _context->FreeChildren(_children);
+    _children = nullptr;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -70,17 +157,14 @@ bool QuadTreeNode::Subdivide()
 {
   if ( (_maxHeight == 0) || IsSubdivided() ) { return false; }
   
-  // create new children, push our data to them, then clear our own data
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXPlusY) );   // up L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXMinusY) );  // up R
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXPlusY) );  // lo L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXMinusY) ); // lo R
-
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ForceSetContent( NodeContent(_content) );
+  // create new children (up L, up R, lo L, lo R), push our data to them, then clear our own data
+  _children = _context->AllocateChildren(this);
+
+  for ( size_t i = 0; i < kNumChildren; ++i ) {
+    _children[i].ForceSetContent( NodeContent(_content) );
   }
 
-  ForceSetContent(NodeContent());
+  ForceSetContent( NodeContent(_context->defaultContent) );
 
   return true;
 }
@@ -93,8 +177,8 @@ void QuadTreeNode::TryAutoMerge()
   }
 
   // can't merge if any children are subdivided
-  for (const auto& child : _childrenPtr) {
-    if ( child->IsSubdivided() ) {
+  for (size_t i=0; i<kNumChildren; ++i) {
+    if ( _children[i].IsSubdivided() ) {
       return;
     }
   }
@@ -102,19 +186,19 @@ void QuadTreeNode::TryAutoMerge()
   bool allChildrenEqual = true;
   
   // check if all children classified the same content (assumes node content equality is transitive)
-  for(size_t i=0; i<_childrenPtr.size()-1; ++i)
+  for(size_t i=0; i<kNumChildren-1; ++i)
   {
-    allChildrenEqual &= (_childrenPtr[i]->GetData() == _childrenPtr[i+1]->GetData());
+    allChildrenEqual &= (_children[i].GetData() == _children[i+1].GetData());
   }
   
   // we can merge and set that type on this parent
   if ( allChildrenEqual )
   {
     // do a copy since merging will destroy children
-    auto content = _childrenPtr[0]->GetData();
+    auto content = _children[0].GetData();
     ForceSetContent(std::move(content));
 
-    _childrenPtr.clear();    
+    ReleaseChildren();
   }
 }
 
@@ -122,7 +206,7 @@ void QuadTreeNode::TryAutoMerge()
 void QuadTreeNode::ForceSetContent(NodeContent&& newContent)
 {
   std::swap(_content, newContent);
-  _modifiedCallback(this, newContent);
+  _context->modifiedCallback(this, newContent);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -137,16 +221,16 @@ void QuadTreeNode::ChangeParent(const QuadTreeNode* newParent)
 void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
 {
   // swap children
-  std::swap(_childrenPtr, otherNode->_childrenPtr);
+  std::swap(_children, otherNode->_children);
 
   // notify the children of the parent change
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ChangeParent( this );
+  for ( size_t i = 0; IsSubdivided() && (i < kNumChildren); ++i ) {
+    _children[i].ChangeParent( this );
   }
 
   // notify the children of the parent change
-  for ( auto& childPtr : otherNode->_childrenPtr ) {
-    childPtr->ChangeParent( otherNode );
+  for ( size_t i = 0; otherNode->IsSubdivided() && (i < kNumChildren); ++i ) {
+    otherNode->_children[i].ChangeParent( otherNode );
   }
 
   // swap contents by use of copy, since changes have to be notified to the processor
@@ -159,9 +243,9 @@ void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
 const QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant) const
 {
   const QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( !IsSubdivided() ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &_children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
@@ -169,9 +253,9 @@ const QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant) const
 QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant)
 {
   QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( !IsSubdivided() ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &_children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
@@ -181,9 +265,10 @@ void QuadTreeNode::AddSmallestDescendants(EDirection direction, std::vector<cons
   if ( !IsSubdivided() ) {
     descendants.emplace_back( this );
   } else {
-    for (const auto& child : _childrenPtr) {
-      if(!IsSibling(child->_quadrant, direction)) { 
-        child->AddSmallestDescendants(direction, descendants); 
+    for (size_t i=0; i<kNumChildren; ++i) {
+      const QuadTreeNode& child = _children[i];
+      if(!IsSibling(child._quadrant, direction)) { 
+        child.AddSmallestDescendants(direction, descendants); 
       };
     }
   }
@@ -230,6 +315,25 @@ std::vector<const QuadTreeNode*> QuadTreeNode::GetNeighbors() const
   return neighbors;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const QuadTreeNode* QuadTreeNode::GetLeafAt(const Point2f& point) const
+{
+  const Point2f& minV = _boundingBox.GetMinVertex();
+  const Point2f& maxV = _boundingBox.GetMaxVertex();
+  if ( (point.x() < minV.x()) || (point.x() > maxV.x()) || (point.y() < minV.y()) || (point.y() > maxV.y()) ) {
+    return nullptr;
+  }
+
+  // descend directly instead of folding, since exactly one child contains the point at every level
+  const QuadTreeNode* node = this;
+  while ( node->IsSubdivided() ) {
+    const bool minusX = point.x() < node->_center.x();
+    const bool minusY = point.y() < node->_center.y();
+    node = &node->_children[(minusX ? 2 : 0) + (minusY ? 1 : 0)];
+  }
+  return node;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Fold Implementations
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -304,15 +408,17 @@ void QuadTreeNode::Fold(FoldFunctor& accumulator, const FoldableRegion& region,
   
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
-  if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
-    }
-  } else {
-    u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
-      if ((childFilter >>= 1) == 0) { break; };
+  if ( IsSubdivided() ) {
+    if ( region.ContainsQuad(_boundingBox) ) { 
+      for ( size_t i = 0; i < kNumChildren; ++i ) {
+        _children[i].Fold(accumulator, kNodeRegion, dir); 
+      }
+    } else {
+      u8 childFilter = GetChildFilterMask(_center, region.GetBoundingBox());
+      for ( size_t i = 0; i < kNumChildren; ++i ) { 
+        if (childFilter & 0x1) { _children[i].Fold(accumulator, region, dir); }
+        if ((childFilter >>= 1) == 0) { break; };
+      }
     }
   }
 
@@ -326,15 +432,17 @@ void QuadTreeNode::Fold(const FoldFunctorConst& accumulator, const FoldableRegio
   
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
-  if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
-    }
-  } else {
-    u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
-      if ((childFilter >>= 1) == 0) { break; };
+  if ( IsSubdivided() ) {
+    if ( region.ContainsQuad(_boundingBox) ) { 
+      for ( size_t i = 0; i < kNumChildren; ++i ) {
+        _children[i].Fold(accumulator, kNodeRegion, dir); 
+      }
+    } else {
+      u8 childFilter = GetChildFilterMask(_center, region.GetBoundingBox());
+      for ( size_t i = 0; i < kNumChildren; ++i ) { 
+        if (childFilter & 0x1) { _children[i].Fold(accumulator, region, dir); }
+        if ((childFilter >>= 1) == 0) { break; };
+      }
     }
   }
 
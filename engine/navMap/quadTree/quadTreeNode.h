@@ -19,6 +19,10 @@
 
 #include "util/helpers/noncopyable.h"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace Anki {
 namespace Vector {
 
@@ -35,7 +39,7 @@ public:
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   bool                   IsRootNode()     const { return _parent == nullptr; }
-  bool                   IsSubdivided()   const { return !_childrenPtr.empty(); }
+  bool                   IsSubdivided()   const { return _children != nullptr; }
   uint8_t                GetMaxHeight()   const { return _maxHeight; }
   float                  GetSideLen()     const { return _sideLen; }
   const Point2f&         GetCenter()      const { return _center; }
@@ -51,15 +55,57 @@ public:
   // finds all the leaf nodes that are neighbors with this node
   std::vector<const QuadTreeNode*> GetNeighbors() const;
 
+  // returns the leaf node containing the given point, or nullptr if the point is outside this node. Points on a
+  // shared edge belong to the node on the plus side
+  const QuadTreeNode* GetLeafAt(const Point2f& point) const;
+
 protected:
 
+  // a node is either a leaf or has exactly this many children, stored contiguously in quadrant order
+  static constexpr size_t kNumChildren = 4;
+
+  using DestructorCallback = std::function<void (const QuadTreeNode*)>;
+  using ModifiedCallback   = std::function<void (const QuadTreeNode*, const NodeContent&)>;
+
+  // state shared by all nodes in a tree, so that each node only needs to carry a pointer to it. Owned by the QuadTree
+  class TreeContext : private Util::noncopyable
+  {
+  public:
+    TreeContext(DestructorCallback&& onDestroyed, ModifiedCallback&& onModified);
+    ~TreeContext();
+
+    // constructs the kNumChildren children of parent in one pooled block, and returns the first one
+    QuadTreeNode* AllocateChildren(const QuadTreeNode* parent);
+
+    // destroys the children returned by AllocateChildren and recycles their block
+    void FreeChildren(QuadTreeNode* children);
+
+    // callbacks to notify external system if an element has changed or been destroyed
+    const DestructorCallback destructorCallback;
+    const ModifiedCallback   modifiedCallback;
+
+    // payload shared by all newly created (unknown) nodes, instead of allocating one per node. The pointer is const but
+    // the data it points to isn't, so anything that modifies node data in place must skip it (see QuadTree::IsDefaultData)
+    const NodeContent defaultContent;
+
+  private:
+    struct ChildBlock;
+
+    // blocks are allocated in chunks and never released until the tree is destroyed
+    std::vector<std::unique_ptr<ChildBlock[]>> _chunks;
+    std::vector<ChildBlock*>                   _freeBlocks;
+  };
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Initialization
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
-  // Leave the constructor as a protected member so only the root node or other Quad tree nodes can create new nodes
-  // it will allow subdivision as long as level is greater than 0
-  QuadTreeNode(const QuadTreeNode* parent = nullptr, EQuadrant quadrant = EQuadrant::Root);
+  // Leave the constructors as protected members so only the root node or other Quad tree nodes can create new nodes.
+  // The root constructor does not use the context, so it can point to a member of the tree that is not constructed yet
+  explicit QuadTreeNode(TreeContext* context);
+
+  // child node. It will allow subdivision as long as level is greater than 0
+  QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant);
     
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Modification
@@ -71,6 +117,9 @@ protected:
   // split the current node
   bool Subdivide();
 
+  // destroy all children (if any), turning this node back into a leaf without changing its content
+  void ReleaseChildren();
+
   // checks if all children are the same type, if so it removes the children and merges back to a single parent
   void TryAutoMerge();
   
@@ -110,8 +159,8 @@ protected:
   
   // NOTE: try to minimize padding in these attributes
 
-  // children when subdivided. Can be empty or have 4 nodes
-  std::vector< std::unique_ptr<QuadTreeNode> > _childrenPtr;
+  // children when subdivided. Either null or kNumChildren nodes allocated by the tree context
+  QuadTreeNode* _children;
 
   // coordinates of this quad
   Point2f _center;
@@ -132,9 +181,8 @@ protected:
   // information about what's in this quad
   NodeContent _content;
 
-  // callbacks to notify external system if an element has changed or been destroyed
-  std::function<void (const QuadTreeNode*)> _destructorCallback;
-  std::function<void (const QuadTreeNode*, const NodeContent&)> _modifiedCallback;
+  // shared by all nodes in the tree
+  TreeContext* _context;
     
 }; // class
   
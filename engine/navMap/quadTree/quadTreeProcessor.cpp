@@ -12,11 +12,12 @@
 #include "quadTreeProcessor.h"
 #include "quadTree.h"
 
-#include "coretech/common/engine/math/bresenhamLine2d.h"
-
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define LOG_CHANNEL "quadTreeProcessor"
 
 namespace Anki {
@@ -30,6 +31,46 @@ CONSOLE_VAR(bool , kRenderBorder3DLines, "QuadTreeProcessor", false); // renders
 CONSOLE_VAR(float, kRenderZOffset      , "QuadTreeProcessor", 20.0f); // adds Z offset to all quads
 CONSOLE_VAR(bool , kDebugFindBorders   , "QuadTreeProcessor", false); // prints debug information in console
 
+// if the change journal is enabled but not trimmed often enough, drop it once it gets this big
+CONSOLE_VAR(u32  , kMaxChangeJournalSize, "QuadTreeProcessor", 8192);
+
+namespace {
+
+  // distance to step past a node edge while walking a ray, so that the next lookup lands in the neighboring node.
+  // Much smaller than the smallest node, but large enough to survive float rounding at map scale coordinates
+  constexpr float kRayStep_mm = 0.01f;
+
+  // clips the ray start + t*(dx,dy) against the box using the slab method. On success, [tEnter, tLeave] is narrowed
+  // to the part of the ray inside the box. Returns false if the ray misses the box
+  bool ClipRayToBox(const Point2f& start, float dx, float dy, const AxisAlignedQuad& box, float& tEnter, float& tLeave)
+  {
+    const float s[2]    = {start.x(), start.y()};
+    const float d[2]    = {dx, dy};
+    const float minV[2] = {box.GetMinVertex().x(), box.GetMinVertex().y()};
+    const float maxV[2] = {box.GetMaxVertex().x(), box.GetMaxVertex().y()};
+
+    for ( int axis = 0; axis < 2; ++axis )
+    {
+      if ( d[axis] == 0.f ) {
+        if ( (s[axis] < minV[axis]) || (s[axis] > maxV[axis]) ) {
+          return false;
+        }
+        continue;
+      }
+
+      const float invD = 1.f / d[axis];
+      float tMin = (minV[axis] - s[axis]) * invD;
+      float tMax = (maxV[axis] - s[axis]) * invD;
+      if ( tMin > tMax ) {
+        std::swap(tMin, tMax);
+      }
+      tEnter = std::max(tEnter, tMin);
+      tLeave = std::min(tLeave, tMax);
+    }
+    return tEnter <= tLeave;
+  }
+}
+
 #define DEBUG_FIND_BORDER(format, ...)                                                                          \
 if ( kDebugFindBorders ) {                                                                                      \
   do{::Anki::Util::sChanneledInfoF(LOG_CHANNEL, "NMQTProcessor", {}, format, ##__VA_ARGS__);}while(0); \
@@ -40,6 +81,9 @@ QuadTreeProcessor::QuadTreeProcessor()
 : _quadTree(nullptr)
 , _totalExploredArea_m2(0.0)
 , _totalInterestingEdgeArea_m2(0.0)
+, _changeVersion(0)
+, _journalStartVersion(0)
+, _changeJournalEnabled(false)
 {
 
 }
@@ -52,6 +96,9 @@ void QuadTreeProcessor::OnNodeContentChanged(const QuadTreeNode* node, const Nod
   const EContentType oldType = static_cast<const MemoryMapDataPtr&>(oldContent)->type;
   const EContentType newType = static_cast<const MemoryMapDataPtr&>(node->GetData())->type;
 
+  // data can change without changing type, and still be rendered differently
+  RecordChange(node);
+
   // type hasn't changed, so we don't need to update any of our caching
   if (oldType == newType) { return; }
 
@@ -112,10 +159,24 @@ void QuadTreeProcessor::OnNodeContentChanged(const QuadTreeNode* node, const Nod
                "QuadTreeProcessor.OnNodeContentTypeChanged.InvalidInsert");
     _nodeSets[newType].insert(node);
   }
+
+  // update collision footprint. Only the content type is tracked, since some data changes its collision state
+  // in place (e.g. prox obstacle confidence) without notifying the tree
+  if ( MayCollide(oldType) )
+  {
+    _collisionGrid.RemoveCollisionQuad(node->GetBoundingBox(), AlwaysCollides(oldType));
+  }
+
+  if ( MayCollide(newType) )
+  {
+    _collisionGrid.AddCollisionQuad(node->GetBoundingBox(), AlwaysCollides(newType));
+  }
 }
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeProcessor::OnNodeDestroyed(const QuadTreeNode* node)
 {
+  RecordChange(node);
+
   // if old content type is cached
   const EContentType oldContent = static_cast<const MemoryMapDataPtr&>(node->GetData())->type;
   if ( IsCached(oldContent) )
@@ -126,6 +187,12 @@ void QuadTreeProcessor::OnNodeDestroyed(const QuadTreeNode* node)
     _nodeSets[oldContent].erase(node);
   }
 
+  // remove collision footprint
+  if ( MayCollide(oldContent) )
+  {
+    _collisionGrid.RemoveCollisionQuad(node->GetBoundingBox(), AlwaysCollides(oldContent));
+  }
+
   // remove the area for this node if it was counted before
   {
     const bool wasOutOld = (oldContent == EContentType::Unknown);
@@ -152,48 +219,149 @@ void QuadTreeProcessor::OnNodeDestroyed(const QuadTreeNode* node)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-std::vector<bool>
-QuadTreeProcessor::AnyOfRays( const Point2f& start, 
-                              const std::vector<Point2f>& ends, 
-                              const NodePredicate& pred) const
+void QuadTreeProcessor::RecordChange(const QuadTreeNode* node)
+{
+  ++_changeVersion;
+  if ( !_changeJournalEnabled ) {
+    _journalStartVersion = _changeVersion;
+    return;
+  }
+
+  const NodeKey key{node->GetCenter().x(), node->GetCenter().y(), node->GetSideLen()};
+  _changeJournal[key] = _changeVersion;
+
+  // the consumer is falling behind, start over. It will see the gap and request a full snapshot
+  if ( _changeJournal.size() > kMaxChangeJournalSize ) {
+    TrimChangeJournal(_changeVersion);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTreeProcessor::GetChangesSince(uint32_t sinceVersion, const NodeChangeFunc& func) const
+{
+  if ( sinceVersion < _journalStartVersion ) {
+    return false;
+  }
+
+  for ( const auto& entry : _changeJournal ) {
+    if ( entry.second > sinceVersion ) {
+      func( Point2f{entry.first.x, entry.first.y}, entry.first.sideLen );
+    }
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeProcessor::TrimChangeJournal(uint32_t upToVersion)
+{
+  if ( upToVersion >= _changeVersion ) {
+    _changeJournal.clear();
+  } else {
+    for ( auto it = _changeJournal.begin(); it != _changeJournal.end(); ) {
+      it = (it->second <= upToVersion) ? _changeJournal.erase(it) : std::next(it);
+    }
+  }
+  _journalStartVersion = std::max(_journalStartVersion, upToVersion);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeProcessor::SetChangeJournalEnabled(bool enabled)
+{
+  if ( enabled == _changeJournalEnabled ) {
+    return;
+  }
+
+  _changeJournalEnabled = enabled;
+  TrimChangeJournal(_changeVersion);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename LeafPredicate>
+std::vector<bool> QuadTreeProcessor::CastRays(const Point2f& start,
+                                              const std::vector<Point2f>& ends,
+                                              const LeafPredicate& leafPred) const
 {
   std::vector<bool> results(ends.size(), false);
-  std::unordered_map<Point2i ,bool> localCache;
-
-  // start by rasterizing the line described by [start,end]
-  const auto startBres = QuadTreeTypes::GetIntegralCoordinateOfNode(start, 
-    _quadTree->GetCenter(), 
-    _quadTree->GetContentPrecisionMM(), 
-    _quadTree->GetMaxHeight());
-  const auto maxTreeHeight = _quadTree->GetMaxHeight();
-
-  for(int rayIdx = 0; rayIdx<ends.size(); ++rayIdx) {
-    BresenhamLinePixelIterator bresIter(startBres, 
-      QuadTreeTypes::GetIntegralCoordinateOfNode(ends[rayIdx], 
-        _quadTree->GetCenter(), 
-        _quadTree->GetContentPrecisionMM(), 
-        _quadTree->GetMaxHeight()));
-    while(!bresIter.Done()) {
-      const Point2i& rasterPoint = bresIter.Get();
-      auto got = localCache.find(rasterPoint);
-      if(got == localCache.end()) {
-        // compute new result and insert into the cache
-        const QuadTreeNode* qnode = nullptr;
-        auto getNode = [&qnode] (const QuadTreeNode& n) { qnode = &n; };
-        ((const QuadTree*)_quadTree)->Fold(getNode, GetAddressForNodeCenter(rasterPoint, maxTreeHeight));
-        const bool result = qnode && pred( static_cast<const MemoryMapDataPtr&>(qnode->GetData()) );
-        got = localCache.insert({rasterPoint, result}).first;
+
+  // rays in a batch usually fan out from the robot, so they share most of the leaves near the start. Evaluate
+  // each leaf once for the whole batch
+  std::unordered_map<const QuadTreeNode*, bool> leafCache;
+  auto evaluateLeaf = [&](const QuadTreeNode* leaf) {
+    auto got = leafCache.find(leaf);
+    if ( got == leafCache.end() ) {
+      got = leafCache.emplace(leaf, leafPred(*leaf)).first;
+    }
+    return got->second;
+  };
+
+  const AxisAlignedQuad& rootBox = _quadTree->GetBoundingBox();
+
+  for ( size_t rayIdx = 0; rayIdx < ends.size(); ++rayIdx )
+  {
+    const float dx = ends[rayIdx].x() - start.x();
+    const float dy = ends[rayIdx].y() - start.y();
+    const float length = std::sqrt(dx*dx + dy*dy);
+
+    // degenerate ray, just check the start point
+    if ( length < kRayStep_mm ) {
+      const QuadTreeNode* leaf = _quadTree->GetLeafAt(start);
+      results[rayIdx] = (leaf != nullptr) && evaluateLeaf(leaf);
+      continue;
+    }
+
+    // only walk the part of the ray inside the tree
+    float tEnter = 0.f;
+    float tLeave = 1.f;
+    if ( !ClipRayToBox(start, dx, dy, rootBox, tEnter, tLeave) ) {
+      continue;
+    }
+
+    // nudge past each node's edge so the next lookup lands in the neighbor
+    const float tStep = kRayStep_mm / length;
+    float t = tEnter;
+    while ( t <= tLeave )
+    {
+      const QuadTreeNode* leaf = _quadTree->GetLeafAt( Point2f{start.x() + dx*t, start.y() + dy*t} );
+      if ( leaf == nullptr ) {
+        break;
       }
-      if(got->second) {
+
+      if ( evaluateLeaf(leaf) ) {
         results[rayIdx] = true;
         break; // skip computing the rest of the ray
       }
-      bresIter.Next();
+
+      // jump to where the ray exits this leaf
+      float tInLeaf  = t;
+      float tOutLeaf = tLeave;
+      ClipRayToBox(start, dx, dy, leaf->GetBoundingBox(), tInLeaf, tOutLeaf);
+      t = std::max(t, tOutLeaf) + tStep;
     }
   }
   return results;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool>
+QuadTreeProcessor::AnyOfRays( const Point2f& start, 
+                              const std::vector<Point2f>& ends, 
+                              const NodePredicate& pred) const
+{
+  return CastRays(start, ends, [&pred](const QuadTreeNode& leaf) {
+    return pred( static_cast<const MemoryMapDataPtr&>(leaf.GetData()) );
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool>
+QuadTreeProcessor::AnyOfRays( const Point2f& start,
+                              const std::vector<Point2f>& ends,
+                              EContentTypePackedType types) const
+{
+  return CastRays(start, ends, [types](const QuadTreeNode& leaf) {
+    return IsInEContentTypePackedType( static_cast<const MemoryMapDataPtr&>(leaf.GetData())->type, types );
+  });
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeProcessor::NodeSet QuadTreeProcessor::GetNodesToFill(const NodePredicate& innerPred, const NodePredicate& outerPred)
@@ -281,5 +449,37 @@ bool QuadTreeProcessor::IsCached(EContentType contentType)
     }
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTreeProcessor::MayCollide(EContentType contentType)
+{
+  // must match MemoryMapData::IsCollisionType and its overrides
+  switch( contentType ) {
+    case EContentType::ObstacleObservable:
+    case EContentType::ObstacleProx:
+    case EContentType::ObstacleUnrecognized:
+    case EContentType::Cliff:
+    {
+      return true;
+    }
+    case EContentType::Unknown:
+    case EContentType::ClearOfObstacle:
+    case EContentType::ClearOfCliff:
+    case EContentType::InterestingEdge:
+    case EContentType::NotInterestingEdge:
+    case EContentType::_Count:
+    {
+      return false;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTreeProcessor::AlwaysCollides(EContentType contentType)
+{
+  // observable objects and prox obstacles can become non-colliding without changing type
+  return (contentType == EContentType::ObstacleUnrecognized) || (contentType == EContentType::Cliff);
+}
+
 } // namespace Vector
 } // namespace Anki
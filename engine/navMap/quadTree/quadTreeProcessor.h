@@ -18,10 +18,12 @@
 #include "engine/navMap/quadTree/quadTreeTypes.h"
 #include "engine/navMap/memoryMap/memoryMapTypes.h"
 #include "engine/navMap/memoryMap/data/memoryMapData.h"
+#include "engine/navMap/memoryMap/collisionGrid.h"
 
 #include "util/helpers/templateHelpers.h"
 #include "coretech/common/engine/math/fastPolygon2d.h"
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
@@ -75,8 +77,36 @@ public:
   // returns true if there are any nodes of the given type, false otherwise
   bool HasContentType(EContentType type) const;
 
-  // multi-ray based collision checking optimization with memoization of result point info
+  // multi-ray based collision checking. Each ray is walked leaf to leaf (instead of cell by cell), and the
+  // predicate is evaluated at most once per leaf for the whole batch
   std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const;
+
+  // same as above, but checks leaf content types against the given set directly instead of calling a predicate
+  std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, EContentTypePackedType types) const;
+
+  // rasterized footprint of all nodes that can be collisions, for quick (conservative) collision checks
+  const CollisionGrid& GetCollisionGrid() const { return _collisionGrid; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Change journal
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // version of the last recorded node change. Increases every time any node's content changes or a node is destroyed
+  uint32_t GetChangeVersion() const { return _changeVersion; }
+
+  // returns false if changes after sinceVersion are no longer fully recorded (caller needs a full snapshot instead).
+  // Otherwise calls func with the center and side length of every node that changed after sinceVersion. The node may
+  // no longer exist, or no longer be a leaf, so callers need to look up its current state
+  using NodeChangeFunc = std::function<void (const Point2f& center, float sideLen)>;
+  bool GetChangesSince(uint32_t sinceVersion, const NodeChangeFunc& func) const;
+
+  // forget changes up to (and including) the given version, once all consumers have seen them
+  void TrimChangeJournal(uint32_t upToVersion);
+
+  // the journal is only kept while someone consumes it. While disabled, only the version is bumped on changes, so a
+  // consumer that enables it later sees a gap and falls back to a full snapshot
+  void SetChangeJournalEnabled(bool enabled);
+  bool IsChangeJournalEnabled() const { return _changeJournalEnabled; }
  
 private:
 
@@ -85,6 +115,14 @@ private:
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   using NodeSet = std::unordered_set<const QuadTreeNode*>;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Ray casting
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // shared implementation of AnyOfRays. leafPred is called with a leaf node, and is only instantiated in the .cpp
+  template <typename LeafPredicate>
+  std::vector<bool> CastRays(const Point2f& start, const std::vector<Point2f>& ends, const LeafPredicate& leafPred) const;
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Query
@@ -95,12 +133,31 @@ private:
   
   // true if we have a need to cache the given content type, false otherwise
   static bool IsCached(EContentType contentType);
+
+  // add the node to the change journal
+  void RecordChange(const QuadTreeNode* node);
+
+  // true if nodes of the given content type may (or always do) return true for IsCollisionType
+  static bool MayCollide(EContentType contentType);
+  static bool AlwaysCollides(EContentType contentType);
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Attributes
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
   using NodeSetPerType = std::unordered_map<EContentType, NodeSet, Anki::Util::EnumHasher>;
+
+  // nodes are identified in the journal by their geometry, since node pointers don't outlive subdivision/merging
+  struct NodeKey {
+    float x, y, sideLen;
+    bool operator==(const NodeKey& other) const { return (x == other.x) && (y == other.y) && (sideLen == other.sideLen); }
+  };
+  struct NodeKeyHasher {
+    size_t operator()(const NodeKey& k) const {
+      return std::hash<float>()(k.x) ^ (std::hash<float>()(k.y) << 1) ^ (std::hash<float>()(k.sideLen) << 2);
+    }
+  };
+  using ChangeJournal = std::unordered_map<NodeKey, uint32_t, NodeKeyHasher>;
   
   // cache of nodes/quads classified per type for faster processing
   NodeSetPerType _nodeSets;
@@ -113,6 +170,15 @@ private:
   
   // area of all quads that are currently interesting edges
   double _totalInterestingEdgeArea_m2;
+
+  // footprint of nodes that may collide, tracked by content type
+  CollisionGrid _collisionGrid;
+
+  // latest change version per node, and the oldest version after which the journal is complete
+  ChangeJournal _changeJournal;
+  uint32_t      _changeVersion;
+  uint32_t      _journalStartVersion;
+  bool          _changeJournalEnabled;
 }; // class
   
 } // namespace
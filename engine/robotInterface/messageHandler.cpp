@@ -83,47 +83,13 @@ Result MessageHandler::ProcessMessages()
       return result;
     }
 
+    // Each PopData() hands the previous message's buffer back to the connection manager's pool
     std::vector<uint8_t> nextData;
     while (_robotConnectionManager->PopData(nextData))
     {
-      ++_messageCountRobotToEngine;
-
-      // If we don't have a robot to care about this message, throw it away
-      Robot* destRobot = _robotManager->GetRobot();
-      if (nullptr == destRobot)
-      {
-        continue;
-      }
-
-      const size_t dataSize = nextData.size();
-      if (dataSize <= 0)
-      {
-        PRINT_NAMED_ERROR("MessageHandler.ProcessMessages","Tried to process message of invalid size");
-        continue;
-      }
-
-      // see if message type should be filtered out based on potential firmware mismatch
-      const RobotInterface::RobotToEngineTag msgType = static_cast<RobotInterface::RobotToEngineTag>(nextData.data()[0]);
-      if (_robotManager->ShouldFilterMessage(msgType)) {
-        continue;
-      }
-
-      RobotInterface::RobotToEngine message;
-      const size_t unpackSize = message.Unpack(nextData.data(), dataSize);
-      if (unpackSize != nextData.size()) {
-        PRINT_NAMED_ERROR("RobotMessageHandler.MessageUnpack", "Message unpack error, tag %s expecting %zu but have %zu",
-                          RobotToEngineTagToString(msgType), unpackSize, dataSize);
-        continue;
-      }
-
-      #if ANKI_DEV_CHEATS
-      if (nullptr != DevLoggingSystem::GetInstance())
-      {
-        DevLoggingSystem::GetInstance()->LogMessage(message);
-      }
-      #endif
-      Broadcast(std::move(message));
+      HandleRawMessage(nextData.data(), nextData.size());
     }
+    _robotConnectionManager->ReleaseData(std::move(nextData));
 
     #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
     _robotConnectionManager->UpdateSocketBufferStats();
@@ -134,6 +100,46 @@ Result MessageHandler::ProcessMessages()
   return RESULT_OK;
 }
 
+void MessageHandler::HandleRawMessage(const uint8_t* data, size_t dataSize)
+{
+  ++_messageCountRobotToEngine;
+
+  // If we don't have a robot to care about this message, throw it away
+  Robot* destRobot = _robotManager->GetRobot();
+  if (nullptr == destRobot)
+  {
+    return;
+  }
+
+  if (dataSize <= 0)
+  {
+    PRINT_NAMED_ERROR("MessageHandler.ProcessMessages","Tried to process message of invalid size");
+    return;
+  }
+
+  // see if message type should be filtered out based on potential firmware mismatch
+  const RobotInterface::RobotToEngineTag msgType = static_cast<RobotInterface::RobotToEngineTag>(data[0]);
+  if (_robotManager->ShouldFilterMessage(msgType)) {
+    return;
+  }
+
+  RobotInterface::RobotToEngine message;
+  const size_t unpackSize = message.Unpack(data, dataSize);
+  if (unpackSize != dataSize) {
+    PRINT_NAMED_ERROR("RobotMessageHandler.MessageUnpack", "Message unpack error, tag %s expecting %zu but have %zu",
+                      RobotToEngineTagToString(msgType), unpackSize, dataSize);
+    return;
+  }
+
+  #if ANKI_DEV_CHEATS
+  if (nullptr != DevLoggingSystem::GetInstance())
+  {
+    DevLoggingSystem::GetInstance()->LogMessage(message);
+  }
+  #endif
+  Broadcast(std::move(message));
+}
+
 Result MessageHandler::SendMessage(const RobotInterface::EngineToRobot& msg, bool reliable, bool hot)
 {
   ++_messageCountEngineToRobot;
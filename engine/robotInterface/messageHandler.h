@@ -56,6 +56,10 @@ public:
 
   virtual Result ProcessMessages();
 
+  // Unpacks one packed RobotToEngine message and broadcasts it to subscribers, as if it had just been received from the
+  // robot. Called for each message ProcessMessages receives, and by tools that replay recorded messages.
+  void HandleRawMessage(const uint8_t* data, size_t dataSize);
+
   virtual Result SendMessage(const RobotInterface::EngineToRobot& msg, bool reliable = true, bool hot = false);
 
   Signal::SmartHandle Subscribe(const RobotInterface::RobotToEngineTag& tagType, std::function<void(const AnkiEvent<RobotInterface::RobotToEngine>&)> messageHandler) {
@@ -15,6 +15,8 @@
 #include "util/logging/logging.h"
 #include "util/math/math.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "RobotStateHistory"
 
 #define DEBUG_ROBOT_POSE_HISTORY 0
@@ -168,6 +170,124 @@ namespace Anki {
       return interpHistState;
     }
     
+    /////////////////////// StateBuffer /////////////////////////////
+    
+    namespace {
+      // Enough for the default 3s window at robot state rate, so the buffer does not normally need to grow
+      constexpr size_t kInitialStateBufferCapacity = 256;
+      static_assert((kInitialStateBufferCapacity & (kInitialStateBufferCapacity - 1)) == 0, "StateBuffer capacity must be a power of two");
+    }
+    
+    RobotStateHistory::StateBuffer::StateBuffer()
+    : _entries(kInitialStateBufferCapacity)
+    , _head(0)
+    , _size(0)
+    {
+      
+    }
+    
+    template<typename Pred>
+    size_t RobotStateHistory::StateBuffer::PartitionPoint(size_t lo, size_t hi, const Pred& isAfter) const
+    {
+      while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (isAfter((*this)[mid])) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      return lo;
+    }
+    
+    size_t RobotStateHistory::StateBuffer::LowerBound(const RobotTimeStamp_t t) const
+    {
+      if (empty() || t <= front().first) {
+        return 0;
+      }
+      if (t > back().first) {
+        return _size;
+      }
+      
+      // States arrive at a roughly fixed rate, so interpolating between the oldest and newest timestamps almost
+      // always lands on (or right next to) the answer. Otherwise, fall back to a binary search on the correct side.
+      const TimeStamp_t span = (TimeStamp_t)(back().first - front().first);
+      const size_t guess = std::min(_size - 1, (size_t)((u64)(TimeStamp_t)(t - front().first) * (_size - 1) / span));
+      
+      size_t lo = 0;
+      size_t hi = _size;
+      if ((*this)[guess].first < t) {
+        lo = guess + 1;
+        if ((*this)[lo].first >= t) {
+          return lo;
+        }
+      } else {
+        hi = guess;
+        if ((*this)[hi - 1].first < t) {
+          return hi;
+        }
+      }
+      
+      return PartitionPoint(lo, hi, [t](const Entry& entry) { return entry.first >= t; });
+    }
+    
+    size_t RobotStateHistory::StateBuffer::UpperBoundFrameID(const PoseFrameID_t frameID) const
+    {
+      return PartitionPoint(0, _size, [frameID](const Entry& entry) { return entry.second.GetFrameId() > frameID; });
+    }
+    
+    bool RobotStateHistory::StateBuffer::Insert(const RobotTimeStamp_t t, const HistRobotState& state)
+    {
+      // Common case: newer than everything else
+      if (empty() || t > back().first) {
+        if (_size == _entries.size()) {
+          Grow();
+        }
+        Entry& entry = (*this)[_size];
+        entry.first = t;
+        entry.second = state;
+        ++_size;
+        return true;
+      }
+      
+      const size_t idx = LowerBound(t);
+      if ((*this)[idx].first == t) {
+        return false;
+      }
+      
+      // Out of order: shift newer entries back by one to make room
+      if (_size == _entries.size()) {
+        Grow();
+      }
+      for (size_t i = _size; i > idx; --i) {
+        (*this)[i] = std::move((*this)[i-1]);
+      }
+      Entry& entry = (*this)[idx];
+      entry.first = t;
+      entry.second = state;
+      ++_size;
+      return true;
+    }
+    
+    void RobotStateHistory::StateBuffer::PopFront(const size_t n)
+    {
+      const size_t numToPop = std::min(n, _size);
+      _head = (_head + numToPop) & (_entries.size() - 1);
+      _size -= numToPop;
+    }
+    
+    void RobotStateHistory::StateBuffer::Grow()
+    {
+      std::vector<Entry> entries(2 * _entries.size());
+      for (size_t i = 0; i < _size; ++i) {
+        entries[i] = std::move((*this)[i]);
+      }
+      _entries.swap(entries);
+      _head = 0;
+      
+      LOG_INFO("RobotStateHistory.StateBuffer.Grow", "Grew raw state buffer to %zu entries", _entries.size());
+    }
+    
     /////////////////////// RobotStateHistory /////////////////////////////
     
     HistStateKey RobotStateHistory::currHistStateKey_ = 0;
@@ -203,7 +323,7 @@ namespace Anki {
     {
       if (!_states.empty())
       {
-        RobotTimeStamp_t newestTime = _states.rbegin()->first;
+        RobotTimeStamp_t newestTime = _states.back().first;
         if (newestTime > _windowSize_ms && t < newestTime - _windowSize_ms) {
           LOG_WARNING("RobotStateHistory.AddRawOdomState.TimeTooOld", "newestTime %u, oldestAllowedTime %u, t %u",
                       (TimeStamp_t)newestTime, (TimeStamp_t)(newestTime - _windowSize_ms), (TimeStamp_t)t);
@@ -218,10 +338,7 @@ namespace Anki {
         return RESULT_FAIL;
       }
       
-      std::pair<StateMapIter_t, bool> res;
-      res = _states.emplace(t, state);
-
-      if (!res.second) {
+      if (!_states.Insert(t, state)) {
         LOG_WARNING("RobotStateHistory.AddRawOdomState.AddFailed", "Time: %u", (TimeStamp_t)t);
         return RESULT_FAIL;
       }
@@ -243,7 +360,7 @@ namespace Anki {
 
       // Check if the pose's timestamp is too old.
       if (!_states.empty()) {
-        RobotTimeStamp_t newestTime = _states.rbegin()->first;
+        RobotTimeStamp_t newestTime = _states.back().first;
         if (newestTime > _windowSize_ms && t < newestTime - _windowSize_ms) {
           LOG_ERROR("RobotStateHistory.AddVisionOnlyState.TooOld",
                     "Pose at t=%d too old to add. Newest time=%d, windowSize=%d",
@@ -319,30 +436,29 @@ namespace Anki {
                                                         RobotTimeStamp_t&    t_after,
                                                         HistRobotState& state_after)
     {
-      // Get the iterator for time t
-      const_StateMapIter_t it = _states.lower_bound(t);
+      // Get the index for time t
+      const size_t idx = _states.LowerBound(t);
       
-      if (it == _states.begin() || it == _states.end() || t < _states.begin()->first) {
+      if (idx == 0 || idx >= _states.size()) {
         return RESULT_FAIL;
       }
 
-      // Get iterator to pose just before t
-      const_StateMapIter_t prev_it = it;
-      --prev_it;
+      // Get pose just before t
+      const auto& prev = _states[idx-1];
       
-      t_before = prev_it->first;
-      state_before = prev_it->second;
+      t_before = prev.first;
+      state_before = prev.second;
       
-      // Get iterator to pose just after t
-      const_StateMapIter_t next_it = it;
-      ++next_it;
+      // Get pose just after t
+      const size_t nextIdx = idx + 1;
       
-      if (next_it == _states.end()) {
+      if (nextIdx >= _states.size()) {
         return RESULT_FAIL;
       }
       
-      t_after = next_it->first;
-      state_after = next_it->second;
+      const auto& next = _states[nextIdx];
+      t_after = next.first;
+      state_after = next.second;
       
       return RESULT_OK;
     }
@@ -356,22 +472,22 @@ namespace Anki {
                                             bool withInterpolation) const
     {
       // This pose occurs at or immediately after t_request
-      const_StateMapIter_t it = _states.lower_bound(t_request);
+      const size_t idx = _states.LowerBound(t_request);
       
       // Check if in range
-      if (it == _states.end() || t_request < _states.begin()->first) {
+      if (idx == _states.size() || t_request < _states.front().first) {
         return RESULT_FAIL;
       }
       
+      const auto* it = &_states[idx];
       if (t_request == it->first) {
         // If the exact timestamp was found, return the corresponding pose.
         t = it->first;
         state = it->second;
       } else {
 
-        // Get iterator to the pose just before t_request
-        const_StateMapIter_t prev_it = it;
-        --prev_it;
+        // Get the pose just before t_request
+        const auto* prev_it = &_states[idx-1];
 
         // Check for same frameId
         // (Shouldn't interpolate between poses from different frameIDs)
@@ -443,12 +559,12 @@ namespace Anki {
 
     Result RobotStateHistory::UpdateProxSensorData(const RobotTimeStamp_t t, const ProxSensorData& data)
     {
-      StateMapIter_t it = _states.find(t); 
-      if (it == _states.end()) {
+      const size_t idx = _states.LowerBound(t);
+      if (idx == _states.size() || _states[idx].first != t) {
         return RESULT_FAIL;
       }
       
-      HistRobotState& state = it->second;
+      HistRobotState& state = _states[idx].second;
       state.SetProxSensorData(data);
 
       return RESULT_OK;
@@ -527,7 +643,8 @@ namespace Anki {
       
       // git now points to the latest vision-based pose that exists before time t.
       // Now get the pose in _states that immediately follows the vision-based pose's time.
-      const_StateMapIter_t p0_it = _states.lower_bound(git->first);
+      const size_t p0Idx = _states.LowerBound(git->first);
+      const auto* p0_it = &_states[p0Idx];
 
       #if (DEBUG_ROBOT_POSE_HISTORY)
       if (printDbg) {
@@ -554,10 +671,12 @@ namespace Anki {
       }
       else
       {
-        const_StateMapIter_t pMid0 = p0_it;
-        const_StateMapIter_t pMid1 = p0_it;
-        for (pMid1 = p0_it; pMid1 != _states.end(); ++pMid1)
+        size_t pMid0Idx = p0Idx;
+        for (size_t pMid1Idx = p0Idx; pMid1Idx < _states.size(); ++pMid1Idx)
         {
+          const auto* pMid0 = &_states[pMid0Idx];
+          const auto* pMid1 = &_states[pMid1Idx];
+          
           // Bump pMid1 forward until it hits the next frame ID
           if (pMid1->second.GetFrameId() > pMid0->second.GetFrameId())
           {
@@ -568,7 +687,7 @@ namespace Anki {
             
             // We expect the beginning (pMid0) and end (pMid1) of this part of history
             // to have the same frame ID and origin.
-            --pMid1; // (temporarily) move back to last pose in same frame as pMid0
+            pMid1 = &_states[pMid1Idx-1]; // (temporarily) move back to last pose in same frame as pMid0
             DEV_ASSERT(pMid0->second.GetFrameId() == pMid1->second.GetFrameId(),
                        "RobotStateHistory.ComputeStateAt.MismatchedIntermediateFrameIDs");
             DEV_ASSERT(pMid0->second.GetPose().HasSameRootAs(pMid1->second.GetPose()),
@@ -589,8 +708,8 @@ namespace Anki {
             pTransform.PreComposeWith(pMidTransform);
             
             // Move both pointers to start of next pose frame to begin process again
-            ++pMid1;
-            pMid0 = pMid1;
+            pMid1 = &_states[pMid1Idx];
+            pMid0Idx = pMid1Idx;
           }
        
           if (pMid1->second.GetFrameId() == state1.GetFrameId())
@@ -726,38 +845,31 @@ namespace Anki {
         return RESULT_FAIL;
       }
       
-      // First look through "raw" poses for the frame ID. We don't need to look
-      // any further once the frameID drops below the one we are looking for,
-      // because they are ordered
-      bool found = false;
-      auto poseIter = _states.rend();
-      for (poseIter = _states.rbegin();
-          poseIter != _states.rend() && poseIter->second.GetFrameId() >= frameID; ++poseIter )
-      {
-        if (poseIter->second.GetFrameId() == frameID) {
-          found = true; // break out of the loop without incrementing poseIter
-          break;
-        }
+      // First look through "raw" poses for the frame ID. They are ordered by frame ID,
+      // so the last one with the frame ID is right before the first one with a larger ID
+      const HistRobotState* foundState = nullptr;
+      const size_t upperIdx = _states.UpperBoundFrameID(frameID);
+      if (upperIdx > 0 && _states[upperIdx-1].second.GetFrameId() == frameID) {
+        foundState = &_states[upperIdx-1].second;
       }
       
-      // NOTE: this second loop over vision poses will only occur if found is still false,
-      // meaning we didn't find a pose already in the first loop.
-      if (!found) {
-        for (poseIter = _visStates.rbegin();
+      // NOTE: this loop over vision poses will only occur if we didn't find a raw pose already.
+      // We don't need to look any further once the frameID drops below the one we are looking for,
+      // because they are ordered
+      if (foundState == nullptr) {
+        for (auto poseIter = _visStates.rbegin();
             poseIter != _visStates.rend() && poseIter->second.GetFrameId() >= frameID; ++poseIter)
         {
           if (poseIter->second.GetFrameId() == frameID) {
-            found = true;
+            foundState = &poseIter->second;
             break;
           }
         }
       }
       
-      if (found) {
+      if (foundState != nullptr) {
         // Success!
-        DEV_ASSERT(poseIter != _states.rend(),
-                   "RobotStateHistory.GetLastStateWithFrameID.InvalidIter");
-        state = poseIter->second;
+        state = *foundState;
         return RESULT_OK;
         
       } else {
@@ -766,10 +878,10 @@ namespace Anki {
                  "(First frameID in pose history is %d (t:%u), last is %d (t:%u). "
                  "First frameID in vis pose history is %d (t:%u), last is %d (t:%u).)",
                  frameID,
-                 _states.begin()->second.GetFrameId(),
-                 (TimeStamp_t)_states.begin()->first,
-                 _states.rbegin()->second.GetFrameId(),
-                 (TimeStamp_t)_states.rbegin()->first,
+                 _states.front().second.GetFrameId(),
+                 (TimeStamp_t)_states.front().first,
+                 _states.back().second.GetFrameId(),
+                 (TimeStamp_t)_states.back().first,
                  (_visStates.empty() ? -1 : _visStates.begin()->second.GetFrameId()),
                  (TimeStamp_t)(_visStates.empty() ? 0 : _visStates.begin()->first),
                  (_visStates.empty() ? -1 : _visStates.rbegin()->second.GetFrameId()),
@@ -783,20 +895,10 @@ namespace Anki {
 
     u32 RobotStateHistory::GetNumRawStatesWithFrameID(const PoseFrameID_t frameID) const
     {
-      // First look through "raw" poses for the frame ID. We don't need to look
-      // any further once the frameID drops below the one we are looking for,
-      // because they are ordered
-      u32 cnt = 0;
-      for (auto poseIter = _states.rbegin(); poseIter != _states.rend(); ++poseIter )
-      {
-        auto currFrameId = poseIter->second.GetFrameId();
-        if (currFrameId == frameID) {
-          ++cnt;
-        } else if (currFrameId < frameID) {
-          break;
-        }
-      }
-      return cnt;
+      // Raw poses are ordered by frame ID, so all the ones with this frame ID are contiguous
+      const size_t upperIdx = _states.UpperBoundFrameID(frameID);
+      const size_t lowerIdx = (frameID > 0) ? _states.UpperBoundFrameID(frameID - 1) : 0;
+      return (u32)(upperIdx - lowerIdx);
     }
     
     void RobotStateHistory::CullToWindowSize()
@@ -804,7 +906,7 @@ namespace Anki {
       if (_states.size() > 1) {
         
         // Get the most recent timestamp
-        RobotTimeStamp_t mostRecentTime = _states.rbegin()->first;
+        RobotTimeStamp_t mostRecentTime = _states.back().first;
         
         // If most recent time is less than window size, we're done.
         if (mostRecentTime < _windowSize_ms) {
@@ -813,14 +915,14 @@ namespace Anki {
         
         // Get pointer to the oldest timestamp that may remain in the map
         RobotTimeStamp_t oldestAllowedTime = mostRecentTime - _windowSize_ms;
-        const auto it = _states.lower_bound(oldestAllowedTime);
+        const size_t numStatesToCull = _states.LowerBound(oldestAllowedTime);
         const auto git = _visStates.lower_bound(oldestAllowedTime);
         const auto cit = _computedStates.lower_bound(oldestAllowedTime);
         const auto keyByTs_it = _keyByTsMap.lower_bound(oldestAllowedTime);
         
         // Delete everything before the oldest allowed timestamp
-        if (!_states.empty() && it != _states.begin()) {
-          _states.erase(_states.begin(), it);
+        if (numStatesToCull > 0) {
+          _states.PopFront(numStatesToCull);
           
           if (_states.empty())
           {
@@ -867,12 +969,12 @@ namespace Anki {
     
     RobotTimeStamp_t RobotStateHistory::GetOldestTimeStamp() const
     {
-      return (_states.empty() ? 0 : _states.begin()->first);
+      return (_states.empty() ? 0 : _states.front().first);
     }
     
     RobotTimeStamp_t RobotStateHistory::GetNewestTimeStamp() const
     {
-      return (_states.empty() ? 0 : _states.rbegin()->first);
+      return (_states.empty() ? 0 : _states.back().first);
     }
 
     RobotTimeStamp_t RobotStateHistory::GetOldestVisionOnlyTimeStamp() const
@@ -888,26 +990,25 @@ namespace Anki {
     void RobotStateHistory::Print() const
     {
       // Create merged map of all poses
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> > mergedPoses;
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> >::iterator mergedIt;
-      const_StateMapIter_t pit;
+      std::multimap<TimeStamp_t, std::pair<std::string, const HistRobotState*> > mergedPoses;
+      std::multimap<TimeStamp_t, std::pair<std::string, const HistRobotState*> >::iterator mergedIt;
       
-      for (pit = _states.begin(); pit != _states.end(); ++pit) {
+      for (size_t i = 0; i < _states.size(); ++i) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("  ", pit));
+                            std::forward_as_tuple(_states[i].first),
+                            std::forward_as_tuple("  ", &_states[i].second));
       }
 
-      for (pit = _visStates.begin(); pit != _visStates.end(); ++pit) {
+      for (const_StateMapIter_t pit = _visStates.begin(); pit != _visStates.end(); ++pit) {
         mergedPoses.emplace(std::piecewise_construct,
                             std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("v ", pit));
+                            std::forward_as_tuple("v ", &pit->second));
       }
 
-      for (pit = _computedStates.begin(); pit != _computedStates.end(); ++pit) {
+      for (const_StateMapIter_t pit = _computedStates.begin(); pit != _computedStates.end(); ++pit) {
         mergedPoses.emplace(std::piecewise_construct,
                             std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("c ", pit));
+                            std::forward_as_tuple("c ", &pit->second));
       }
       
       
@@ -915,7 +1016,7 @@ namespace Anki {
       printf("================\n");
       for (mergedIt = mergedPoses.begin(); mergedIt != mergedPoses.end(); ++mergedIt) {
         printf("%s%d: ", mergedIt->second.first.c_str(), mergedIt->first);
-        mergedIt->second.second->second.Print();
+        mergedIt->second.second->Print();
       }
     }
     
@@ -21,6 +21,9 @@
 #include "engine/robotComponents_fwd.h"
 #include "util/helpers/templateHelpers.h"
 
+#include <map>
+#include <vector>
+
 namespace Anki {
   namespace Vector {
     
@@ -229,16 +232,68 @@ namespace Anki {
       
       typedef std::map<RobotTimeStamp_t, HistRobotState> StateMap_t;
       
-      const StateMap_t& GetRawStates() const { return _states; }
-      
     private:
       
+      /*
+       * StateBuffer
+       *
+       * Time-ordered ring buffer of raw states. Raw states arrive at robot-state rate with (almost always)
+       * increasing timestamps and are culled from the front, so a contiguous ring avoids the per-state node
+       * allocation of a map, and lookups can use the near-uniform spacing of timestamps to find an entry in
+       * O(1) in the common case. Capacity only grows (doubling) if the time window holds more states than fit.
+       * Note that entries can move on insertion, so no pointers to them are handed out.
+       */
+      class StateBuffer
+      {
+      public:
+        using Entry = std::pair<RobotTimeStamp_t, HistRobotState>;
+        
+        StateBuffer();
+        
+        bool   empty() const { return (_size == 0); }
+        size_t size()  const { return _size; }
+        void   clear()       { _head = 0; _size = 0; }
+        
+        // Entries by position, oldest first
+        const Entry& operator[](size_t i) const { return _entries[(_head + i) & (_entries.size() - 1)]; }
+        Entry&       operator[](size_t i)       { return _entries[(_head + i) & (_entries.size() - 1)]; }
+        const Entry& front() const { return (*this)[0]; }
+        const Entry& back()  const { return (*this)[_size - 1]; }
+        
+        // Index of the first entry with time >= t, or size() if there is none
+        size_t LowerBound(const RobotTimeStamp_t t) const;
+        
+        // Index of the first entry with a frame ID greater than frameID, or size() if there is none.
+        // Relies on frame IDs being non-decreasing with time.
+        size_t UpperBoundFrameID(const PoseFrameID_t frameID) const;
+        
+        // Inserts in time order. Returns false if there already is an entry at time t.
+        bool Insert(const RobotTimeStamp_t t, const HistRobotState& state);
+        
+        // Drops the oldest n entries
+        void PopFront(const size_t n);
+        
+      private:
+        
+        // Index of the first entry in [lo, hi) for which isAfter is true, assuming it is false for all entries
+        // before that one and true for all after
+        template<typename Pred>
+        size_t PartitionPoint(size_t lo, size_t hi, const Pred& isAfter) const;
+        
+        void Grow();
+        
+        // Power-of-two sized storage, with _size valid entries starting at _head
+        std::vector<Entry> _entries;
+        size_t _head;
+        size_t _size;
+      };
+      
       void CullToWindowSize();
       
       // Pose history as reported by robot
       using StateMapIter_t = StateMap_t::iterator;
       using const_StateMapIter_t = StateMap_t::const_iterator;
-      StateMap_t _states;
+      StateBuffer _states;
 
       // Map of timestamps of vision-based poses as computed from mat markers
       StateMap_t _visStates;
@@ -0,0 +1,350 @@
+/**
+ * File: devLogBlockFormatTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for the dev log block format: LZ4 round trips around the format's edge cases, rejection of
+ *              malformed LZ4 input, and encoding and decoding whole blocks.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/debug/devLogBlockFormat.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  std::vector<uint8_t> ToBytes(const std::string& str)
+  {
+    return std::vector<uint8_t>(str.begin(), str.end());
+  }
+
+  std::vector<uint8_t> RandomBytes(size_t size, std::mt19937& rng)
+  {
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::vector<uint8_t> bytes(size);
+    for (auto& byte : bytes) {
+      byte = static_cast<uint8_t>(byteDist(rng));
+    }
+    return bytes;
+  }
+
+  std::string Compress(const std::vector<uint8_t>& src)
+  {
+    std::string compressed;
+    DevLogBlockFormat::CompressLZ4(src.data(), src.size(), compressed);
+    return compressed;
+  }
+
+  bool Decompress(const std::vector<uint8_t>& src, size_t dstSize, std::vector<uint8_t>& dst)
+  {
+    dst.assign(dstSize, 0);
+    return DevLogBlockFormat::DecompressLZ4(src.data(), src.size(), dst.data(), dst.size());
+  }
+
+  ::testing::AssertionResult RoundTrips(const std::vector<uint8_t>& src)
+  {
+    const auto compressed = ToBytes(Compress(src));
+    std::vector<uint8_t> decompressed;
+    if (!Decompress(compressed, src.size(), decompressed)) {
+      return ::testing::AssertionFailure() << "failed to decompress " << src.size() << " bytes";
+    }
+    if (decompressed != src) {
+      return ::testing::AssertionFailure() << "decompressed " << src.size() << " bytes differ";
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+  // Walks a well formed LZ4 block and returns the offsets of all its matches
+  std::vector<size_t> MatchOffsets(const std::string& compressed)
+  {
+    std::vector<size_t> offsets;
+    const auto* ip = reinterpret_cast<const uint8_t*>(compressed.data());
+    const auto* const ipEnd = ip + compressed.size();
+    auto readLength = [&ip](size_t length) {
+      uint8_t byte = 255;
+      while (byte == 255) {
+        byte = *ip++;
+        length += byte;
+      }
+      return length;
+    };
+
+    while (ip < ipEnd) {
+      const uint8_t token = *ip++;
+      size_t numLiterals = token >> 4;
+      if (numLiterals == 15) {
+        numLiterals = readLength(numLiterals);
+      }
+      ip += numLiterals;
+      if (ip >= ipEnd) {
+        break;
+      }
+      offsets.push_back(ip[0] | (ip[1] << 8));
+      ip += 2;
+      if ((token & 0x0F) == 15) {
+        readLength(15);
+      }
+    }
+    return offsets;
+  }
+
+}
+
+TEST(DevLogBlockFormat, LZ4Empty)
+{
+  // Just a token with no literals
+  const std::string compressed = Compress({});
+  EXPECT_EQ(std::string(1, '\0'), compressed);
+
+  std::vector<uint8_t> decompressed;
+  EXPECT_TRUE(Decompress(ToBytes(compressed), 0, decompressed));
+}
+
+// The last match has to start at least 12 bytes before the end, so anything this short is stored as one literal run
+TEST(DevLogBlockFormat, LZ4ShorterThanMatchLimit)
+{
+  for (size_t size = 1; size <= 12; ++size) {
+    const std::vector<uint8_t> src(size, 'a');
+    const std::string compressed = Compress(src);
+    ASSERT_EQ(1 + size, compressed.size()) << size;
+    EXPECT_EQ(static_cast<char>(size << 4), compressed[0]) << size;
+    EXPECT_TRUE(RoundTrips(src)) << size;
+  }
+
+  // The first size that can have a match
+  EXPECT_LT(Compress(std::vector<uint8_t>(13, 'a')).size(), 13u);
+  EXPECT_TRUE(RoundTrips(std::vector<uint8_t>(13, 'a')));
+}
+
+// Long runs need lengths continued in extra bytes, for both literals and matches
+TEST(DevLogBlockFormat, LZ4LongRuns)
+{
+  std::mt19937 rng(20181016);
+
+  for (const size_t size : {14u, 15u, 19u, 20u, 270u, 274u, 275u, 1000u, 65536u, 300000u}) {
+    // Repeated bytes compress to one long match with an offset of 1
+    const std::vector<uint8_t> repeated(size, 0x5A);
+    EXPECT_TRUE(RoundTrips(repeated)) << size;
+    EXPECT_LT(Compress(repeated).size(), size / 200 + 16) << size;
+
+    // Random bytes won't compress, so they're one long literal run
+    const auto random = RandomBytes(size, rng);
+    EXPECT_TRUE(RoundTrips(random)) << size;
+
+    // A random pattern repeated, so matches have to copy from overlapping output
+    auto pattern = RandomBytes(7, rng);
+    std::vector<uint8_t> patterned;
+    while (patterned.size() < size) {
+      patterned.insert(patterned.end(), pattern.begin(), pattern.end());
+    }
+    patterned.resize(size);
+    EXPECT_TRUE(RoundTrips(patterned)) << size;
+  }
+}
+
+// A random chunk repeated distance bytes later, with runs of zeros in between (which only ever hash to one slot, so
+// the chunk is still in the hash table when it comes around again)
+TEST(DevLogBlockFormat, LZ4OffsetsNearLimit)
+{
+  std::mt19937 rng(42);
+
+  for (const size_t distance : {0xFFFDu, 0xFFFEu, 0xFFFFu, 0x10000u, 0x10001u}) {
+    const auto chunk = RandomBytes(64, rng);
+    std::vector<uint8_t> src(chunk.begin(), chunk.end());
+    src.resize(distance, 0);
+    src.insert(src.end(), chunk.begin(), chunk.end());
+    src.resize(src.size() + 32, 0);
+
+    EXPECT_TRUE(RoundTrips(src)) << distance;
+
+    const auto offsets = MatchOffsets(Compress(src));
+    bool foundDistance = false;
+    for (const size_t offset : offsets) {
+      EXPECT_NE(0u, offset) << distance;
+      foundDistance |= (offset == distance);
+    }
+    // Offsets are 16 bits, so only distances that fit can be matched
+    EXPECT_EQ(distance <= 0xFFFF, foundDistance) << distance;
+  }
+}
+
+TEST(DevLogBlockFormat, LZ4RandomRoundTrips)
+{
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<size_t> sizeDist(0, 5000);
+  std::uniform_int_distribution<int> alphabetDist(1, 256);
+
+  for (int i = 0; i < 500; ++i) {
+    // Small alphabets give lots of short matches
+    const int alphabetSize = alphabetDist(rng);
+    std::uniform_int_distribution<int> byteDist(0, alphabetSize - 1);
+    std::vector<uint8_t> src(sizeDist(rng));
+    for (auto& byte : src) {
+      byte = static_cast<uint8_t>(byteDist(rng));
+    }
+    ASSERT_TRUE(RoundTrips(src)) << "alphabet of " << alphabetSize;
+  }
+}
+
+// Written by hand following the LZ4 block format description, rather than by CompressLZ4
+TEST(DevLogBlockFormat, LZ4DecompressKnownBlock)
+{
+  // 3 literals "abc", then a match of 5 + 4 bytes at offset 3, then 5 final literals
+  const std::vector<uint8_t> compressed{0x35, 'a', 'b', 'c', 0x03, 0x00, 0x50, 'v', 'w', 'x', 'y', 'z'};
+  std::vector<uint8_t> decompressed;
+  ASSERT_TRUE(Decompress(compressed, 17, decompressed));
+  EXPECT_EQ(ToBytes("abcabcabcabcvwxyz"), decompressed);
+
+  // The exact size has to be given
+  EXPECT_FALSE(Decompress(compressed, 16, decompressed));
+  EXPECT_FALSE(Decompress(compressed, 18, decompressed));
+}
+
+TEST(DevLogBlockFormat, LZ4DecompressMalformed)
+{
+  std::vector<uint8_t> dst;
+
+  // Nothing at all, when there should be output
+  EXPECT_FALSE(Decompress({}, 4, dst));
+
+  // Literal length continued in a byte that isn't there
+  EXPECT_FALSE(Decompress({0xF0}, 15, dst));
+
+  // Only one byte of the match offset
+  EXPECT_FALSE(Decompress({0x40, 'a', 'b', 'c', 'd', 0x01}, 8, dst));
+
+  // Match length continued in a byte that isn't there
+  EXPECT_FALSE(Decompress({0x4F, 'a', 'b', 'c', 'd', 0x01, 0x00}, 30, dst));
+
+  // Offset of 0
+  EXPECT_FALSE(Decompress({0x40, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x10, 'e'}, 9, dst));
+
+  // Offsets reaching back before the start of the output
+  EXPECT_FALSE(Decompress({0x40, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x10, 'e'}, 9, dst));
+  EXPECT_FALSE(Decompress({0x00, 0x01, 0x00, 0x10, 'e'}, 5, dst));
+  EXPECT_TRUE(Decompress({0x40, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x10, 'e'}, 9, dst));
+
+  // More literals than the destination has room for
+  EXPECT_FALSE(Decompress({0x50, 'a', 'b', 'c', 'd', 'e'}, 4, dst));
+  EXPECT_FALSE(Decompress({0xF0, 0xFF, 0x10}, 20, dst));
+
+  // More literals than there are bytes left in the input
+  EXPECT_FALSE(Decompress({0x50, 'a', 'b', 'c'}, 5, dst));
+
+  // A match longer than the destination has room for
+  EXPECT_FALSE(Decompress({0x45, 'a', 'b', 'c', 'd', 0x01, 0x00, 0x10, 'e'}, 9, dst));
+}
+
+// Every prefix of a valid block is rejected, and random corruption never reads or writes out of bounds
+TEST(DevLogBlockFormat, LZ4DecompressDamaged)
+{
+  std::mt19937 rng(99);
+  std::uniform_int_distribution<int> byteDist(0, 255);
+
+  std::vector<uint8_t> src;
+  for (int i = 0; i < 200; ++i) {
+    const std::string word = "record " + std::to_string(i % 17) + " ";
+    src.insert(src.end(), word.begin(), word.end());
+  }
+  const auto compressed = ToBytes(Compress(src));
+  ASSERT_LT(compressed.size(), src.size());
+
+  std::vector<uint8_t> dst;
+  for (size_t size = 0; size < compressed.size(); ++size) {
+    const std::vector<uint8_t> truncated(compressed.begin(), compressed.begin() + size);
+    EXPECT_FALSE(Decompress(truncated, src.size(), dst)) << size;
+  }
+
+  std::uniform_int_distribution<size_t> posDist(0, compressed.size() - 1);
+  for (int i = 0; i < 2000; ++i) {
+    auto damaged = compressed;
+    damaged[posDist(rng)] = static_cast<uint8_t>(byteDist(rng));
+    Decompress(damaged, src.size(), dst);
+  }
+}
+
+TEST(DevLogBlockFormat, EncodeDecodeBlock)
+{
+  using namespace DevLogBlockFormat;
+
+  std::mt19937 rng(123);
+  const std::vector<uint8_t> compressible(3000, 0x11);
+  const auto incompressible = RandomBytes(3000, rng);
+
+  struct Case {
+    const std::vector<uint8_t>& records;
+    bool compress;
+    uint16_t expectedFlags;
+  };
+  const std::vector<uint8_t> empty;
+  for (const Case& testCase : {Case{compressible, true, kBlockFlagLZ4},
+                               Case{compressible, false, kBlockFlagNone},
+                               Case{incompressible, true, kBlockFlagNone},
+                               Case{empty, true, kBlockFlagNone}}) {
+    // Appended after whatever is already there
+    std::string out = "prefix";
+    EncodeBlock(testCase.records.data(), testCase.records.size(), 12, 1000, 2000, testCase.compress, out);
+    ASSERT_GE(out.size(), 6 + sizeof(BlockHeader));
+    EXPECT_EQ("prefix", out.substr(0, 6));
+
+    BlockHeader header;
+    memcpy(&header, out.data() + 6, sizeof(header));
+    EXPECT_EQ(kBlockMagic, header.magic);
+    EXPECT_EQ(testCase.expectedFlags, header.flags);
+    EXPECT_EQ(12, header.numRecords);
+    EXPECT_EQ(1000, header.firstTimestamp_ms);
+    EXPECT_EQ(2000, header.lastTimestamp_ms);
+    EXPECT_EQ(testCase.records.size(), header.rawSize);
+    EXPECT_EQ(out.size() - 6 - sizeof(header), header.storedSize);
+    if (header.flags == kBlockFlagNone) {
+      EXPECT_EQ(header.rawSize, header.storedSize);
+    } else {
+      EXPECT_LT(header.storedSize, header.rawSize);
+    }
+
+    const auto* stored = reinterpret_cast<const uint8_t*>(out.data()) + 6 + sizeof(header);
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(DecodeBlock(header, stored, decoded));
+    EXPECT_EQ(testCase.records, decoded);
+  }
+}
+
+TEST(DevLogBlockFormat, DecodeBlockRejectsBadSizes)
+{
+  using namespace DevLogBlockFormat;
+
+  const std::vector<uint8_t> records(500, 0x22);
+  std::string out;
+  EncodeBlock(records.data(), records.size(), 1, 0, 0, true, out);
+
+  BlockHeader header;
+  memcpy(&header, out.data(), sizeof(header));
+  ASSERT_EQ(kBlockFlagLZ4, header.flags);
+  const auto* stored = reinterpret_cast<const uint8_t*>(out.data()) + sizeof(header);
+
+  std::vector<uint8_t> decoded;
+  BlockHeader badHeader = header;
+  badHeader.rawSize += 1;
+  EXPECT_FALSE(DecodeBlock(badHeader, stored, decoded));
+
+  badHeader = header;
+  badHeader.storedSize -= 1;
+  EXPECT_FALSE(DecodeBlock(badHeader, stored, decoded));
+
+  // Uncompressed blocks have to store exactly the raw size
+  badHeader = header;
+  badHeader.flags = kBlockFlagNone;
+  EXPECT_FALSE(DecodeBlock(badHeader, stored, decoded));
+}
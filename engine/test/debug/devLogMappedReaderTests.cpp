@@ -0,0 +1,439 @@
+/**
+ * File: devLogMappedReaderTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for DevLogMappedReader. Logs are written in the block format (compressed and not) and in
+ *              the older format of bare records, then indexed, read back and searched. Also covers logs whose last
+ *              record or block was cut off mid-write.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/debug/devLogBlockFormat.h"
+#include "engine/debug/devLogMappedReader.h"
+
+#include "util/fileUtils/fileUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  enum class LogFormat {
+    BareRecords,
+    Uncompressed,
+    Compressed,
+  };
+
+  struct TestRecord
+  {
+    uint32_t             timestamp_ms = 0;
+    std::vector<uint8_t> payload;
+  };
+
+  // Partly repetitive payloads so that compression actually kicks in
+  std::vector<uint8_t> MakePayload(uint32_t timestamp_ms, size_t size)
+  {
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) {
+      payload[i] = (i % 8 < 5) ? static_cast<uint8_t>(i % 8) : static_cast<uint8_t>((timestamp_ms * 31 + i) & 0xFF);
+    }
+    return payload;
+  }
+
+  void AppendRecord(const TestRecord& record, std::string& out)
+  {
+    const uint32_t header[2] = {
+      static_cast<uint32_t>(record.payload.size() + DevLogBlockFormat::kRecordHeaderSize), record.timestamp_ms
+    };
+    out.append(reinterpret_cast<const char*>(header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(record.payload.data()), record.payload.size());
+  }
+
+  // Appends records [begin, end) in the given format. Blocks hold a random number of records, and their time ranges
+  // are collected in blockRanges_out.
+  void AppendRecords(const std::vector<TestRecord>& records, size_t begin, size_t end, LogFormat format,
+                     std::mt19937& rng, std::string& out,
+                     std::vector<std::pair<uint32_t, uint32_t>>* blockRanges_out = nullptr)
+  {
+    if (format == LogFormat::BareRecords) {
+      for (size_t i = begin; i < end; ++i) {
+        AppendRecord(records[i], out);
+      }
+      return;
+    }
+
+    std::uniform_int_distribution<size_t> blockSizeDist(1, 40);
+    size_t i = begin;
+    while (i < end) {
+      const size_t blockEnd = std::min(end, i + blockSizeDist(rng));
+      std::string blockRecords;
+      for (size_t j = i; j < blockEnd; ++j) {
+        AppendRecord(records[j], blockRecords);
+      }
+      DevLogBlockFormat::EncodeBlock(reinterpret_cast<const uint8_t*>(blockRecords.data()), blockRecords.size(),
+                                     static_cast<uint32_t>(blockEnd - i),
+                                     records[i].timestamp_ms, records[blockEnd - 1].timestamp_ms,
+                                     (format == LogFormat::Compressed), out);
+      if (blockRanges_out != nullptr) {
+        blockRanges_out->emplace_back(records[i].timestamp_ms, records[blockEnd - 1].timestamp_ms);
+      }
+      i = blockEnd;
+    }
+  }
+
+  // Timestamps never go backwards, but several records can share one and there are gaps between some of them
+  std::vector<TestRecord> MakeRecords(size_t numRecords, std::mt19937& rng, uint32_t firstTimestamp_ms = 100)
+  {
+    std::uniform_int_distribution<uint32_t> stepDist(0, 6);
+    std::uniform_int_distribution<size_t> sizeDist(1, 200);
+
+    std::vector<TestRecord> records(numRecords);
+    uint32_t timestamp_ms = firstTimestamp_ms;
+    for (auto& record : records) {
+      timestamp_ms += stepDist(rng);
+      record.timestamp_ms = timestamp_ms;
+      record.payload = MakePayload(timestamp_ms, sizeDist(rng));
+    }
+    return records;
+  }
+
+  // Index of the first record at time_ms or later, i.e. where SeekToTime should leave the reader
+  size_t FirstRecordAtOrAfter(const std::vector<TestRecord>& records, uint32_t time_ms)
+  {
+    const auto it = std::lower_bound(records.begin(), records.end(), time_ms,
+                                     [](const TestRecord& record, uint32_t time) {
+                                       return record.timestamp_ms < time;
+                                     });
+    return static_cast<size_t>(it - records.begin());
+  }
+
+  ::testing::AssertionResult RecordMatches(const TestRecord& expected, const DevLogMappedReader::Record& record)
+  {
+    if (record.timestamp_ms != expected.timestamp_ms) {
+      return ::testing::AssertionFailure() << "timestamp " << record.timestamp_ms
+                                           << ", expected " << expected.timestamp_ms;
+    }
+    if ((record.size != expected.payload.size()) ||
+        (memcmp(record.data, expected.payload.data(), record.size) != 0)) {
+      return ::testing::AssertionFailure() << "payload differs at " << expected.timestamp_ms << " ms";
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+  // Reads everything from the current position and compares it to records [begin, end)
+  void ExpectReadsRecords(DevLogMappedReader& reader, const std::vector<TestRecord>& records, size_t begin,
+                          size_t end)
+  {
+    DevLogMappedReader::Record record;
+    for (size_t i = begin; i < end; ++i) {
+      uint32_t nextTime_ms = 0;
+      ASSERT_TRUE(reader.PeekNextTime(nextTime_ms)) << "record " << i << " of " << end;
+      EXPECT_EQ(records[i].timestamp_ms, nextTime_ms);
+      ASSERT_TRUE(reader.ReadNext(record)) << "record " << i << " of " << end;
+      ASSERT_TRUE(RecordMatches(records[i], record)) << "record " << i << " of " << end;
+    }
+    EXPECT_FALSE(reader.ReadNext(record));
+  }
+
+  const char* FormatName(LogFormat format)
+  {
+    switch (format) {
+      case LogFormat::BareRecords:  return "bare records";
+      case LogFormat::Uncompressed: return "uncompressed";
+      case LogFormat::Compressed:   return "compressed";
+    }
+    return "";
+  }
+
+  const std::vector<LogFormat> kAllFormats{LogFormat::BareRecords, LogFormat::Uncompressed, LogFormat::Compressed};
+
+}
+
+class DevLogMappedReaderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char dirTemplate[] = "/tmp/devLogMappedReaderTestXXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dirTemplate));
+    _directory = dirTemplate;
+  }
+
+  void TearDown() override
+  {
+    Util::FileUtils::RemoveDirectory(_directory);
+  }
+
+  // Files are named the way the rolling logger names them, so they sort in the order written
+  void WriteLogFile(size_t fileNum, const std::string& contents)
+  {
+    const std::string path = _directory + "/" + std::to_string(1000 + fileNum) + ".log";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size());
+    ASSERT_TRUE(file.good()) << path;
+  }
+
+  // Splits records across numFiles files in the given format
+  void WriteLog(const std::vector<TestRecord>& records, size_t numFiles, LogFormat format, std::mt19937& rng,
+                std::vector<std::pair<uint32_t, uint32_t>>* blockRanges_out = nullptr)
+  {
+    for (size_t fileNum = 0; fileNum < numFiles; ++fileNum) {
+      std::string contents;
+      AppendRecords(records, records.size() * fileNum / numFiles, records.size() * (fileNum + 1) / numFiles,
+                    format, rng, contents, blockRanges_out);
+      WriteLogFile(fileNum, contents);
+    }
+  }
+
+  std::string _directory;
+};
+
+TEST_F(DevLogMappedReaderTest, NothingToRead)
+{
+  DevLogMappedReader missing(_directory + "/missing");
+  EXPECT_FALSE(missing.Init());
+
+  DevLogMappedReader empty(_directory);
+  EXPECT_FALSE(empty.Init());
+  EXPECT_FALSE(empty.SeekToTime(0));
+  DevLogMappedReader::Record record;
+  EXPECT_FALSE(empty.ReadNext(record));
+}
+
+TEST_F(DevLogMappedReaderTest, BuildsIndex)
+{
+  std::mt19937 rng(20181016);
+
+  for (const auto format : kAllFormats) {
+    SCOPED_TRACE(FormatName(format));
+    TearDown();
+    SetUp();
+
+    // Enough records per file that the bare records need more than one index entry
+    constexpr size_t kNumFiles = 3;
+    constexpr size_t kRecordsPerFile = 600;
+    const auto records = MakeRecords(kNumFiles * kRecordsPerFile, rng);
+    std::vector<std::pair<uint32_t, uint32_t>> blockRanges;
+    WriteLog(records, kNumFiles, format, rng, &blockRanges);
+
+    DevLogMappedReader reader(_directory);
+    ASSERT_TRUE(reader.Init());
+    EXPECT_EQ(records.front().timestamp_ms, reader.GetFirstTime_ms());
+    EXPECT_EQ(records.back().timestamp_ms, reader.GetFinalTime_ms());
+
+    if (format == LogFormat::BareRecords) {
+      // 256 + 256 + 88 per file
+      EXPECT_EQ(kNumFiles * 3, reader.GetNumIndexEntries());
+    } else {
+      EXPECT_EQ(blockRanges.size(), reader.GetNumIndexEntries());
+    }
+
+    ExpectReadsRecords(reader, records, 0, records.size());
+  }
+}
+
+TEST_F(DevLogMappedReaderTest, SeekToBlockBoundaries)
+{
+  std::mt19937 rng(123);
+
+  for (const auto format : {LogFormat::Uncompressed, LogFormat::Compressed}) {
+    SCOPED_TRACE(FormatName(format));
+    TearDown();
+    SetUp();
+
+    const auto records = MakeRecords(500, rng);
+    std::vector<std::pair<uint32_t, uint32_t>> blockRanges;
+    WriteLog(records, 2, format, rng, &blockRanges);
+    ASSERT_GT(blockRanges.size(), 5u);
+
+    DevLogMappedReader reader(_directory);
+    ASSERT_TRUE(reader.Init());
+
+    // Just before, at the start of, at the end of and just after every block. Times just after a block's last
+    // record fall in the gap before the next block, if there is one.
+    std::vector<uint32_t> seekTimes{0};
+    for (const auto& range : blockRanges) {
+      seekTimes.push_back(range.first - 1);
+      seekTimes.push_back(range.first);
+      seekTimes.push_back(range.second);
+      seekTimes.push_back(range.second + 1);
+    }
+
+    for (const uint32_t time_ms : seekTimes) {
+      const size_t expectedIdx = FirstRecordAtOrAfter(records, time_ms);
+      DevLogMappedReader::Record record;
+      if (expectedIdx == records.size()) {
+        EXPECT_FALSE(reader.SeekToTime(time_ms)) << time_ms;
+        EXPECT_FALSE(reader.ReadNext(record));
+        continue;
+      }
+
+      ASSERT_TRUE(reader.SeekToTime(time_ms)) << time_ms;
+      ASSERT_TRUE(reader.ReadNext(record));
+      EXPECT_TRUE(RecordMatches(records[expectedIdx], record)) << "seeking to " << time_ms;
+    }
+
+    // Seeking backwards after reaching the end works too
+    ASSERT_TRUE(reader.SeekToTime(0));
+    ExpectReadsRecords(reader, records, 0, records.size());
+  }
+}
+
+TEST_F(DevLogMappedReaderTest, RandomSeeks)
+{
+  std::mt19937 rng(42);
+
+  for (const auto format : kAllFormats) {
+    SCOPED_TRACE(FormatName(format));
+    TearDown();
+    SetUp();
+
+    const auto records = MakeRecords(2000, rng);
+    WriteLog(records, 4, format, rng);
+
+    DevLogMappedReader reader(_directory);
+    ASSERT_TRUE(reader.Init());
+
+    std::uniform_int_distribution<uint32_t> timeDist(0, records.back().timestamp_ms + 10);
+    for (int i = 0; i < 500; ++i) {
+      const uint32_t time_ms = timeDist(rng);
+      const size_t expectedIdx = FirstRecordAtOrAfter(records, time_ms);
+      EXPECT_EQ(expectedIdx < records.size(), reader.SeekToTime(time_ms)) << time_ms;
+
+      // Reading carries on in order from wherever the seek landed
+      DevLogMappedReader::Record record;
+      for (size_t j = expectedIdx; j < std::min(records.size(), expectedIdx + 5); ++j) {
+        ASSERT_TRUE(reader.ReadNext(record));
+        ASSERT_TRUE(RecordMatches(records[j], record)) << "seeking to " << time_ms;
+      }
+      if (expectedIdx == records.size()) {
+        EXPECT_FALSE(reader.ReadNext(record));
+      }
+    }
+  }
+}
+
+// Old logs can be followed by new ones in the same directory, and even in the same file
+TEST_F(DevLogMappedReaderTest, MixedFormats)
+{
+  std::mt19937 rng(7);
+  const auto records = MakeRecords(1200, rng);
+
+  std::string contents;
+  AppendRecords(records, 0, 300, LogFormat::BareRecords, rng, contents);
+  AppendRecords(records, 300, 500, LogFormat::Compressed, rng, contents);
+  WriteLogFile(0, contents);
+
+  contents.clear();
+  AppendRecords(records, 500, 800, LogFormat::Uncompressed, rng, contents);
+  AppendRecords(records, 800, 1000, LogFormat::BareRecords, rng, contents);
+  WriteLogFile(1, contents);
+
+  contents.clear();
+  AppendRecords(records, 1000, 1200, LogFormat::Compressed, rng, contents);
+  WriteLogFile(2, contents);
+
+  DevLogMappedReader reader(_directory);
+  ASSERT_TRUE(reader.Init());
+  ExpectReadsRecords(reader, records, 0, records.size());
+
+  for (const size_t idx : {0u, 299u, 300u, 301u, 499u, 500u, 799u, 800u, 999u, 1000u, 1199u}) {
+    const uint32_t time_ms = records[idx].timestamp_ms;
+    ASSERT_TRUE(reader.SeekToTime(time_ms));
+    DevLogMappedReader::Record record;
+    ASSERT_TRUE(reader.ReadNext(record));
+    EXPECT_TRUE(RecordMatches(records[FirstRecordAtOrAfter(records, time_ms)], record)) << idx;
+  }
+}
+
+// A log cut off mid-write keeps everything before the cut, and the files after it are still read
+TEST_F(DevLogMappedReaderTest, TruncatedTail)
+{
+  std::mt19937 rng(99);
+
+  for (const auto format : kAllFormats) {
+    // Cut the last record or block at every length, from losing all but its first byte to losing only its last
+    std::string lastRecordOrBlock;
+    const auto records = MakeRecords(300, rng);
+    AppendRecords(records, 199, 200, format, rng, lastRecordOrBlock);
+
+    for (size_t keep = 1; keep < lastRecordOrBlock.size(); ++keep) {
+      SCOPED_TRACE(std::string(FormatName(format)) + ", keeping " + std::to_string(keep) + " of " +
+                   std::to_string(lastRecordOrBlock.size()) + " bytes");
+      TearDown();
+      SetUp();
+
+      std::string contents;
+      AppendRecords(records, 0, 199, format, rng, contents);
+      contents.append(lastRecordOrBlock, 0, keep);
+      WriteLogFile(0, contents);
+
+      contents.clear();
+      AppendRecords(records, 200, 300, format, rng, contents);
+      WriteLogFile(1, contents);
+
+      DevLogMappedReader reader(_directory);
+      ASSERT_TRUE(reader.Init());
+
+      // Only record 199 is lost
+      auto remaining = records;
+      remaining.erase(remaining.begin() + 199);
+      ExpectReadsRecords(reader, remaining, 0, remaining.size());
+
+      const uint32_t lostTime_ms = records[199].timestamp_ms;
+      ASSERT_TRUE(reader.SeekToTime(lostTime_ms));
+      DevLogMappedReader::Record record;
+      ASSERT_TRUE(reader.ReadNext(record));
+      EXPECT_TRUE(RecordMatches(remaining[FirstRecordAtOrAfter(remaining, lostTime_ms)], record));
+    }
+  }
+}
+
+// Regression test: a tail of 4 to 7 bytes that isn't a block used to make Init loop forever
+TEST_F(DevLogMappedReaderTest, ShortTailAfterBareRecord)
+{
+  const TestRecord first{100, MakePayload(100, 4)};
+  const TestRecord second{200, MakePayload(200, 10)};
+
+  for (size_t tailSize = 1; tailSize < DevLogBlockFormat::kRecordHeaderSize; ++tailSize) {
+    SCOPED_TRACE(tailSize);
+    TearDown();
+    SetUp();
+
+    std::string contents;
+    AppendRecord(first, contents);
+    contents.append(tailSize, '\x05');
+    WriteLogFile(0, contents);
+
+    contents.clear();
+    AppendRecord(second, contents);
+    WriteLogFile(1, contents);
+
+    DevLogMappedReader reader(_directory);
+    ASSERT_TRUE(reader.Init());
+    EXPECT_EQ(2, reader.GetNumIndexEntries());
+    EXPECT_EQ(100, reader.GetFirstTime_ms());
+    EXPECT_EQ(200, reader.GetFinalTime_ms());
+
+    DevLogMappedReader::Record record;
+    ASSERT_TRUE(reader.ReadNext(record));
+    EXPECT_TRUE(RecordMatches(first, record));
+    ASSERT_TRUE(reader.ReadNext(record));
+    EXPECT_TRUE(RecordMatches(second, record));
+    EXPECT_FALSE(reader.ReadNext(record));
+  }
+}
@@ -0,0 +1,170 @@
+/**
+ * File: devLogReaderRawTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Unit tests for DevLogReaderRaw playing back logs that mix the older bare records with compressed and
+ *              uncompressed blocks, within a file and across files.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/debug/devLogBlockFormat.h"
+#include "engine/debug/devLogReaderRaw.h"
+
+#include "util/fileUtils/fileUtils.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  using Record = DevLogReader::LogData;
+
+  void AppendRecord(const Record& record, std::string& out)
+  {
+    const uint32_t header[2] = {
+      static_cast<uint32_t>(record._data.size() + DevLogBlockFormat::kRecordHeaderSize), record._timestamp_ms
+    };
+    out.append(reinterpret_cast<const char*>(header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(record._data.data()), record._data.size());
+  }
+
+  void AppendBlock(const std::vector<Record>& records, size_t begin, size_t end, bool compress, std::string& out)
+  {
+    std::string blockRecords;
+    for (size_t i = begin; i < end; ++i) {
+      AppendRecord(records[i], blockRecords);
+    }
+    DevLogBlockFormat::EncodeBlock(reinterpret_cast<const uint8_t*>(blockRecords.data()), blockRecords.size(),
+                                   static_cast<uint32_t>(end - begin),
+                                   records[begin]._timestamp_ms, records[end - 1]._timestamp_ms, compress, out);
+  }
+
+  // Partly repetitive payloads so that compression actually kicks in
+  std::vector<Record> MakeRecords(size_t numRecords, std::mt19937& rng)
+  {
+    std::uniform_int_distribution<uint32_t> stepDist(0, 5);
+    std::uniform_int_distribution<size_t> sizeDist(1, 120);
+
+    std::vector<Record> records(numRecords);
+    uint32_t timestamp_ms = 10;
+    for (auto& record : records) {
+      timestamp_ms += stepDist(rng);
+      record._timestamp_ms = timestamp_ms;
+      record._data.resize(sizeDist(rng));
+      for (size_t i = 0; i < record._data.size(); ++i) {
+        record._data[i] = (i % 4 < 2) ? 0xA5 : static_cast<uint8_t>(timestamp_ms + i);
+      }
+    }
+    return records;
+  }
+
+}
+
+class DevLogReaderRawTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char dirTemplate[] = "/tmp/devLogReaderRawTestXXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dirTemplate));
+    _directory = dirTemplate;
+  }
+
+  void TearDown() override
+  {
+    Util::FileUtils::RemoveDirectory(_directory);
+  }
+
+  void WriteLogFile(size_t fileNum, const std::string& contents)
+  {
+    const std::string path = _directory + "/" + std::to_string(1000 + fileNum) + ".log";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size());
+    ASSERT_TRUE(file.good()) << path;
+  }
+
+  // Plays the whole log back a few ms at a time
+  std::vector<Record> ReadAll(uint32_t timestep_ms)
+  {
+    std::vector<Record> read;
+    DevLogReaderRaw reader(_directory);
+    reader.Init();
+    reader.SetDataCallback([&read, &reader](const DevLogReader::LogData& data) {
+      // Nothing is handed out before its time
+      EXPECT_LE(data._timestamp_ms, reader.GetCurrPlaybackTime());
+      read.push_back(data);
+    });
+    while (reader.AdvanceTime(timestep_ms)) { }
+    return read;
+  }
+
+  std::string _directory;
+};
+
+TEST_F(DevLogReaderRawTest, MixedBareRecordsAndBlocks)
+{
+  std::mt19937 rng(20181016);
+  const auto records = MakeRecords(1000, rng);
+
+  // An old log that was appended to after updating, then a file of blocks with bare records after them
+  std::string contents;
+  for (size_t i = 0; i < 150; ++i) {
+    AppendRecord(records[i], contents);
+  }
+  AppendBlock(records, 150, 200, true, contents);
+  AppendBlock(records, 200, 230, false, contents);
+  AppendBlock(records, 230, 400, true, contents);
+  WriteLogFile(0, contents);
+
+  contents.clear();
+  AppendBlock(records, 400, 401, true, contents);
+  AppendBlock(records, 401, 600, false, contents);
+  for (size_t i = 600; i < 700; ++i) {
+    AppendRecord(records[i], contents);
+  }
+  AppendBlock(records, 700, 1000, true, contents);
+  WriteLogFile(1, contents);
+
+  for (const uint32_t timestep_ms : {1u, 7u, 100u}) {
+    const auto read = ReadAll(timestep_ms);
+    ASSERT_EQ(records.size(), read.size()) << timestep_ms;
+    for (size_t i = 0; i < records.size(); ++i) {
+      ASSERT_EQ(records[i]._timestamp_ms, read[i]._timestamp_ms) << i;
+      ASSERT_EQ(records[i]._data, read[i]._data) << i;
+    }
+  }
+}
+
+// Empty blocks are skipped over
+TEST_F(DevLogReaderRawTest, EmptyBlocks)
+{
+  std::mt19937 rng(5);
+  const auto records = MakeRecords(20, rng);
+
+  std::string contents;
+  DevLogBlockFormat::EncodeBlock(nullptr, 0, 0, 0, 0, true, contents);
+  AppendBlock(records, 0, 10, true, contents);
+  DevLogBlockFormat::EncodeBlock(nullptr, 0, 0, 0, 0, false, contents);
+  AppendRecord(records[10], contents);
+  AppendBlock(records, 11, 20, false, contents);
+  WriteLogFile(0, contents);
+
+  const auto read = ReadAll(10);
+  ASSERT_EQ(records.size(), read.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i]._timestamp_ms, read[i]._timestamp_ms) << i;
+    EXPECT_EQ(records[i]._data, read[i]._data) << i;
+  }
+}
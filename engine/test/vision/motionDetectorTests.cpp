@@ -0,0 +1,180 @@
+/**
+ * File: motionDetectorTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Checks that the SIMD motion detector ratio test matches the scalar implementation exactly,
+ *              including rows whose width is not a multiple of the SIMD width and non-continuous images.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/common/engine/math/rect.h"
+#include "coretech/vision/engine/image.h"
+#include "engine/unitTestKey.h"
+#include "engine/vision/motionDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Anki {
+namespace Vector {
+
+class MotionDetectorRatioTest : public ::testing::Test
+{
+protected:
+
+  // Fills image with random values, and prevImage with values that are mostly within a small ratio of image's so
+  // that many pixels land close to the ratio threshold
+  template<class ImageType>
+  void Randomize(ImageType& image, ImageType& prevImage)
+  {
+    std::uniform_int_distribution<int> pixelDist(0, 255);
+    std::uniform_real_distribution<float> scaleDist(0.6f, 1.6f);
+    std::uniform_int_distribution<int> choiceDist(0, 3);
+
+    const s32 numBytesPerRow = image.GetNumCols() * static_cast<s32>(sizeof(*image.GetRow(0)));
+    for(s32 i = 0; i < image.GetNumRows(); ++i)
+    {
+      u8* imagePtr     = reinterpret_cast<u8*>(image.GetRow(i));
+      u8* prevImagePtr = reinterpret_cast<u8*>(prevImage.GetRow(i));
+      for(s32 j = 0; j < numBytesPerRow; ++j)
+      {
+        imagePtr[j] = static_cast<u8>(pixelDist(_rng));
+        if(choiceDist(_rng) == 0) {
+          prevImagePtr[j] = static_cast<u8>(pixelDist(_rng));
+        } else {
+          const float scaled = std::round(static_cast<float>(imagePtr[j]) * scaleDist(_rng));
+          prevImagePtr[j] = static_cast<u8>(std::min(255.f, scaled));
+        }
+      }
+    }
+  }
+
+  template<class ImageType>
+  void ExpectSIMDMatchesScalar(const ImageType& image, const ImageType& prevImage)
+  {
+    Vision::Image simdRatioImg(image.GetNumRows(), image.GetNumCols());
+    Vision::Image scalarRatioImg(image.GetNumRows(), image.GetNumCols());
+
+    const s32 numSIMD   = MotionDetector::RatioTest(image, prevImage, simdRatioImg,   true,  UnitTestKey());
+    const s32 numScalar = MotionDetector::RatioTest(image, prevImage, scalarRatioImg, false, UnitTestKey());
+
+    EXPECT_EQ(numScalar, numSIMD) << image.GetNumRows() << "x" << image.GetNumCols();
+
+    for(s32 i = 0; i < image.GetNumRows(); ++i)
+    {
+      const u8* simdPtr   = simdRatioImg.GetRow(i);
+      const u8* scalarPtr = scalarRatioImg.GetRow(i);
+      for(s32 j = 0; j < image.GetNumCols(); ++j)
+      {
+        ASSERT_EQ(scalarPtr[j], simdPtr[j]) << "pixel (" << i << "," << j << ") of "
+                                            << image.GetNumRows() << "x" << image.GetNumCols();
+      }
+    }
+  }
+
+  std::mt19937 _rng{20181016};
+};
+
+// Every pair of gray values, so the brightness and ratio threshold edges are all covered
+TEST_F(MotionDetectorRatioTest, GrayAllPixelPairs)
+{
+  Vision::Image image(256, 256);
+  Vision::Image prevImage(256, 256);
+  for(s32 i = 0; i < 256; ++i)
+  {
+    u8* imagePtr     = image.GetRow(i);
+    u8* prevImagePtr = prevImage.GetRow(i);
+    for(s32 j = 0; j < 256; ++j)
+    {
+      imagePtr[j]     = static_cast<u8>(i);
+      prevImagePtr[j] = static_cast<u8>(j);
+    }
+  }
+
+  ExpectSIMDMatchesScalar(image, prevImage);
+}
+
+// Each channel in turn takes every pair of values while the other two stay bright and unchanged
+TEST_F(MotionDetectorRatioTest, ColorAllChannelPairs)
+{
+  for(s32 channel = 0; channel < 3; ++channel)
+  {
+    Vision::ImageRGB image(256, 256);
+    Vision::ImageRGB prevImage(256, 256);
+    for(s32 i = 0; i < 256; ++i)
+    {
+      u8* imagePtr     = reinterpret_cast<u8*>(image.GetRow(i));
+      u8* prevImagePtr = reinterpret_cast<u8*>(prevImage.GetRow(i));
+      for(s32 j = 0; j < 256; ++j)
+      {
+        for(s32 k = 0; k < 3; ++k)
+        {
+          imagePtr[3*j + k]     = (k == channel) ? static_cast<u8>(i) : 128;
+          prevImagePtr[3*j + k] = (k == channel) ? static_cast<u8>(j) : 128;
+        }
+      }
+    }
+
+    ExpectSIMDMatchesScalar(image, prevImage);
+  }
+}
+
+// Widths on both sides of multiples of the SIMD width, so the tail loops run for every remainder
+TEST_F(MotionDetectorRatioTest, GrayRandomTailColumns)
+{
+  for(s32 numCols = 1; numCols <= 50; ++numCols)
+  {
+    Vision::Image image(7, numCols);
+    Vision::Image prevImage(7, numCols);
+    Randomize(image, prevImage);
+    ExpectSIMDMatchesScalar(image, prevImage);
+  }
+}
+
+TEST_F(MotionDetectorRatioTest, ColorRandomTailColumns)
+{
+  for(s32 numCols = 1; numCols <= 50; ++numCols)
+  {
+    Vision::ImageRGB image(7, numCols);
+    Vision::ImageRGB prevImage(7, numCols);
+    Randomize(image, prevImage);
+    ExpectSIMDMatchesScalar(image, prevImage);
+  }
+}
+
+// ROIs are not continuous, so the SIMD path has to process row by row, each with its own tail
+TEST_F(MotionDetectorRatioTest, RandomNonContinuousRows)
+{
+  Vision::Image grayImage(60, 80);
+  Vision::Image grayPrevImage(60, 80);
+  Randomize(grayImage, grayPrevImage);
+
+  Vision::ImageRGB colorImage(60, 80);
+  Vision::ImageRGB colorPrevImage(60, 80);
+  Randomize(colorImage, colorPrevImage);
+
+  for(s32 numCols : {17, 31, 45})
+  {
+    const Rectangle<s32> roi(3, 5, numCols, 40);
+
+    const Vision::Image grayROI = grayImage.GetROI(roi);
+    const Vision::Image grayPrevROI = grayPrevImage.GetROI(roi);
+    ASSERT_FALSE(grayROI.IsContinuous());
+    ExpectSIMDMatchesScalar(grayROI, grayPrevROI);
+
+    const Vision::ImageRGB colorROI = colorImage.GetROI(roi);
+    const Vision::ImageRGB colorPrevROI = colorPrevImage.GetROI(roi);
+    ASSERT_FALSE(colorROI.IsContinuous());
+    ExpectSIMDMatchesScalar(colorROI, colorPrevROI);
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,229 @@
+/**
+ * File: visionModeTaskGraphTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Checks that VisionModeTaskGraph runs every task after its dependencies, both on the calling thread
+ *              alone and with worker threads, and how it handles missing dependencies, cycles and failures.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/vision/visionModeTaskGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  // Records which tasks ran, in what order and on which thread. Shared by all the tasks of a graph.
+  struct TaskLog
+  {
+    std::mutex                               mutex;
+    std::vector<VisionMode>                  started;
+    std::vector<VisionMode>                  finished;
+    std::set<std::thread::id>                threads;
+    std::map<VisionMode, bool>               depsDoneWhenStarted;
+    std::map<VisionMode, bool>               depsMergedWhenStarted;
+  };
+
+  // A task which checks, when it starts, that its dependencies have all finished and that their results have
+  // already been merged into the result passed to Run
+  VisionModeTaskGraph::TaskFcn MakeTask(VisionMode mode, const std::set<VisionMode>& dependencies,
+                                        const VisionProcessingResult& result, TaskLog& log,
+                                        std::chrono::microseconds workTime = std::chrono::microseconds(0),
+                                        Result taskResult = RESULT_OK)
+  {
+    return [mode, dependencies, &result, &log, workTime, taskResult](VisionProcessingResult& partialResult) {
+      {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        bool depsDone = true;
+        bool depsMerged = true;
+        for(const auto dependency : dependencies)
+        {
+          depsDone &= (std::find(log.finished.begin(), log.finished.end(), dependency) != log.finished.end());
+          depsMerged &= result.modesProcessed.Contains(dependency);
+        }
+        log.depsDoneWhenStarted[mode] = depsDone;
+        log.depsMergedWhenStarted[mode] = depsMerged;
+        log.started.push_back(mode);
+        log.threads.insert(std::this_thread::get_id());
+      }
+
+      std::this_thread::sleep_for(workTime);
+      partialResult.modesProcessed.Insert(mode);
+
+      std::lock_guard<std::mutex> lock(log.mutex);
+      log.finished.push_back(mode);
+      return taskResult;
+    };
+  }
+
+  // Full vision modes to use as task names
+  const std::vector<VisionMode> kModes{
+    VisionMode::Markers, VisionMode::Faces, VisionMode::Motion, VisionMode::BrightColors,
+    VisionMode::OverheadEdges, VisionMode::Calibration, VisionMode::AutoExp, VisionMode::WhiteBalance,
+    VisionMode::Stats, VisionMode::Pets, VisionMode::Lasers, VisionMode::OverheadMap,
+  };
+
+}
+
+TEST(VisionModeTaskGraph, SingleThreadRunsInLevelOrderOnCallingThread)
+{
+  VisionModeTaskGraph graph;
+  VisionProcessingResult result;
+  TaskLog log;
+
+  // Added out of dependency order: Motion needs Faces, which needs Markers. Stats has no dependencies.
+  graph.AddTask(VisionMode::Motion,  {VisionMode::Faces},   MakeTask(VisionMode::Motion,  {VisionMode::Faces},   result, log));
+  graph.AddTask(VisionMode::Faces,   {VisionMode::Markers}, MakeTask(VisionMode::Faces,   {VisionMode::Markers}, result, log));
+  graph.AddTask(VisionMode::Markers, {},                    MakeTask(VisionMode::Markers, {},                    result, log));
+  graph.AddTask(VisionMode::Stats,   {},                    MakeTask(VisionMode::Stats,   {},                    result, log));
+  ASSERT_EQ(4, graph.GetNumTasks());
+
+  EXPECT_EQ(RESULT_OK, graph.Run(1, result));
+
+  // Each level in the order added
+  const std::vector<VisionMode> expectedOrder{
+    VisionMode::Markers, VisionMode::Stats, VisionMode::Faces, VisionMode::Motion
+  };
+  EXPECT_EQ(expectedOrder, log.started);
+  EXPECT_EQ(expectedOrder, log.finished);
+
+  ASSERT_EQ(1, log.threads.size());
+  EXPECT_EQ(std::this_thread::get_id(), *log.threads.begin());
+
+  for(const auto mode : expectedOrder)
+  {
+    EXPECT_TRUE(log.depsDoneWhenStarted[mode]);
+    EXPECT_TRUE(log.depsMergedWhenStarted[mode]);
+    EXPECT_TRUE(result.modesProcessed.Contains(mode));
+  }
+
+  EXPECT_TRUE(graph.IsEmpty());
+}
+
+// Random graphs, run with several thread counts on the same graph object so the workers get restarted and reused
+TEST(VisionModeTaskGraph, MultiThreadRunsDependenciesFirst)
+{
+  std::mt19937 rng(20181016);
+  std::bernoulli_distribution dependDist(0.25);
+  std::uniform_int_distribution<int> workDist(0, 2000);
+
+  VisionModeTaskGraph graph;
+
+  for(const u32 numThreads : {4u, 4u, 2u, 3u, 1u, 4u})
+  {
+    for(int trial = 0; trial < 5; ++trial)
+    {
+      VisionProcessingResult result;
+      TaskLog log;
+
+      // Only depend on modes earlier in kModes so there are no cycles, but add the tasks in a random order
+      std::vector<size_t> addOrder(kModes.size());
+      std::iota(addOrder.begin(), addOrder.end(), 0);
+      std::shuffle(addOrder.begin(), addOrder.end(), rng);
+
+      for(const size_t iMode : addOrder)
+      {
+        std::set<VisionMode> dependencies;
+        for(size_t iDep = 0; iDep < iMode; ++iDep)
+        {
+          if(dependDist(rng))
+          {
+            dependencies.insert(kModes[iDep]);
+          }
+        }
+        graph.AddTask(kModes[iMode], dependencies,
+                      MakeTask(kModes[iMode], dependencies, result, log, std::chrono::microseconds(workDist(rng))));
+      }
+
+      EXPECT_EQ(RESULT_OK, graph.Run(numThreads, result));
+
+      ASSERT_EQ(kModes.size(), log.finished.size());
+      EXPECT_LE(log.threads.size(), numThreads);
+      for(const auto mode : kModes)
+      {
+        EXPECT_TRUE(log.depsDoneWhenStarted[mode]) << EnumToString(mode) << " with " << numThreads << " threads";
+        EXPECT_TRUE(log.depsMergedWhenStarted[mode]) << EnumToString(mode) << " with " << numThreads << " threads";
+        EXPECT_TRUE(result.modesProcessed.Contains(mode));
+      }
+      EXPECT_TRUE(graph.IsEmpty());
+    }
+  }
+}
+
+TEST(VisionModeTaskGraph, MissingDependencyIgnored)
+{
+  VisionModeTaskGraph graph;
+  VisionProcessingResult result;
+  TaskLog log;
+
+  // Nothing processes Faces this frame
+  graph.AddTask(VisionMode::Pets, {VisionMode::Faces}, MakeTask(VisionMode::Pets, {}, result, log));
+  EXPECT_EQ(RESULT_OK, graph.Run(2, result));
+
+  EXPECT_EQ(std::vector<VisionMode>{VisionMode::Pets}, log.finished);
+}
+
+TEST(VisionModeTaskGraph, CycleRunsRemainingTasksSerially)
+{
+  VisionModeTaskGraph graph;
+  VisionProcessingResult result;
+  TaskLog log;
+
+  graph.AddTask(VisionMode::Faces,   {VisionMode::Markers}, MakeTask(VisionMode::Faces,   {}, result, log));
+  graph.AddTask(VisionMode::Markers, {VisionMode::Faces},   MakeTask(VisionMode::Markers, {}, result, log));
+  graph.AddTask(VisionMode::Stats,   {},                    MakeTask(VisionMode::Stats,   {}, result, log));
+
+  EXPECT_EQ(RESULT_OK, graph.Run(4, result));
+
+  // Whatever can be scheduled runs first, then the cycle in the order added
+  const std::vector<VisionMode> expectedOrder{VisionMode::Stats, VisionMode::Faces, VisionMode::Markers};
+  EXPECT_EQ(expectedOrder, log.finished);
+  EXPECT_TRUE(graph.IsEmpty());
+}
+
+TEST(VisionModeTaskGraph, FailureStillRunsEverything)
+{
+  VisionModeTaskGraph graph;
+  VisionProcessingResult result;
+  TaskLog log;
+
+  graph.AddTask(VisionMode::Markers, {}, MakeTask(VisionMode::Markers, {}, result, log));
+  graph.AddTask(VisionMode::Faces,   {}, MakeTask(VisionMode::Faces,   {}, result, log,
+                                                  std::chrono::microseconds(0), RESULT_FAIL));
+  graph.AddTask(VisionMode::Motion,  {VisionMode::Faces}, MakeTask(VisionMode::Motion, {}, result, log));
+
+  EXPECT_EQ(RESULT_FAIL, graph.Run(2, result));
+  EXPECT_EQ(3, log.finished.size());
+  EXPECT_TRUE(result.modesProcessed.Contains(VisionMode::Motion));
+}
+
+TEST(VisionModeTaskGraph, DuplicateModeIgnored)
+{
+  VisionModeTaskGraph graph;
+  VisionProcessingResult result;
+  TaskLog log;
+
+  graph.AddTask(VisionMode::Markers, {}, MakeTask(VisionMode::Markers, {}, result, log));
+  graph.AddTask(VisionMode::Markers, {}, MakeTask(VisionMode::Markers, {}, result, log));
+  EXPECT_EQ(1, graph.GetNumTasks());
+
+  EXPECT_EQ(RESULT_OK, graph.Run(1, result));
+  EXPECT_EQ(1, log.finished.size());
+}
@@ -0,0 +1,261 @@
+/**
+* File: devLogReplayMain.cpp
+*
+* Author: agent
+* Date:   10/16/2026
+*
+* Description: Headless replay of a recorded devlog. Feeds the robotToEngine messages of a dev log session through the
+*              engine's robot message handler and ticks the Robot as fast as it will go, with simulated time taken from
+*              the log. Nothing is connected: messages the engine would send to the robot or to apps are dropped.
+*              Prints per tick timing when done, so engine changes can be profiled against the same recorded session.
+*
+* Copyright: Anki, Inc. 2026
+*
+*/
+
+#include "anki/cozmo/shared/cozmoConfig.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/common/engine/utils/timer.h"
+
+#include "engine/cozmoContext.h"
+#include "engine/debug/devLogMappedReader.h"
+#include "engine/robot.h"
+#include "engine/robotDataLoader.h"
+#include "engine/robotInterface/messageHandler.h"
+#include "engine/robotManager.h"
+
+#include "osState/osState.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+#include "util/logging/printfLoggerProvider.h"
+
+#include <algorithm>
+#include <chrono>
+#include <getopt.h>
+#include <libgen.h>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// What channel name do we use for logging?
+#define LOG_CHANNEL "DevLogReplay"
+
+namespace {
+
+  // Matches the directory DevLoggingSystem writes robot messages to
+  constexpr const char* kRobotToEngineDirectory = "robotToEngine";
+
+  struct ReplayOptions
+  {
+    std::string devLogPath;
+    std::string resourcesPath;
+    std::string scratchPath   = "/tmp/vic-devlog-replay";
+    uint32_t    start_ms      = 0;
+    uint32_t    end_ms        = std::numeric_limits<uint32_t>::max();
+    uint32_t    tick_ms       = Anki::Vector::BS_TIME_STEP_MS;
+  };
+
+  void PrintUsage(const char* progName)
+  {
+    printf("%s <OPTIONS> --devlog [DEVLOG DIR] --resources [RESOURCES DIR]\n", progName);
+    printf("  -h, --help                          print this help message\n");
+    printf("  -d, --devlog [DIR]                  dev log session to replay (the directory holding robotToEngine)\n");
+    printf("  -r, --resources [DIR]               engine resources directory\n");
+    printf("  -p, --scratch [DIR]                 persistent/cache directory for the engine (default %s)\n",
+           ReplayOptions().scratchPath.c_str());
+    printf("  -s, --start [MS]                    skip to this log time before replaying\n");
+    printf("  -e, --end [MS]                      stop replaying at this log time\n");
+    printf("  -t, --tick [MS]                     simulated time per engine tick (default %u)\n",
+           ReplayOptions().tick_ms);
+  }
+
+  // Nearest rank percentile of sorted samples
+  double Percentile(const std::vector<double>& sorted, double fraction)
+  {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+    const size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+    return sorted[idx];
+  }
+
+}
+
+static bool parse_options(int argc, char* argv[], ReplayOptions& options)
+{
+  int help_flag = 0;
+
+  static const char *opt_string = "hd:r:p:s:e:t:";
+
+  static const struct option long_options[] = {
+      { "devlog",     required_argument,      NULL,           'd' },
+      { "resources",  required_argument,      NULL,           'r' },
+      { "scratch",    required_argument,      NULL,           'p' },
+      { "start",      required_argument,      NULL,           's' },
+      { "end",        required_argument,      NULL,           'e' },
+      { "tick",       required_argument,      NULL,           't' },
+      { "help",       no_argument,            &help_flag,     'h' },
+      { NULL,         no_argument,            NULL,           0   }
+  };
+
+  while(true) {
+    int option_index = 0;
+    int c = getopt_long(argc, argv, opt_string, long_options, &option_index);
+
+    if (-1 == c) {
+      break;
+    }
+
+    switch(c) {
+      case 0:
+        break;
+      case 'd':
+        options.devLogPath = optarg;
+        break;
+      case 'r':
+        options.resourcesPath = optarg;
+        break;
+      case 'p':
+        options.scratchPath = optarg;
+        break;
+      case 's':
+        options.start_ms = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+        break;
+      case 'e':
+        options.end_ms = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+        break;
+      case 't':
+        options.tick_ms = std::max(1u, static_cast<uint32_t>(strtoul(optarg, nullptr, 10)));
+        break;
+      case 'h':
+        help_flag = 1;
+        break;
+      case '?':
+      default:
+        help_flag = 1;
+        break;
+    }
+  }
+
+  if (help_flag || options.devLogPath.empty() || options.resourcesPath.empty()) {
+    PrintUsage(basename(argv[0]));
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace Anki;
+  using namespace Anki::Vector;
+
+  ReplayOptions options;
+  if (!parse_options(argc, argv, options)) {
+    return 1;
+  }
+
+  Util::PrintfLoggerProvider loggerProvider(Util::LOG_LEVEL_WARN, false);
+  Util::gLoggerProvider = &loggerProvider;
+
+  DevLogMappedReader reader(Util::FileUtils::FullFilePath({options.devLogPath, kRobotToEngineDirectory}));
+  if (!reader.Init()) {
+    fprintf(stderr, "no robotToEngine messages found in %s\n", options.devLogPath.c_str());
+    return 1;
+  }
+
+  const uint32_t start_ms = std::max(options.start_ms, reader.GetFirstTime_ms());
+  const uint32_t end_ms = std::min(options.end_ms, reader.GetFinalTime_ms());
+  if (!reader.SeekToTime(start_ms) || (start_ms > end_ms)) {
+    fprintf(stderr, "log covers %u to %u ms, nothing to replay\n", reader.GetFirstTime_ms(), reader.GetFinalTime_ms());
+    return 1;
+  }
+
+  // The engine as CozmoEngine would set it up, minus the app and gateway interfaces and the robot connection
+  const std::string persistentPath = Util::FileUtils::FullFilePath({options.scratchPath, "persistent"});
+  const std::string cachePath = Util::FileUtils::FullFilePath({options.scratchPath, "cache"});
+  Util::FileUtils::CreateDirectory(persistentPath);
+  Util::FileUtils::CreateDirectory(cachePath);
+  Util::Data::DataPlatform dataPlatform(persistentPath, cachePath, options.resourcesPath);
+
+  std::unique_ptr<CozmoContext> context(new CozmoContext(&dataPlatform, nullptr, nullptr));
+
+  context->GetDataLoader()->LoadRobotConfigs();
+  float loadingCompleteRatio = 0.0f;
+  while (!context->GetDataLoader()->DoNonConfigDataLoading(loadingCompleteRatio)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  RobotManager* robotManager = context->GetRobotManager();
+  robotManager->Init(Json::Value());
+  robotManager->AddRobot(OSState::getInstance()->GetRobotID());
+  Robot* robot = robotManager->GetRobot();
+  RobotInterface::MessageHandler* msgHandler = robotManager->GetMsgHandler();
+
+  LOG_INFO("DevLogReplay.Start", "Replaying %s from %u to %u ms", options.devLogPath.c_str(), start_ms, end_ms);
+
+  using TimeClock = std::chrono::steady_clock;
+  std::vector<double> tickDurations_ms;
+  tickDurations_ms.reserve((end_ms - start_ms) / options.tick_ms + 1);
+
+  size_t numMessages = 0;
+  bool hasMoreMessages = true;
+  const auto replayStart = TimeClock::now();
+
+  for (uint64_t simTime_ms = start_ms; hasMoreMessages && (simTime_ms <= end_ms); simTime_ms += options.tick_ms)
+  {
+    const auto tickStart = TimeClock::now();
+
+    BaseStationTimer::getInstance()->UpdateTime(static_cast<BaseStationTime_t>(simTime_ms) * 1000000);
+
+    // Everything the robot sent up to now, as ProcessMessages would have received it
+    uint32_t nextTime_ms = 0;
+    while ((hasMoreMessages = reader.PeekNextTime(nextTime_ms)) && (nextTime_ms <= simTime_ms))
+    {
+      DevLogMappedReader::Record record;
+      reader.ReadNext(record);
+      msgHandler->HandleRawMessage(record.data, record.size);
+      ++numMessages;
+    }
+
+    // RobotManager::UpdateRobot would also broadcast state to the (absent) app and gateway interfaces
+    robot->Update();
+    ShutdownReason shutdownReason = ShutdownReason::SHUTDOWN_UNKNOWN;
+    if (robot->ToldToShutdown(shutdownReason)) {
+      LOG_WARNING("DevLogReplay.Shutdown", "Robot told to shut down at %llu ms", (unsigned long long)simTime_ms);
+      break;
+    }
+
+    const std::chrono::duration<double, std::milli> tickDuration = TimeClock::now() - tickStart;
+    tickDurations_ms.push_back(tickDuration.count());
+  }
+
+  const std::chrono::duration<double, std::milli> replayDuration = TimeClock::now() - replayStart;
+
+  // Summary
+  const double simDuration_ms = static_cast<double>(tickDurations_ms.size()) * options.tick_ms;
+  double totalTick_ms = 0.0;
+  for (const double tick_ms : tickDurations_ms) {
+    totalTick_ms += tick_ms;
+  }
+  std::sort(tickDurations_ms.begin(), tickDurations_ms.end());
+
+  printf("messages:   %zu\n", numMessages);
+  printf("ticks:      %zu (%u ms each)\n", tickDurations_ms.size(), options.tick_ms);
+  printf("log time:   %.3f s\n", simDuration_ms * 0.001);
+  printf("wall time:  %.3f s (%.1fx real time)\n", replayDuration.count() * 0.001,
+         (replayDuration.count() > 0.0) ? simDuration_ms / replayDuration.count() : 0.0);
+  printf("tick ms:    mean %.3f  p50 %.3f  p95 %.3f  max %.3f\n",
+         tickDurations_ms.empty() ? 0.0 : totalTick_ms / tickDurations_ms.size(),
+         Percentile(tickDurations_ms, 0.50),
+         Percentile(tickDurations_ms, 0.95),
+         tickDurations_ms.empty() ? 0.0 : tickDurations_ms.back());
+
+  // Order of destruction matters, see RobotManager::Shutdown
+  context.reset();
+  Util::gLoggerProvider = nullptr;
+
+  return 0;
+}
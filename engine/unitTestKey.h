@@ -26,6 +26,7 @@ private:
   friend class TestBehaviorHighLevelAI;
   friend class TestBehaviorFramework;
   friend class BehaviorDirectoryStructure_Run_Test;
+  friend class MotionDetectorRatioTest;
 };
 
 } // namespace Vector
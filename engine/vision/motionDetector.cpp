@@ -12,6 +12,7 @@
 
 #include "engine/vision/motionDetector.h"
 #include "engine/vision/motionDetector_neon.h"
+#include "engine/vision/motionDetector_sse.h"
 
 #include "coretech/common/engine/math/linearAlgebra.h"
 #include "coretech/common/engine/math/quad.h"
@@ -19,6 +20,7 @@
 #include "coretech/vision/engine/imageCache.h"
 #include "coretech/common/engine/jsonTools.h"
 #include "engine/vision/visionPoseData.h"
+#include "engine/unitTestKey.h"
 #include "engine/viz/vizManager.h"
 #include "util/console/consoleInterface.h"
 
@@ -408,14 +410,46 @@ s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& rati
   DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
              "MotionDetector.RatioTestColor.MismatchedSize");
   
-  u32 numAboveThresh = 0;
+#ifdef __ARM_NEON__
+
+  return RatioTestNeon(image, ratioImg);
+
+#elif defined(__SSE2__)
+
+  return RatioTestSSE(image, _prevImageRGB, ratioImg);
+
+#else
+
+  return RatioTestScalar(image, _prevImageRGB, ratioImg);
+
+#endif
+}
+
+s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioImg)
+{
+  DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
+             "MotionDetector.RatioTestGray.MismatchedSize");
   
 #ifdef __ARM_NEON__
 
   return RatioTestNeon(image, ratioImg);
 
+#elif defined(__SSE2__)
+
+  return RatioTestSSE(image, _prevImageGray, ratioImg);
+
 #else
 
+  return RatioTestScalar(image, _prevImageGray, ratioImg);
+
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s32 MotionDetector::RatioTestScalar(const Vision::ImageRGB& image, const Vision::ImageRGB& prevImage, Vision::Image& ratioImg)
+{
+  s32 numAboveThresh = 0;
+
   // somehow auto doens't work here... the right type cannot be deduced. Bug in clang?
   std::function<u8(const Vision::PixelRGB& thisElem, const Vision::PixelRGB& otherElem)> ratioTest =
       [&numAboveThresh](const Vision::PixelRGB& p1, const Vision::PixelRGB& p2)
@@ -436,26 +470,15 @@ s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& rati
     return retVal;
   };
   
-  image.ApplyScalarFunction(ratioTest, _prevImageRGB, ratioImg);
+  image.ApplyScalarFunction(ratioTest, prevImage, ratioImg);
 
-#endif
-  
   return numAboveThresh;
 }
 
-s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioImg)
+s32 MotionDetector::RatioTestScalar(const Vision::Image& image, const Vision::Image& prevImage, Vision::Image& ratioImg)
 {
-  DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
-             "MotionDetector.RatioTestGray.MismatchedSize");
-  
   s32 numAboveThresh = 0;
 
-#ifdef __ARM_NEON__
-
-  return RatioTestNeon(image, ratioImg);
-
-#else
-  
   std::function<u8(const u8& thisElem, const u8& otherElem)> ratioTest = [&numAboveThresh](const u8& p1, const u8& p2)
   {
     u8 retVal = 0;
@@ -472,13 +495,37 @@ s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioIm
     return retVal;
   };
   
-  image.ApplyScalarFunction(ratioTest, _prevImageGray, ratioImg);
+  image.ApplyScalarFunction(ratioTest, prevImage, ratioImg);
 
-#endif
-  
   return numAboveThresh;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+s32 MotionDetector::RatioTest(const ImageType& image, const ImageType& prevImage, Vision::Image& ratioImg,
+                              bool useSIMD, const UnitTestKey& key)
+{
+#if defined(__SSE2__) && !defined(__ARM_NEON__)
+  if(useSIMD)
+  {
+    return RatioTestSSE(image, prevImage, ratioImg);
+  }
+#endif
+
+  return RatioTestScalar(image, prevImage, ratioImg);
+}
+
+template s32 MotionDetector::RatioTest(const Vision::Image&, const Vision::Image&, Vision::Image&,
+                                       bool, const UnitTestKey&);
+template s32 MotionDetector::RatioTest(const Vision::ImageRGB&, const Vision::ImageRGB&, Vision::Image&,
+                                       bool, const UnitTestKey&);
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Vision::ImageCacheSize MotionDetector::GetImageCacheSize()
+{
+  return Vision::ImageCache::GetSize(kMotionDetection_ScaleMultiplier);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result MotionDetector::Detect(Vision::ImageCache&     imageCache,
                               const VisionPoseData&   crntPoseData,
@@ -486,7 +533,7 @@ Result MotionDetector::Detect(Vision::ImageCache&     imageCache,
                               std::list<ExternalInterface::RobotObservedMotion>& observedMotions,
                               Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
-  const Vision::ImageCacheSize imageSize = Vision::ImageCache::GetSize(kMotionDetection_ScaleMultiplier);
+  const Vision::ImageCacheSize imageSize = GetImageCacheSize();
 
   // Call the right helper based on image's color
   if(imageCache.HasColor())
@@ -18,6 +18,7 @@
 #include "coretech/vision/engine/compressedImage.h"
 #include "coretech/vision/engine/debugImageList.h"
 #include "coretech/vision/engine/image.h"
+#include "coretech/vision/engine/imageCache.h"
 
 #include "clad/externalInterface/messageEngineToGame.h"
 
@@ -38,6 +39,7 @@ namespace Vector {
 // Forward declaration:
 struct VisionPoseData;
 
+class UnitTestKey;
 class VizManager;
 
 namespace {
@@ -76,6 +78,16 @@ public:
 
   ~MotionDetector();
 
+  // The ImageCache size Detect() will request (so it can be computed ahead of time)
+  static Vision::ImageCacheSize GetImageCacheSize();
+
+  // Runs the ratio test of image against prevImage with either the platform's SIMD implementation (SSE2 builds
+  // only, otherwise the scalar one is used regardless) or the scalar reference implementation, so unit tests can
+  // check that the two agree
+  template<class ImageType>
+  static s32 RatioTest(const ImageType& image, const ImageType& prevImage, Vision::Image& ratioImg,
+                       bool useSIMD, const UnitTestKey& key);
+
 private:
 
   template<class ImageType>
@@ -114,6 +126,13 @@ private:
   template<class ImageType>
   s32 RatioTestNeon(const ImageType& image, Vision::Image& ratioImg);
 
+  template<class ImageType>
+  static s32 RatioTestSSE(const ImageType& image, const ImageType& prevImage, Vision::Image& ratioImg);
+
+  // Reference implementations, used when there is no SIMD version for the platform
+  static s32 RatioTestScalar(const Vision::Image& image,    const Vision::Image& prevImage,    Vision::Image& ratioImg);
+  static s32 RatioTestScalar(const Vision::ImageRGB& image, const Vision::ImageRGB& prevImage, Vision::Image& ratioImg);
+
   // Returns the number of times the ratio between the pixels in image and the pixels
   // in the previous image is above a threshold. The corresponding pixels in ratio12
   // will be set to 255
@@ -143,6 +162,12 @@ private:
                                  u8*& ratioImgPtr,
                                  u32 numElementsToProcess);
 
+  template<class ImageType>
+  static inline s32 RatioTestSSEHelper(const u8* imagePtr,
+                                const u8* prevImagePtr,
+                                u8* ratioImgPtr,
+                                u32 numElementsToProcess);
+
   // The joy of pimpl :)
   class ImageRegionSelector;
   std::unique_ptr<ImageRegionSelector> _regionSelector;
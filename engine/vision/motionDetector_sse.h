@@ -0,0 +1,244 @@
+/**
+ * File: motionDetector_sse.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Implementations of SSE2 optimized motion detector functions, for x86 builds (simulator and
+ *              offline replay). Unlike the neon versions, the ratio is computed with an exact division so
+ *              results match the scalar implementation bit for bit.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_Cozmo_Basestation_MotionDetector_SSE_H__
+#define __Anki_Cozmo_Basestation_MotionDetector_SSE_H__
+
+#include "engine/vision/motionDetector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Anki {
+namespace Vector {
+
+#if defined(__SSE2__)
+
+namespace {
+
+// Number of u8 elements processed per SSE register
+constexpr u32 kSSEBytesPerLoop = 16;
+
+// Returns 0xFF in every byte lane where a > min, and 0 elsewhere. There are no unsigned byte comparisons in
+// SSE2, so use a >= min+1  <=>  max(a, min+1) == a. minPlusOne must not have overflowed.
+inline __m128i BrighterThanSSE(const __m128i& a, const __m128i& minPlusOne)
+{
+  return _mm_cmpeq_epi8(_mm_max_epu8(a, minPlusOne), a);
+}
+
+// Ratio of the larger to the smaller of a and b (clamped to at least 1), for 4 lanes that have been widened to s32
+inline __m128 RatioAboveThreshSSE(const __m128i& hi32, const __m128i& lo32, const __m128& kOnes, const __m128& kThresh)
+{
+  const __m128 ratio = _mm_div_ps(_mm_cvtepi32_ps(hi32), _mm_max_ps(_mm_cvtepi32_ps(lo32), kOnes));
+  return _mm_cmpgt_ps(ratio, kThresh);
+}
+
+// Returns 0xFF in every byte lane where max(a,b) / max(1, min(a,b)) > threshold, and 0 elsewhere.
+// Matches RatioTestHelper() exactly, since the same float division is performed per lane.
+inline __m128i RatioTestBytesSSE(const __m128i& a, const __m128i& b)
+{
+  const __m128i kZeros  = _mm_setzero_si128();
+  const __m128  kOnes   = _mm_set1_ps(1.f);
+  const __m128  kThresh = _mm_set1_ps(kMotionDetection_RatioThreshold);
+
+  const __m128i hi = _mm_max_epu8(a, b);
+  const __m128i lo = _mm_min_epu8(a, b);
+
+  // Widen u8 -> u16 -> s32 (4 groups of 4 lanes)
+  const __m128i hi16_lo = _mm_unpacklo_epi8(hi, kZeros);
+  const __m128i hi16_hi = _mm_unpackhi_epi8(hi, kZeros);
+  const __m128i lo16_lo = _mm_unpacklo_epi8(lo, kZeros);
+  const __m128i lo16_hi = _mm_unpackhi_epi8(lo, kZeros);
+
+  const __m128 above0 = RatioAboveThreshSSE(_mm_unpacklo_epi16(hi16_lo, kZeros), _mm_unpacklo_epi16(lo16_lo, kZeros), kOnes, kThresh);
+  const __m128 above1 = RatioAboveThreshSSE(_mm_unpackhi_epi16(hi16_lo, kZeros), _mm_unpackhi_epi16(lo16_lo, kZeros), kOnes, kThresh);
+  const __m128 above2 = RatioAboveThreshSSE(_mm_unpacklo_epi16(hi16_hi, kZeros), _mm_unpacklo_epi16(lo16_hi, kZeros), kOnes, kThresh);
+  const __m128 above3 = RatioAboveThreshSSE(_mm_unpackhi_epi16(hi16_hi, kZeros), _mm_unpackhi_epi16(lo16_hi, kZeros), kOnes, kThresh);
+
+  // Narrow the all-ones/all-zeros masks back down to bytes (signed saturation keeps -1 as -1)
+  const __m128i above16_lo = _mm_packs_epi32(_mm_castps_si128(above0), _mm_castps_si128(above1));
+  const __m128i above16_hi = _mm_packs_epi32(_mm_castps_si128(above2), _mm_castps_si128(above3));
+  return _mm_packs_epi16(above16_lo, above16_hi);
+}
+
+} // namespace
+
+template<>
+inline s32 MotionDetector::RatioTestSSEHelper<Vision::Image>(const u8* imagePtr,
+                                                             const u8* prevImagePtr,
+                                                             u8* ratioImgPtr,
+                                                             u32 numElementsToProcess)
+{
+  s32 numAboveThresh = 0;
+  u32 i = 0;
+
+  // A min brightness of 255 can never be exceeded, and would overflow below, so leave it all to the scalar loop
+  if(kMotionDetection_MinBrightness < 255)
+  {
+    const __m128i kMinBrightnessPlusOne = _mm_set1_epi8(static_cast<char>(kMotionDetection_MinBrightness + 1));
+
+    for(; i + kSSEBytesPerLoop <= numElementsToProcess; i += kSSEBytesPerLoop)
+    {
+      const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(imagePtr + i));
+      const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prevImagePtr + i));
+
+      //   p1 > kMotionDetection_MinBrightness && p2 > kMotionDetection_MinBrightness
+      const __m128i bothGtMin = _mm_and_si128(BrighterThanSSE(p1, kMinBrightnessPlusOne),
+                                              BrighterThanSSE(p2, kMinBrightnessPlusOne));
+
+      //   ratio > kMotionDetection_RatioThreshold
+      const __m128i pixelVal = _mm_and_si128(bothGtMin, RatioTestBytesSSE(p1, p2));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(ratioImgPtr + i), pixelVal);
+      numAboveThresh += __builtin_popcount(_mm_movemask_epi8(pixelVal));
+    }
+  }
+
+  // Process any extra elements one by one
+  for(; i < numElementsToProcess; i++)
+  {
+    const u8 p1 = imagePtr[i];
+    const u8 p2 = prevImagePtr[i];
+
+    u8 pixelVal = 0;
+    if(p1 > kMotionDetection_MinBrightness &&
+       p2 > kMotionDetection_MinBrightness)
+    {
+      const f32 ratio = RatioTestHelper(p1, p2);
+      if(ratio > kMotionDetection_RatioThreshold)
+      {
+        ++numAboveThresh;
+        pixelVal = 255; // use 255 because it will actually display
+      }
+    }
+    ratioImgPtr[i] = pixelVal;
+  }
+
+  return numAboveThresh;
+}
+
+template<>
+inline s32 MotionDetector::RatioTestSSEHelper<Vision::ImageRGB>(const u8* imagePtr,
+                                                                const u8* prevImagePtr,
+                                                                u8* ratioImgPtr,
+                                                                u32 numElementsToProcess)
+{
+  s32 numAboveThresh = 0;
+  u32 i = 0;
+
+  const u32 kSizeOfRGBElement = 3;
+
+  if(kMotionDetection_MinBrightness < 255)
+  {
+    const __m128i kMinBrightnessPlusOne = _mm_set1_epi8(static_cast<char>(kMotionDetection_MinBrightness + 1));
+
+    // 16 pixels at a time, i.e. three registers of interleaved RGB data. Deinterleaving isn't worth it in SSE2, so
+    // compute the per-channel tests on the interleaved data and then combine the channels of each pixel
+    const u32 kNumElementsProcessedPerLoop = kSSEBytesPerLoop;
+    const u32 kNumBytesPerLoop = kNumElementsProcessedPerLoop * kSizeOfRGBElement;
+
+    alignas(16) u8 bothGtMin[kNumBytesPerLoop];
+    alignas(16) u8 aboveThresh[kNumBytesPerLoop];
+
+    for(; i + kNumElementsProcessedPerLoop <= numElementsToProcess; i += kNumElementsProcessedPerLoop)
+    {
+      const u8* p1Ptr = imagePtr     + i * kSizeOfRGBElement;
+      const u8* p2Ptr = prevImagePtr + i * kSizeOfRGBElement;
+
+      for(u32 j = 0; j < kNumBytesPerLoop; j += kSSEBytesPerLoop)
+      {
+        const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p1Ptr + j));
+        const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p2Ptr + j));
+
+        const __m128i gtMin = _mm_and_si128(BrighterThanSSE(p1, kMinBrightnessPlusOne),
+                                            BrighterThanSSE(p2, kMinBrightnessPlusOne));
+        _mm_store_si128(reinterpret_cast<__m128i*>(bothGtMin + j),   gtMin);
+        _mm_store_si128(reinterpret_cast<__m128i*>(aboveThresh + j), RatioTestBytesSSE(p1, p2));
+      }
+
+      //   p1.IsBrighterThan(kMotionDetection_MinBrightness) && p2.IsBrighterThan(kMotionDetection_MinBrightness) &&
+      //   (ratioR > kMotionDetection_RatioThreshold || ratioG > ... || ratioB > ...)
+      for(u32 k = 0; k < kNumElementsProcessedPerLoop; ++k)
+      {
+        const u8* gtMin = bothGtMin   + k * kSizeOfRGBElement;
+        const u8* above = aboveThresh + k * kSizeOfRGBElement;
+        const u8 pixelVal = (gtMin[0] & gtMin[1] & gtMin[2]) & (above[0] | above[1] | above[2]);
+        ratioImgPtr[i + k] = pixelVal;
+        numAboveThresh += (pixelVal != 0);
+      }
+    }
+  }
+
+  const Vision::PixelRGB* imagePtr2     = reinterpret_cast<const Vision::PixelRGB*>(imagePtr);
+  const Vision::PixelRGB* prevImagePtr2 = reinterpret_cast<const Vision::PixelRGB*>(prevImagePtr);
+
+  // Process any extra elements one by one
+  for(; i < numElementsToProcess; i++)
+  {
+    const Vision::PixelRGB& p1 = imagePtr2[i];
+    const Vision::PixelRGB& p2 = prevImagePtr2[i];
+
+    u8 pixelVal = 0;
+    if(p1.IsBrighterThan(kMotionDetection_MinBrightness) &&
+       p2.IsBrighterThan(kMotionDetection_MinBrightness))
+    {
+      const f32 ratioR = RatioTestHelper(p1.r(), p2.r());
+      const f32 ratioG = RatioTestHelper(p1.g(), p2.g());
+      const f32 ratioB = RatioTestHelper(p1.b(), p2.b());
+      if(ratioR > kMotionDetection_RatioThreshold ||
+         ratioG > kMotionDetection_RatioThreshold ||
+         ratioB > kMotionDetection_RatioThreshold)
+      {
+        ++numAboveThresh;
+        pixelVal = 255; // use 255 because it will actually display
+      }
+    }
+    ratioImgPtr[i] = pixelVal;
+  }
+
+  return numAboveThresh;
+}
+
+template<class ImageType>
+s32 MotionDetector::RatioTestSSE(const ImageType& image, const ImageType& prevImage, Vision::Image& ratioImg)
+{
+  s32 numAboveThresh = 0;
+
+  u32 numRows = image.GetNumRows();
+  u32 numElementsToProcessAtATime = image.GetNumCols();
+
+  if(image.IsContinuous() && prevImage.IsContinuous() && ratioImg.IsContinuous())
+  {
+    numElementsToProcessAtATime *= numRows;
+    numRows = 1;
+  }
+
+  for(u32 i = 0; i < numRows; i++)
+  {
+    const u8* imagePtr     = reinterpret_cast<const u8*>(image.GetRow(i));
+    const u8* prevImagePtr = reinterpret_cast<const u8*>(prevImage.GetRow(i));
+    u8*       ratioImgPtr  = reinterpret_cast<u8*>(ratioImg.GetRow(i));
+
+    numAboveThresh += RatioTestSSEHelper<ImageType>(imagePtr, prevImagePtr, ratioImgPtr, numElementsToProcessAtATime);
+  }
+
+  return numAboveThresh;
+}
+
+#endif // defined(__SSE2__)
+
+}
+}
+
+#endif // __Anki_Cozmo_Basestation_MotionDetector_SSE_H__
@@ -0,0 +1,294 @@
+/**
+ * File: visionModeTaskGraph.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: See header.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "engine/vision/visionModeTaskGraph.h"
+
+#include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+
+#define LOG_CHANNEL "VisionSystem"
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionModeTaskGraph::~VisionModeTaskGraph()
+{
+  StopWorkers();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::AddTask(VisionMode mode, const std::set<VisionMode>& dependencies, TaskFcn&& fcn)
+{
+  if(HasTask(mode))
+  {
+    LOG_ERROR("VisionModeTaskGraph.AddTask.DuplicateMode", "Already have a task for %s", EnumToString(mode));
+    return;
+  }
+
+  _tasks.emplace_back();
+  Task& task = _tasks.back();
+  task.mode = mode;
+  task.dependencies = dependencies;
+  task.fcn = std::move(fcn);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool VisionModeTaskGraph::HasTask(VisionMode mode) const
+{
+  for(const auto& task : _tasks)
+  {
+    if(task.mode == mode)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool VisionModeTaskGraph::ComputeLevels(std::vector<std::vector<size_t>>& levels) const
+{
+  levels.clear();
+
+  // Only dependencies on modes which actually have a task in this graph count
+  std::set<VisionMode> modesInGraph;
+  for(const auto& task : _tasks)
+  {
+    modesInGraph.insert(task.mode);
+  }
+
+  std::set<VisionMode> modesDone;
+  std::vector<bool> isAssigned(_tasks.size(), false);
+  size_t numAssigned = 0;
+
+  while(numAssigned < _tasks.size())
+  {
+    std::vector<size_t> level;
+    for(size_t iTask=0; iTask < _tasks.size(); ++iTask)
+    {
+      if(isAssigned[iTask])
+      {
+        continue;
+      }
+
+      bool isReady = true;
+      for(const auto& dependency : _tasks[iTask].dependencies)
+      {
+        if(modesInGraph.count(dependency) > 0 && modesDone.count(dependency) == 0)
+        {
+          isReady = false;
+          break;
+        }
+      }
+
+      if(isReady)
+      {
+        level.push_back(iTask);
+      }
+    }
+
+    if(level.empty())
+    {
+      // Nothing could be scheduled: there must be a cycle. Run everything left, in order.
+      for(size_t iTask=0; iTask < _tasks.size(); ++iTask)
+      {
+        if(!isAssigned[iTask])
+        {
+          level.push_back(iTask);
+        }
+      }
+      levels.emplace_back(std::move(level));
+      return false;
+    }
+
+    for(const size_t iTask : level)
+    {
+      isAssigned[iTask] = true;
+      modesDone.insert(_tasks[iTask].mode);
+    }
+    numAssigned += level.size();
+    levels.emplace_back(std::move(level));
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::RunTask(const size_t iTask)
+{
+  Task& task = _tasks[iTask];
+  task.lastResult = task.fcn(task.partialResult);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::RunLevel(const std::vector<size_t>& level, u32 maxNumThreads)
+{
+  if(maxNumThreads <= 1 || level.size() == 1)
+  {
+    for(const size_t iTask : level)
+    {
+      RunTask(iTask);
+    }
+    return;
+  }
+
+  if(_workers.size() != maxNumThreads-1)
+  {
+    StopWorkers();
+    StartWorkers(maxNumThreads-1);
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _pendingTasks.insert(_pendingTasks.end(), level.begin()+1, level.end());
+  lock.unlock();
+  _workAvailable.notify_all();
+
+  // This thread runs the first task, then helps with whatever the workers haven't picked up yet
+  RunTask(level.front());
+
+  lock.lock();
+  while(RunPendingTask(lock)) { }
+  _workDone.wait(lock, [this] { return _numRunningTasks == 0; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool VisionModeTaskGraph::RunPendingTask(std::unique_lock<std::mutex>& lock)
+{
+  if(_pendingTasks.empty())
+  {
+    return false;
+  }
+
+  const size_t iTask = _pendingTasks.front();
+  _pendingTasks.pop_front();
+  ++_numRunningTasks;
+  lock.unlock();
+
+  RunTask(iTask);
+
+  lock.lock();
+  --_numRunningTasks;
+  if(_numRunningTasks == 0 && _pendingTasks.empty())
+  {
+    _workDone.notify_all();
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::WorkerLoop()
+{
+  Util::SetThreadName(pthread_self(), "VisionTasks");
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(!_stopWorkers)
+  {
+    if(!RunPendingTask(lock))
+    {
+      _workAvailable.wait(lock);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::StartWorkers(u32 numWorkers)
+{
+  LOG_INFO("VisionModeTaskGraph.StartWorkers", "Starting %u worker threads", numWorkers);
+
+  _stopWorkers = false;
+  _workers.reserve(numWorkers);
+  for(u32 i=0; i < numWorkers; ++i)
+  {
+    _workers.emplace_back(&VisionModeTaskGraph::WorkerLoop, this);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::StopWorkers()
+{
+  if(_workers.empty())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopWorkers = true;
+  }
+  _workAvailable.notify_all();
+
+  for(auto& worker : _workers)
+  {
+    worker.join();
+  }
+  _workers.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result VisionModeTaskGraph::Run(u32 maxNumThreads, VisionProcessingResult& result)
+{
+  std::vector<std::vector<size_t>> levels;
+  const bool noCycles = ComputeLevels(levels);
+  if(!noCycles)
+  {
+    LOG_ERROR("VisionModeTaskGraph.Run.DependencyCycle",
+              "Running %zu of %zu tasks serially", levels.back().size(), _tasks.size());
+  }
+
+  bool anyFailures = false;
+  for(size_t iLevel=0; iLevel < levels.size(); ++iLevel)
+  {
+    const bool isCycleLevel = (!noCycles && (iLevel == levels.size()-1));
+    RunLevel(levels[iLevel], (isCycleLevel ? 1 : maxNumThreads));
+
+    // Merge in the order tasks were added (not the order they finished) so output is deterministic
+    for(const size_t iTask : levels[iLevel])
+    {
+      Task& task = _tasks[iTask];
+      if(RESULT_OK != task.lastResult)
+      {
+        anyFailures = true;
+      }
+      MergeResult(std::move(task.partialResult), result);
+    }
+  }
+
+  Clear();
+
+  return (anyFailures ? RESULT_FAIL : RESULT_OK);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::MergeResult(VisionProcessingResult&& from, VisionProcessingResult& to)
+{
+  to.modesProcessed.Insert(from.modesProcessed.GetSet());
+
+  to.observedMotions.splice(to.observedMotions.end(), from.observedMotions);
+  to.observedMarkers.splice(to.observedMarkers.end(), from.observedMarkers);
+  to.faces.splice(to.faces.end(), from.faces);
+  to.pets.splice(to.pets.end(), from.pets);
+  to.overheadEdges.splice(to.overheadEdges.end(), from.overheadEdges);
+  to.updatedFaceIDs.splice(to.updatedFaceIDs.end(), from.updatedFaceIDs);
+  to.laserPoints.splice(to.laserPoints.end(), from.laserPoints);
+  to.cameraCalibration.splice(to.cameraCalibration.end(), from.cameraCalibration);
+  to.visualObstacles.splice(to.visualObstacles.end(), from.visualObstacles);
+  to.salientPoints.splice(to.salientPoints.end(), from.salientPoints);
+  to.debugImages.splice(to.debugImages.end(), from.debugImages);
+
+  if(from.modesProcessed.Contains(VisionMode::Illumination))
+  {
+    to.illumination = std::move(from.illumination);
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
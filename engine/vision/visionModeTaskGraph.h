@@ -0,0 +1,113 @@
+/**
+ * File: visionModeTaskGraph.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Small dependency graph of per-VisionMode processing tasks, run in topologically-sorted levels.
+ *              Independent tasks within a level can be run concurrently on a small pool of persistent worker
+ *              threads owned by the graph, which are started the first time they are needed. Each task
+ *              writes into its own partial VisionProcessingResult, and partial results are merged into the
+ *              frame's result in the order tasks were added, after each level completes, so that the merged
+ *              result does not depend on thread timing.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_Vector_Engine_VisionModeTaskGraph_H__
+#define __Anki_Vector_Engine_VisionModeTaskGraph_H__
+
+#include "engine/vision/visionProcessingResult.h"
+
+#include "clad/types/visionModes.h"
+
+#include "coretech/common/shared/types.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class VisionModeTaskGraph
+{
+public:
+
+  VisionModeTaskGraph() = default;
+  ~VisionModeTaskGraph();
+
+  // A task fills in the given (initially empty) partial result and returns RESULT_OK on success. It is
+  // responsible for inserting whatever modes it processed into partialResult.modesProcessed.
+  // Tasks may read (but not write) the result passed to Run(), which contains everything merged from
+  // earlier levels, including the outputs of all the task's dependencies.
+  using TaskFcn = std::function<Result(VisionProcessingResult& partialResult)>;
+
+  // Add a task for the given mode. Dependencies on modes which have no task in the graph are ignored
+  // (e.g. because that mode is not enabled this frame). Adding a second task for the same mode is an error.
+  void AddTask(VisionMode mode, const std::set<VisionMode>& dependencies, TaskFcn&& fcn);
+
+  // Runs all tasks and merges their partial results into 'result'. With maxNumThreads=1 everything runs
+  // on the calling thread, in the order added (dependencies permitting). Otherwise, the calling thread and
+  // maxNumThreads-1 persistent workers share the tasks of each level. The workers are (re)started only
+  // when maxNumThreads changes.
+  // Returns RESULT_FAIL if any task failed (all tasks are still run). Clears the graph when done.
+  Result Run(u32 maxNumThreads, VisionProcessingResult& result);
+
+  bool   HasTask(VisionMode mode) const;
+  bool   IsEmpty() const { return _tasks.empty(); }
+  size_t GetNumTasks() const { return _tasks.size(); }
+
+  void Clear() { _tasks.clear(); }
+
+  // Moves all detections, debug images, and processed modes from 'from' into 'to'
+  static void MergeResult(VisionProcessingResult&& from, VisionProcessingResult& to);
+
+private:
+
+  struct Task
+  {
+    VisionMode               mode;
+    std::set<VisionMode>     dependencies;
+    TaskFcn                  fcn;
+    VisionProcessingResult   partialResult;
+    Result                   lastResult = RESULT_OK;
+  };
+
+  // Groups task indices into levels: tasks in a level depend only on tasks in earlier levels.
+  // Returns false if there is a dependency cycle, in which case the remaining tasks are put in
+  // one final level in the order added.
+  bool ComputeLevels(std::vector<std::vector<size_t>>& levels) const;
+
+  void RunLevel(const std::vector<size_t>& level, u32 maxNumThreads);
+
+  void RunTask(size_t iTask);
+
+  // Worker pool
+  void StartWorkers(u32 numWorkers);
+  void StopWorkers();
+  void WorkerLoop();
+
+  // Pops a pending task and runs it, if there is one. Called with _mutex held (via lock), returns with it held.
+  bool RunPendingTask(std::unique_lock<std::mutex>& lock);
+
+  std::vector<Task> _tasks;
+
+  std::vector<std::thread> _workers;
+  std::mutex               _mutex;
+  std::condition_variable  _workAvailable;
+  std::condition_variable  _workDone;
+  std::deque<size_t>       _pendingTasks;     // indices into _tasks waiting to be picked up
+  size_t                   _numRunningTasks = 0;
+  bool                     _stopWorkers     = false;
+
+}; // class VisionModeTaskGraph
+
+} // namespace Vector
+} // namespace Anki
+
+#endif /* __Anki_Vector_Engine_VisionModeTaskGraph_H__ */
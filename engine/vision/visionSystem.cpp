@@ -31,6 +31,7 @@
 #include "engine/vision/motionDetector.h"
 #include "engine/vision/overheadEdgesDetector.h"
 #include "engine/vision/overheadMap.h"
+#include "engine/vision/visionModeTaskGraph.h"
 #include "engine/vision/visionModesHelpers.h"
 #include "engine/utils/cozmoFeatureGate.h"
 
@@ -124,6 +125,10 @@ CONSOLE_VAR_RANGED(f32, kFakeCatDetectionProbability,  "Vision.NeuralNets", 0.f,
 CONSOLE_VAR_RANGED(f32, kFakeDogDetectionProbability,  "Vision.NeuralNets", 0.f, 0.f, 1.f);
 
 CONSOLE_VAR(bool, kDisplayUndistortedImages,"Vision.General", false);
+
+// Max number of threads (including the vision thread) used to run independent detectors concurrently. 1 runs
+// everything serially on the vision thread.
+CONSOLE_VAR_RANGED(u32, kVisionSystem_MaxDetectionThreads, "Vision.General", 1, 1, 4);
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 namespace {
@@ -162,6 +167,7 @@ VisionSystem::VisionSystem(const CozmoContext* context)
 , _imageSaver(new ImageSaver())
 , _mirrorModeManager(new MirrorModeManager())
 , _benchmark(new Vision::Benchmark())
+, _detectionTaskGraph(new VisionModeTaskGraph())
 , _clahe(cv::createCLAHE())
 {
   DEV_ASSERT(_context != nullptr, "VisionSystem.Constructor.NullContext");
@@ -780,7 +786,7 @@ Vision::Image BlackOutRects(const Vision::Image& img, const std::vector<Anki::Re
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Anki::Rectangle<s32>>& detectionRects,
-                                 const bool useCropping)
+                                 const bool useCropping, VisionProcessingResult& processingResult)
 {
   DEV_ASSERT(_faceTracker != nullptr, "VisionSystem.DetectFaces.NullFaceTracker");
  
@@ -824,19 +830,19 @@ Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Ank
     Vision::Image maskedImage = BlackOutRects(grayImage, detectionRects);
     
 #     if DEBUG_FACE_DETECTION
-    //_currentResult.debugImages.push_back({"MaskedFaceImage", maskedImage});
+    //processingResult.debugImages.push_back({"MaskedFaceImage", maskedImage});
 #     endif
     
-    _faceTracker->Update(maskedImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs,
-                         _currentResult.debugImages);
+    _faceTracker->Update(maskedImage, cropFactor, processingResult.faces, processingResult.updatedFaceIDs,
+                         processingResult.debugImages);
   }
   else
   {
     // Nothing already detected, so nothing to black out before looking for faces
-    _faceTracker->Update(grayImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, _currentResult.debugImages);
+    _faceTracker->Update(grayImage, cropFactor, processingResult.faces, processingResult.updatedFaceIDs, processingResult.debugImages);
   }
   
-  for(auto faceIter = _currentResult.faces.begin(); faceIter != _currentResult.faces.end(); ++faceIter)
+  for(auto faceIter = processingResult.faces.begin(); faceIter != processingResult.faces.end(); ++faceIter)
   {
     auto & currentFace = *faceIter;
     
@@ -873,27 +879,28 @@ Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Ank
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::DetectPets(Vision::ImageCache& imageCache,
-                                std::vector<Anki::Rectangle<s32>>& detections)
+                                std::vector<Anki::Rectangle<s32>>& detections,
+                                VisionProcessingResult& processingResult)
 {
   const Vision::Image& grayImage = imageCache.GetGray();
   Result result = RESULT_FAIL;
   
   if(detections.empty())
   {
-    result = _petTracker->Update(grayImage, _currentResult.pets);
+    result = _petTracker->Update(grayImage, processingResult.pets);
   }
   else
   {
     // Don't look for pets where we've already found something else
     Vision::Image maskedImage = BlackOutRects(grayImage, detections);
-    result = _petTracker->Update(maskedImage, _currentResult.pets);
+    result = _petTracker->Update(maskedImage, processingResult.pets);
   }
   
   if(RESULT_OK != result) {
     PRINT_NAMED_WARNING("VisionSystem.DetectPets.PetTrackerUpdateFailed", "");
   }
   
-  for(auto const& pet : _currentResult.pets)
+  for(auto const& pet : processingResult.pets)
   {
     detections.emplace_back((s32)std::round(pet.GetRect().GetX()),
                             (s32)std::round(pet.GetRect().GetY()),
@@ -905,63 +912,64 @@ Result VisionSystem::DetectPets(Vision::ImageCache& imageCache,
 } // DetectPets()
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult)
 {
 
   Result result = RESULT_OK;
   
   _motionDetector->Detect(imageCache, _poseData, _prevPoseData,
-                          _currentResult.observedMotions, _currentResult.debugImages);
+                          processingResult.observedMotions, processingResult.debugImages);
   
   return result;
   
 } // DetectMotion()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectBrightColors(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectBrightColors(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.DetectBrightColors.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _brightColorDetector->Detect(image, _currentResult.salientPoints);
+  Result result = _brightColorDetector->Detect(image, processingResult.salientPoints);
   return result;
 } // DetectBrightColors()
 
-Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateOverheadMap.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _overheadMap->Update(image, _poseData, _currentResult.debugImages);
+  Result result = _overheadMap->Update(image, _poseData, processingResult.debugImages);
   return result;
 }
 
-Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache,
+                                                 VisionProcessingResult& processingResult)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateGroundPlaneClassifier.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _groundPlaneClassifier->Update(image, _poseData, _currentResult.debugImages,
-                                                 _currentResult.visualObstacles);
+  Result result = _groundPlaneClassifier->Update(image, _poseData, processingResult.debugImages,
+                                                 processingResult.visualObstacles);
   return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult)
 {
   const bool isDarkExposure = (Util::IsNear(_currentCameraParams.exposureTime_ms, GetMinCameraExposureTime_ms()) &&
                                Util::IsNear(_currentCameraParams.gain, GetMinCameraGain()));
   
   Result result = _laserPointDetector->Detect(imageCache, _poseData, isDarkExposure,
-                                              _currentResult.laserPoints,
-                                              _currentResult.debugImages);
+                                              processingResult.laserPoints,
+                                              processingResult.debugImages);
   
   return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectIllumination(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectIllumination(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult)
 {
   Result result = _illuminationDetector->Detect(imageCache, 
                                                 _poseData, 
-                                                _currentResult.illumination);
+                                                processingResult.illumination);
   return result;
 }
 
@@ -1098,7 +1106,8 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
                                   const Vision::Image& claheImage,
                                   std::vector<Anki::Rectangle<s32>>& detectionRects,
                                   MarkerDetectionCLAHE useCLAHE,
-                                  const VisionPoseData& poseData)
+                                  const VisionPoseData& poseData,
+                                  VisionProcessingResult& processingResult)
 {
   // Currently assuming we detect markers first, so we won't make use of anything already detected
   DEV_ASSERT(detectionRects.empty(), "VisionSystem.DetectMarkersWithCLAHE.ExpectingEmptyDetectionRects");
@@ -1197,13 +1206,13 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       // NOTE: by definition of the Ready and Reset periods, we're guaranteed
       //  to have run MarkerDetection in the same frame we trigger a Reset
       DEV_ASSERT_MSG(shouldRunOnComposite, "VisionSystem.DetectMarkers.InvalidResetCallBeforeImageUsed","");
-      _currentResult.modesProcessed.Insert(VisionMode::Markers_Composite);
+      processingResult.modesProcessed.Insert(VisionMode::Markers_Composite);
     }
   }
 
   #if(DEBUG_IMAGE_COMPOSITING)
   if(!dispCompositeImg.IsEmpty()) {
-    _currentResult.debugImages.emplace_back("ImageCompositing", dispCompositeImg);
+    processingResult.debugImages.emplace_back("ImageCompositing", dispCompositeImg);
   }
   #endif
   
@@ -1219,7 +1228,7 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
   if(IsModeEnabled(VisionMode::Markers_FullFrame))
   {
     cropRect = Rectangle<s32>(0,0,imagePtrs.front()->GetNumCols(), imagePtrs.front()->GetNumRows());
-    _currentResult.modesProcessed.Insert(VisionMode::Markers_FullFrame);
+    processingResult.modesProcessed.Insert(VisionMode::Markers_FullFrame);
   }
   else
   {
@@ -1239,8 +1248,8 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
     
     DEV_ASSERT(cropRect.Area() > 0, "VisionSystem.DetectMarkersWithCLAHE.EmptyCrop");
     
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
+    processingResult.modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
+    processingResult.modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
   }
   
   Result lastResult = RESULT_OK;
@@ -1251,7 +1260,7 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
                "VisionSystem.DetectMarkersWithCLAHE.DifferingImageSizes");
     
     const Vision::Image& imgROI = imgPtr->GetROI(cropRect);
-    lastResult = _markerDetector->Detect(imgROI, _currentResult.observedMarkers);
+    lastResult = _markerDetector->Detect(imgROI, processingResult.observedMarkers);
     if(RESULT_OK != lastResult) {
       break;
     }
@@ -1261,26 +1270,26 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
     {
       Vision::ImageRGB dispImg;
       dispImg.SetFromGray(imgROI);
-      for(auto const& marker : _currentResult.observedMarkers)
+      for(auto const& marker : processingResult.observedMarkers)
       {
         dispImg.DrawQuad(marker.GetImageCorners(), NamedColors::RED);
       }
       dispImg.DrawRect(Rectangle<s32>{0,0,cropRect.GetWidth(),cropRect.GetHeight()}, NamedColors::RED);
-      _currentResult.debugImages.emplace_back("CroppedMarkers", dispImg);
+      processingResult.debugImages.emplace_back("CroppedMarkers", dispImg);
     }
   }
 
   const bool meterFromChargerOnly = IsModeEnabled(VisionMode::Markers_ChargerOnly);
-  _currentResult.modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
+  processingResult.modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
   
-  auto markerIter = _currentResult.observedMarkers.begin();
-  while(markerIter != _currentResult.observedMarkers.end())
+  auto markerIter = processingResult.observedMarkers.begin();
+  while(markerIter != processingResult.observedMarkers.end())
   {
     auto & marker = *markerIter;
     
     if(meterFromChargerOnly && (marker.GetCode() != Vision::MARKER_CHARGER_HOME))
     {
-      markerIter = _currentResult.observedMarkers.erase(markerIter);
+      markerIter = processingResult.observedMarkers.erase(markerIter);
       continue;
     }
     
@@ -1346,7 +1355,7 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
         // Remove this OOB marker from the list entirely
         PRINT_CH_DEBUG(kLogChannelName, "VisionSystem.DetectMarkersWithCLAHE.RemovingMarkerOOB",
                        "%s", Vision::MarkerTypeStrings[marker.GetCode()]);
-        markerIter = _currentResult.observedMarkers.erase(markerIter);
+        markerIter = processingResult.observedMarkers.erase(markerIter);
         continue;
       }
       
@@ -1483,6 +1492,35 @@ void VisionSystem::UpdateRollingShutter(const VisionPoseData& poseData, const Vi
   _lastRollingShutterCorrectionTime = imageCache.GetTimeStamp();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionSystem::PrecomputeImageCacheSizes(Vision::ImageCache& imageCache)
+{
+  // ImageCache computes resized/converted images lazily on first request, so ask for everything the
+  // enabled detectors use here, before they run on multiple threads and only read from the cache.
+  Tic("PrecomputeImageCacheSizes");
+  
+  imageCache.GetGray();
+  imageCache.GetGray(imageCache.GetSize(kMarkerDetector_ScaleMultiplier));
+  
+  const bool hasColor = imageCache.HasColor();
+  if(hasColor)
+  {
+    imageCache.GetRGB();
+  }
+  
+  if(IsModeEnabled(VisionMode::Motion))
+  {
+    const Vision::ImageCacheSize motionSize = MotionDetector::GetImageCacheSize();
+    if(hasColor) {
+      imageCache.GetRGB(motionSize);
+    } else {
+      imageCache.GetGray(motionSize);
+    }
+  }
+  
+  Toc("PrecomputeImageCacheSizes");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::Update(const VisionSystemInput& input)
 {
@@ -1571,6 +1609,19 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
 
   bool anyModeFailures = false;
   
+  // Each detector below is added as a task in _detectionTaskGraph, with dependencies on any modes whose results
+  // it needs. With kVisionSystem_MaxDetectionThreads > 1, independent detectors run concurrently. Tasks write into
+  // their own partial results, which are merged into _currentResult in the order added here.
+  // NOTE: Vision::Profiler is not thread safe, so individual tasks are only timed when running single-threaded.
+  //       The Markers task is always added first, so that it runs on this thread and can always be profiled.
+  const u32 maxNumThreads = std::max(1u, kVisionSystem_MaxDetectionThreads);
+  const bool profileTasks = (maxNumThreads == 1);
+  
+  // Create all the detection rect entries up front, since tasks may fill their entries concurrently
+  for(const auto mode : {VisionMode::Markers, VisionMode::Faces, VisionMode::Pets})
+  {
+    detectionsByMode[mode];
+  }
   
   if(IsModeEnabled(VisionMode::Markers))
   {
@@ -1588,20 +1639,24 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
                                                                                   DEG_TO_RAD(kHeadTurnSpeedThreshBlock_degs)));
       if(!wasRotatingTooFast)
       {
-        // Marker detection uses rolling shutter compensation
-        UpdateRollingShutter(poseData, imageCache);
-        
-        Tic("TotalMarkers");
-        lastResult = DetectMarkers(imageCache, claheImage, detectionsByMode[VisionMode::Markers], useCLAHE, poseData);
-        
-        if(RESULT_OK != lastResult) {
-          PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
-          anyModeFailures = true;
-        } else {
-          visionModesProcessed.Insert(VisionMode::Markers);
-          visionModesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
-        }
-        Toc("TotalMarkers");
+        auto& markerRects = detectionsByMode[VisionMode::Markers];
+        _detectionTaskGraph->AddTask(VisionMode::Markers, {}, [&,this](VisionProcessingResult& processingResult) {
+          // Marker detection uses rolling shutter compensation
+          UpdateRollingShutter(poseData, imageCache);
+          
+          Tic("TotalMarkers");
+          const Result markerResult = DetectMarkers(imageCache, claheImage, markerRects, useCLAHE, poseData,
+                                                    processingResult);
+          
+          if(RESULT_OK != markerResult) {
+            PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
+          } else {
+            processingResult.modesProcessed.Insert(VisionMode::Markers);
+            processingResult.modesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
+          }
+          Toc("TotalMarkers");
+          return markerResult;
+        });
       }
     }
   }
@@ -1615,73 +1670,104 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   
   if(IsModeEnabled(VisionMode::Faces))
   {
-    const bool estimatingFacialExpression = IsModeEnabled(VisionMode::Faces_Expression);
-    _faceTracker->EnableEmotionDetection(estimatingFacialExpression);
-
-    const bool detectingSmile = IsModeEnabled(VisionMode::Faces_Smile);
-    _faceTracker->EnableSmileDetection(detectingSmile);
-
-    const bool detectingGaze = IsModeEnabled(VisionMode::Faces_Gaze);
-    _faceTracker->EnableGazeDetection(detectingGaze);
-
-    const bool detectingBlink = IsModeEnabled(VisionMode::Faces_Blink);
-    _faceTracker->EnableBlinkDetection(detectingBlink);
-
-    
-    Tic("TotalFaces");
-    // NOTE: To use rolling shutter in DetectFaces, call UpdateRollingShutterHere
-    // See: VIC-1417 
-    // UpdateRollingShutter(poseData, imageCache);
-    const bool useCropping = IsModeEnabled(VisionMode::Faces_Crop);
-    if((lastResult = DetectFaces(imageCache, detectionsByMode[VisionMode::Faces], useCropping)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Faces);
-      visionModesProcessed.Enable(VisionMode::Faces_Crop,          useCropping);
-      visionModesProcessed.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
-      visionModesProcessed.Enable(VisionMode::Faces_Smile,         detectingSmile);
-      visionModesProcessed.Enable(VisionMode::Faces_Gaze,          detectingGaze);
-      visionModesProcessed.Enable(VisionMode::Faces_Blink,         detectingBlink);
-    }
-    Toc("TotalFaces");
+    auto& faceRects = detectionsByMode[VisionMode::Faces];
+    _detectionTaskGraph->AddTask(VisionMode::Faces, {}, [&,this](VisionProcessingResult& processingResult) {
+      const bool estimatingFacialExpression = IsModeEnabled(VisionMode::Faces_Expression);
+      _faceTracker->EnableEmotionDetection(estimatingFacialExpression);
+      
+      const bool detectingSmile = IsModeEnabled(VisionMode::Faces_Smile);
+      _faceTracker->EnableSmileDetection(detectingSmile);
+      
+      const bool detectingGaze = IsModeEnabled(VisionMode::Faces_Gaze);
+      _faceTracker->EnableGazeDetection(detectingGaze);
+      
+      const bool detectingBlink = IsModeEnabled(VisionMode::Faces_Blink);
+      _faceTracker->EnableBlinkDetection(detectingBlink);
+      
+      if(profileTasks) {
+        Tic("TotalFaces");
+      }
+      // NOTE: To use rolling shutter in DetectFaces, call UpdateRollingShutterHere
+      // See: VIC-1417
+      // UpdateRollingShutter(poseData, imageCache);
+      const bool useCropping = IsModeEnabled(VisionMode::Faces_Crop);
+      const Result faceResult = DetectFaces(imageCache, faceRects, useCropping, processingResult);
+      if(RESULT_OK != faceResult) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
+      } else {
+        auto& modes = processingResult.modesProcessed;
+        modes.Insert(VisionMode::Faces);
+        modes.Enable(VisionMode::Faces_Crop,          useCropping);
+        modes.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
+        modes.Enable(VisionMode::Faces_Smile,         detectingSmile);
+        modes.Enable(VisionMode::Faces_Gaze,          detectingGaze);
+        modes.Enable(VisionMode::Faces_Blink,         detectingBlink);
+      }
+      if(profileTasks) {
+        Toc("TotalFaces");
+      }
+      return faceResult;
+    });
   }
   
   if(IsModeEnabled(VisionMode::Pets))
   {
-    Tic("TotalPets");
-    if((lastResult = DetectPets(imageCache, detectionsByMode[VisionMode::Pets])) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Pets);
-    }
-    Toc("TotalPets");
+    auto& petRects = detectionsByMode[VisionMode::Pets];
+    _detectionTaskGraph->AddTask(VisionMode::Pets, {}, [&,this](VisionProcessingResult& processingResult) {
+      if(profileTasks) {
+        Tic("TotalPets");
+      }
+      const Result petResult = DetectPets(imageCache, petRects, processingResult);
+      if(RESULT_OK != petResult) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
+      } else {
+        processingResult.modesProcessed.Insert(VisionMode::Pets);
+      }
+      if(profileTasks) {
+        Toc("TotalPets");
+      }
+      return petResult;
+    });
   }
   
   if(IsModeEnabled(VisionMode::Motion))
   {
-    Tic("TotalMotion");
-    if((lastResult = DetectMotion(imageCache)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Motion);
-    }
-    Toc("TotalMotion");
-  }
-
-  if(IsModeEnabled(VisionMode::BrightColors)){
-    if (imageCache.HasColor()){
-      Tic("TotalBrightColors");
-      lastResult = DetectBrightColors(imageCache);
-      Toc("TotalBrightColors");
-      if (lastResult != RESULT_OK){
-        PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
-        anyModeFailures = true;
+    _detectionTaskGraph->AddTask(VisionMode::Motion, {}, [&,this](VisionProcessingResult& processingResult) {
+      if(profileTasks) {
+        Tic("TotalMotion");
+      }
+      const Result motionResult = DetectMotion(imageCache, processingResult);
+      if(RESULT_OK != motionResult) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
       } else {
-        visionModesProcessed.Insert(VisionMode::BrightColors);
+        processingResult.modesProcessed.Insert(VisionMode::Motion);
+      }
+      if(profileTasks) {
+        Toc("TotalMotion");
       }
+      return motionResult;
+    });
+  }
+
+  if(IsModeEnabled(VisionMode::BrightColors))
+  {
+    if (imageCache.HasColor())
+    {
+      _detectionTaskGraph->AddTask(VisionMode::BrightColors, {}, [&,this](VisionProcessingResult& processingResult) {
+        if(profileTasks) {
+          Tic("TotalBrightColors");
+        }
+        const Result brightColorsResult = DetectBrightColors(imageCache, processingResult);
+        if(profileTasks) {
+          Toc("TotalBrightColors");
+        }
+        if (brightColorsResult != RESULT_OK){
+          PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
+        } else {
+          processingResult.modesProcessed.Insert(VisionMode::BrightColors);
+        }
+        return brightColorsResult;
+      });
     } else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process bright colors. No color image!");
     }
@@ -1689,15 +1775,21 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   // Disabling this while VisionMode::OverheadMap is disabled
   if (IsModeEnabled(VisionMode::OverheadMap))
   {
-    if (imageCache.HasColor()) {
-      Tic("UpdateOverheadMap");
-      lastResult = UpdateOverheadMap(imageCache);
-      Toc("UpdateOverheadMap");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::OverheadMap);
-      }
+    if (imageCache.HasColor())
+    {
+      _detectionTaskGraph->AddTask(VisionMode::OverheadMap, {}, [&,this](VisionProcessingResult& processingResult) {
+        if(profileTasks) {
+          Tic("UpdateOverheadMap");
+        }
+        const Result overheadMapResult = UpdateOverheadMap(imageCache, processingResult);
+        if(profileTasks) {
+          Toc("UpdateOverheadMap");
+        }
+        if (overheadMapResult == RESULT_OK) {
+          processingResult.modesProcessed.Insert(VisionMode::OverheadMap);
+        }
+        return overheadMapResult;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process overhead map. No color image!");
@@ -1706,23 +1798,118 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   
   if (IsModeEnabled(VisionMode::Obstacles))
   {
-    if (imageCache.HasColor()) {
-      Tic("DetectVisualObstacles");
-      lastResult = UpdateGroundPlaneClassifier(imageCache);
-      Toc("DetectVisualObstacles");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::Obstacles);
-      }
+    if (imageCache.HasColor())
+    {
+      _detectionTaskGraph->AddTask(VisionMode::Obstacles, {}, [&,this](VisionProcessingResult& processingResult) {
+        if(profileTasks) {
+          Tic("DetectVisualObstacles");
+        }
+        const Result obstaclesResult = UpdateGroundPlaneClassifier(imageCache, processingResult);
+        if(profileTasks) {
+          Toc("DetectVisualObstacles");
+        }
+        if (obstaclesResult == RESULT_OK) {
+          processingResult.modesProcessed.Insert(VisionMode::Obstacles);
+        }
+        return obstaclesResult;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process visual obstacles. No color image!");
     }
   }
+  
+  if(IsModeEnabled(VisionMode::Calibration))
+  {
+    // Marker detection needs to have run before trying to do single target calibration
+    _detectionTaskGraph->AddTask(VisionMode::Calibration, {VisionMode::Markers},
+                                 [&,this](VisionProcessingResult& processingResult) {
+      Result calibResult = RESULT_OK;
+      switch(kCalibTargetType)
+      {
+        case CameraCalibrator::CalibTargetType::CHECKERBOARD:
+        {
+          calibResult = _cameraCalibrator->ComputeCalibrationFromCheckerboard(processingResult.cameraCalibration,
+                                                                              processingResult.debugImages);
+          break;
+        }
+        case CameraCalibrator::CalibTargetType::QBERT:
+        case CameraCalibrator::CalibTargetType::INVERTED_BOX:
+        {
+          // Markers have already been merged into _currentResult, since Calibration depends on them
+          DEV_ASSERT(visionModesProcessed.Contains(VisionMode::Markers),
+                     "VisionSystem.Update.Calibration.MarkersNotDetected");
+          
+          CameraCalibrator::CalibTargetType targetType = static_cast<CameraCalibrator::CalibTargetType>(kCalibTargetType);
+          calibResult = _cameraCalibrator->ComputeCalibrationFromSingleTarget(targetType,
+                                                                              _currentResult.observedMarkers,
+                                                                              processingResult.cameraCalibration,
+                                                                              processingResult.debugImages);
+          break;
+        }
+      }
+      if(calibResult != RESULT_OK) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.ComputeCalibrationFailed", "");
+      } else {
+        processingResult.modesProcessed.Insert(VisionMode::Calibration);
+      }
+      return calibResult;
+    });
+  }
+  
+  // Check for illumination state
+  if(IsModeEnabled(VisionMode::Illumination) &&
+     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
+  {
+    _detectionTaskGraph->AddTask(VisionMode::Illumination, {}, [&,this](VisionProcessingResult& processingResult) {
+      if(profileTasks) {
+        Tic("Illumination");
+      }
+      const Result illuminationResult = DetectIllumination(imageCache, processingResult);
+      if(profileTasks) {
+        Toc("Illumination");
+      }
+      if (illuminationResult != RESULT_OK) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
+      } else {
+        processingResult.modesProcessed.Insert(VisionMode::Illumination);
+      }
+      return illuminationResult;
+    });
+  }
+  
+  // Only keep detection rects for modes which actually ran, so that the previous ones persist for metering otherwise
+  for(auto iter = detectionsByMode.begin(); iter != detectionsByMode.end(); )
+  {
+    if(_detectionTaskGraph->HasTask(iter->first)) {
+      ++iter;
+    } else {
+      iter = detectionsByMode.erase(iter);
+    }
+  }
+  
+  if(!_detectionTaskGraph->IsEmpty())
+  {
+    if(maxNumThreads > 1)
+    {
+      // Compute every image size the tasks will need now, so that they only read from the cache
+      PrecomputeImageCacheSizes(imageCache);
+      Tic("TotalDetectionTasks");
+    }
+    
+    lastResult = _detectionTaskGraph->Run(maxNumThreads, _currentResult);
+    if(RESULT_OK != lastResult) {
+      anyModeFailures = true;
+    }
+    
+    if(maxNumThreads > 1) {
+      Toc("TotalDetectionTasks");
+    }
+  }
 
   if(IsModeEnabled(VisionMode::OverheadEdges))
   {
+    // NOTE: Not a task because OverheadEdgesDetector shares this VisionSystem's (non thread safe) Profiler
     Tic("TotalOverheadEdges");
 
     lastResult = _overheadEdgeDetector->Detect(imageCache, _poseData, _currentResult);
@@ -1736,39 +1923,6 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     Toc("TotalOverheadEdges");
   }
   
-  if(IsModeEnabled(VisionMode::Calibration))
-  {
-    switch(kCalibTargetType)
-    {
-      case CameraCalibrator::CalibTargetType::CHECKERBOARD:
-      {
-        lastResult = _cameraCalibrator->ComputeCalibrationFromCheckerboard(_currentResult.cameraCalibration,
-                                                                           _currentResult.debugImages);
-        break;
-      }
-      case CameraCalibrator::CalibTargetType::QBERT:
-      case CameraCalibrator::CalibTargetType::INVERTED_BOX:
-      {
-        // Marker detection needs to have run before trying to do single target calibration
-        DEV_ASSERT(visionModesProcessed.Contains(VisionMode::Markers),
-                   "VisionSystem.Update.Calibration.MarkersNotDetected");
-        
-        CameraCalibrator::CalibTargetType targetType = static_cast<CameraCalibrator::CalibTargetType>(kCalibTargetType);
-        lastResult = _cameraCalibrator->ComputeCalibrationFromSingleTarget(targetType,
-                                                                           _currentResult.observedMarkers,
-                                                                           _currentResult.cameraCalibration,
-                                                                           _currentResult.debugImages);
-        break;
-      }
-    }
-    if(lastResult != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.ComputeCalibrationFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Calibration);
-    }
-  }
-  
   if(IsModeEnabled(VisionMode::Lasers))
   {
     // Skip laser point detection if the Laser FeatureGate is disabled.
@@ -1776,7 +1930,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     if(_context->GetFeatureGate()->IsFeatureEnabled(FeatureType::Laser))
     {
       Tic("TotalLasers");
-      if((lastResult = DetectLaserPoints(imageCache)) != RESULT_OK) {
+      if((lastResult = DetectLaserPoints(imageCache, _currentResult)) != RESULT_OK) {
         PRINT_NAMED_ERROR("VisionSystem.Update.DetectlaserPointsFailed", "");
         anyModeFailures = true;
       } else {
@@ -1831,21 +1985,6 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     }
   }
   
-  // Check for illumination state
-  if(IsModeEnabled(VisionMode::Illumination) &&
-     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
-  {
-    Tic("Illumination");
-    lastResult = DetectIllumination(imageCache);
-    Toc("Illumination");
-    if (lastResult != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Illumination);
-    }
-  }
-
   UpdateMeteringRegions(imageCache.GetTimeStamp(), std::move(detectionsByMode));
   
   // NOTE: This should come after any detectors that add things to "detectionRects"
@@ -88,6 +88,7 @@ namespace Vector {
   class Robot;
   class VizManager;
   class GroundPlaneClassifier;
+  class VisionModeTaskGraph;
   
   class VisionSystem : public Vision::Profiler
   {
@@ -245,6 +246,9 @@ namespace Vector {
     std::unique_ptr<MirrorModeManager>              _mirrorModeManager;
     std::unique_ptr<Vision::Benchmark>              _benchmark;
     
+    // Rebuilt each frame with a task per enabled detector, then run (possibly concurrently)
+    std::unique_ptr<VisionModeTaskGraph>            _detectionTaskGraph;
+    
     std::map<std::string, std::unique_ptr<NeuralNets::NeuralNetRunner>> _neuralNetRunners;
     
     Vision::CompressedImage _compressedDisplayImg;
@@ -275,7 +279,8 @@ namespace Vector {
                          const Vision::Image& claheImage,
                          std::vector<Anki::Rectangle<s32>>& detectionRects,
                          MarkerDetectionCLAHE useCLAHE,
-                         const VisionPoseData& poseData);
+                         const VisionPoseData& poseData,
+                         VisionProcessingResult& processingResult);
     
     // Uses grayscale
     static u8 ComputeMean(Vision::ImageCache& imageCache, const s32 sampleInc);
@@ -293,31 +298,36 @@ namespace Vector {
     Result UpdateCameraParams(Vision::ImageCache& imageCache);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectLaserPoints(Vision::ImageCache& imageCache);
+    Result DetectLaserPoints(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult);
 
     // Uses grayscale
     Result DetectFaces(Vision::ImageCache& imageCache,
                        std::vector<Anki::Rectangle<s32>>& detectionRects,
-                       const bool useCropping);
+                       const bool useCropping,
+                       VisionProcessingResult& processingResult);
     
     // Uses grayscale
     Result DetectPets(Vision::ImageCache& imageCache,
-                      std::vector<Anki::Rectangle<s32>>& ignoreROIs);
+                      std::vector<Anki::Rectangle<s32>>& ignoreROIs,
+                      VisionProcessingResult& processingResult);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectMotion(Vision::ImageCache& imageCache);
+    Result DetectMotion(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult);
 
     // Uses color
-    Result DetectBrightColors(Vision::ImageCache& imageCache);
+    Result DetectBrightColors(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult);
 
     // Uses grayscale
-    Result DetectIllumination(Vision::ImageCache& imageCache);
+    Result DetectIllumination(Vision::ImageCache& imageCache, VisionProcessingResult& processingResult);
 
     // Uses color
-    Result UpdateOverheadMap(Vision::ImageCache& image);
+    Result UpdateOverheadMap(Vision::ImageCache& image, VisionProcessingResult& processingResult);
 
     // Uses colors
-    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image);
+    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image, VisionProcessingResult& processingResult);
+    
+    // Computes all ImageCache sizes needed by enabled modes, so detectors can then share the cache across threads
+    void PrecomputeImageCacheSizes(Vision::ImageCache& imageCache);
     
     void CheckForNeuralNetResults();
     void AddFakeDetections(const TimeStamp_t atTimestamp, const std::set<VisionMode>& modes); // For debugging
@@ -94,6 +94,8 @@ void VizControllerImpl::Init()
             std::bind(&VizControllerImpl::ProcessVizMemoryMapMessageBegin, this, std::placeholders::_1));
   Subscribe(VizInterface::MessageVizTag::MemoryMapMessageViz,
             std::bind(&VizControllerImpl::ProcessVizMemoryMapMessage, this, std::placeholders::_1));
+  Subscribe(VizInterface::MessageVizTag::MemoryMapMessageVizDelta,
+            std::bind(&VizControllerImpl::ProcessVizMemoryMapMessageDelta, this, std::placeholders::_1));
   Subscribe(VizInterface::MessageVizTag::MemoryMapMessageVizEnd,
             std::bind(&VizControllerImpl::ProcessVizMemoryMapMessageEnd, this, std::placeholders::_1));
   Subscribe(VizInterface::MessageVizTag::Object,
@@ -1108,15 +1110,27 @@ void VizControllerImpl::ProcessVizSetOriginMessage(const AnkiEvent<VizInterface:
 void VizControllerImpl::ProcessVizMemoryMapMessageBegin(const AnkiEvent<VizInterface::MessageViz>& msg)
 {
   _navMapNodes.clear();
-  _navMapNodes.reserve(1024); // reserve some memory to avoid re-allocations
 }
 
 void VizControllerImpl::ProcessVizMemoryMapMessage(const AnkiEvent<VizInterface::MessageViz>& msg)
 {
   const auto& payload = msg.GetData().Get_MemoryMapMessageViz();
-  _navMapNodes.insert(_navMapNodes.end(),
-                      payload.quadInfos.begin(),
-                      payload.quadInfos.end());
+  for (const auto& quad : payload.quadInfos) {
+    _navMapNodes[std::make_tuple(quad.centerX_mm, quad.centerY_mm, quad.edgeLen_mm)] = quad;
+  }
+}
+
+void VizControllerImpl::ProcessVizMemoryMapMessageDelta(const AnkiEvent<VizInterface::MessageViz>& msg)
+{
+  const auto& payload = msg.GetData().Get_MemoryMapMessageVizDelta();
+  for (const auto& quad : payload.quadInfos) {
+    const auto key = std::make_tuple(quad.centerX_mm, quad.centerY_mm, quad.edgeLen_mm);
+    if (payload.isRemoval) {
+      _navMapNodes.erase(key);
+    } else {
+      _navMapNodes[key] = quad;
+    }
+  }
 }
 
 void VizControllerImpl::ProcessVizMemoryMapMessageEnd(const AnkiEvent<VizInterface::MessageViz>& msg)
@@ -1137,7 +1151,8 @@ void VizControllerImpl::ProcessVizMemoryMapMessageEnd(const AnkiEvent<VizInterfa
   const auto displayCenterY = 0.5 * displayHeight;
   
   // Draw each node
-  for (const auto& node : _navMapNodes) {
+  for (const auto& entry : _navMapNodes) {
+    const auto& node = entry.second;
     const auto rgba = node.colorRGBA;
     const int webotsColor = (rgba>>8); // convert RGBA to RGB
     const float webotsAlpha = (rgba & 0xFF) / 255.f; // convert alpha to 0.0 to 1.0
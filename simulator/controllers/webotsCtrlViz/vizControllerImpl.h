@@ -29,6 +29,7 @@
 #include <webots/Display.hpp>
 #include <vector>
 #include <map>
+#include <tuple>
 
 namespace Anki {
 namespace Vector {
@@ -153,6 +154,7 @@ private:
   
   void ProcessVizMemoryMapMessageBegin(const AnkiEvent<VizInterface::MessageViz>& msg);
   void ProcessVizMemoryMapMessage(const AnkiEvent<VizInterface::MessageViz>& msg);
+  void ProcessVizMemoryMapMessageDelta(const AnkiEvent<VizInterface::MessageViz>& msg);
   void ProcessVizMemoryMapMessageEnd(const AnkiEvent<VizInterface::MessageViz>& msg);
   
   void ProcessVizObjectMessage(const AnkiEvent<VizInterface::MessageViz>& msg);
@@ -265,7 +267,9 @@ private:
   std::string _currAnimName = "";
   u8          _currAnimTag = 0;
   
-  std::vector<ExternalInterface::MemoryMapQuadInfoFull> _navMapNodes;
+  // nav map quads keyed by (centerX, centerY, edgeLen), so that deltas can replace or remove them
+  using NavMapNodeKey = std::tuple<float, float, float>;
+  std::map<NavMapNodeKey, ExternalInterface::MemoryMapQuadInfoFull> _navMapNodes;
   
   // "Global" switch to enable drawing of objects from this controller
   bool _drawingObjectsEnabled = false;
@@ -33,6 +33,7 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <type_traits>
 
 namespace CLAD
 {
@@ -74,23 +75,13 @@ public:
   template <typename T>
   bool Write( const std::vector<T>& inVec)
   {
-    for(const T& val : inVec) {
-      if(!Write(val)) {
-        return false;
-      }
-    }
-    return true;
+    return WriteElements(inVec, IsBulkCopyable<T>());
   }
 
   template <typename val_t, size_t length>
   bool WriteFArray(const std::array<val_t, length>& inArray)
   {
-    for(const val_t& val : inArray) {
-      if(!Write(val)) {
-        return false;
-      }
-    }
-    return true;
+    return WriteElements(inArray, IsBulkCopyable<val_t>());
   }
 
   template <typename val_t, typename length_t>
@@ -183,29 +174,13 @@ public:
   template <typename val_t>
   bool Read( std::vector<val_t>& outVec, const size_t num) const
   {
-    outVec.clear();
-    outVec.reserve(num);
-    val_t val;
-    for(size_t i = 0; i < num; i++) {
-      if(!Read(val)) {
-        return false;
-      }
-      outVec.push_back(val);
-    }
-    return outVec.size() == num;
+    return ReadElements(outVec, num, IsBulkCopyable<val_t>());
   }
 
   template <typename val_t, size_t length>
   bool ReadFArray( std::array<val_t, length>& outArray ) const
   {
-    val_t val;
-    for(size_t i = 0; i < length; i++) {
-      if(!Read(val)) {
-        return false;
-      }
-      outArray[i] = val;
-    }
-    return true;
+    return ReadElements(outArray, IsBulkCopyable<val_t>());
   }
 
   template <typename val_t, typename length_t>
@@ -237,19 +212,12 @@ public:
   bool ReadString( std::string& outStr, size_t length) const
   {
     outStr.clear();
-    if(length > 0) {
-      outStr.reserve(length);
-      // This is probably really slow!
-      // TODO: figure out how to more quickly unpack a string
-      std::string::value_type val;
-      for(size_t i = 0; i < length; i++) {
-        if(!Read(val)) {
-          return false;
-        }
-        outStr.push_back(val);
-      }
+    if(!HasRoomToRead(length)) {
+      return false;
     }
-    return outStr.length() == length;
+    outStr.assign(reinterpret_cast<const char*>(_readHead), length);
+    _readHead += length;
+    return true;
   }
 
   template <typename array_length_t, typename string_length_t>
@@ -262,12 +230,11 @@ public:
     const size_t num = length;
     outVec.clear();
     outVec.reserve(num);
-    std::string val;
     for(size_t i = 0; i < num; i++) {
-      if(!ReadPString<string_length_t>(val)) {
+      outVec.emplace_back();
+      if(!ReadPString<string_length_t>(outVec.back())) {
         return false;
       }
-      outVec.push_back(val);
     }
     return outVec.size() == num;
   }
@@ -275,12 +242,10 @@ public:
   template <size_t length, typename string_length_t>
   bool ReadPStringFArray( std::array<std::string, length>& outArray ) const
   {
-    std::string val;
     for(size_t i = 0; i < length; i++) {
-      if(!ReadPString<string_length_t>(val)) {
+      if(!ReadPString<string_length_t>(outArray[i])) {
         return false;
       }
-      outArray[i] = val;
     }
     return true;
   }
@@ -290,12 +255,11 @@ public:
   {
     outVec.clear();
     outVec.reserve(num);
-    val_t val;
     for(size_t i = 0; i < num; i++) {
-      if(!val.Unpack(*this)) {
+      outVec.emplace_back();
+      if(!outVec.back().Unpack(*this)) {
         return false;
       }
-      outVec.push_back(val);
     }
     return outVec.size() == num;
   }
@@ -316,12 +280,10 @@ public:
   template <typename val_t, size_t length>
   bool ReadCompoundTypeFArray( std::array<val_t, length>& outArray ) const
   {
-    val_t val;
     for(size_t i = 0; i < length; i++) {
-      if(!val.Unpack(*this)) {
+      if(!outArray[i].Unpack(*this)) {
         return false;
       }
-      outArray[i] = val;
     }
     return true;
   }
@@ -331,6 +293,84 @@ public:
 
 private:
 
+  // Element types that are stored on the wire exactly as they are in memory, so arrays of them can be copied in
+  // one go. bool is the exception, since it's normalized to 0 or 1.
+  template <typename T>
+  using IsBulkCopyable = std::integral_constant<bool, (std::is_arithmetic<T>::value || std::is_enum<T>::value) &&
+                                                      !std::is_same<T, bool>::value>;
+
+  bool HasRoomToRead(size_t sizeOfRead) const
+  {
+    const bool isRoomForRead = (sizeOfRead <= (_bufferSize - static_cast<size_t>(_readHead - _buffer)));
+    assert(isRoomForRead);
+    return isRoomForRead;
+  }
+
+  template <typename container_t>
+  bool WriteElements(const container_t& inContainer, std::true_type)
+  {
+    if(inContainer.empty()) {
+      return true;
+    }
+    return WriteBytes(inContainer.data(), sizeof(typename container_t::value_type) * inContainer.size());
+  }
+
+  template <typename container_t>
+  bool WriteElements(const container_t& inContainer, std::false_type)
+  {
+    for(const auto& val : inContainer) {
+      if(!Write(val)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename val_t>
+  bool ReadElements(std::vector<val_t>& outVec, const size_t num, std::true_type) const
+  {
+    outVec.clear();
+    // Check before allocating, so a corrupt length can't make us allocate more than the buffer holds
+    if(num > (_bufferSize - static_cast<size_t>(_readHead - _buffer)) / sizeof(val_t)) {
+      assert(false);
+      return false;
+    }
+    outVec.resize(num);
+    return (num == 0) || ReadBytes(outVec.data(), sizeof(val_t) * num);
+  }
+
+  template <typename val_t>
+  bool ReadElements(std::vector<val_t>& outVec, const size_t num, std::false_type) const
+  {
+    outVec.clear();
+    outVec.reserve(num);
+    val_t val;
+    for(size_t i = 0; i < num; i++) {
+      if(!Read(val)) {
+        return false;
+      }
+      outVec.push_back(val);
+    }
+    return outVec.size() == num;
+  }
+
+  template <typename val_t, size_t length>
+  bool ReadElements(std::array<val_t, length>& outArray, std::true_type) const
+  {
+    return (length == 0) || ReadBytes(outArray.data(), sizeof(val_t) * length);
+  }
+
+  template <typename val_t, size_t length>
+  bool ReadElements(std::array<val_t, length>& outArray, std::false_type) const
+  {
+    for(size_t i = 0; i < length; i++) {
+      if(!Read(outArray[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   SafeMessageBuffer(const SafeMessageBuffer&);
   SafeMessageBuffer& operator=(const SafeMessageBuffer&);
 
@@ -0,0 +1,124 @@
+/**
+ * File: cborEncoder.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Minimal CBOR (RFC 7049) encoder for json values, for webviz clients that ask for binary frames
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "webServerProcess/src/cborEncoder.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Anki {
+namespace Vector {
+namespace WebService {
+
+namespace {
+
+  void AppendCborHead(uint8_t majorType, uint64_t arg, std::string& out)
+  {
+    const uint8_t major = (uint8_t)(majorType << 5);
+    int numBytes = 0;
+    if( arg < 24 ) {
+      out.push_back( (char)(major | arg) );
+      return;
+    } else if( arg <= 0xFF ) {
+      out.push_back( (char)(major | 24) );
+      numBytes = 1;
+    } else if( arg <= 0xFFFF ) {
+      out.push_back( (char)(major | 25) );
+      numBytes = 2;
+    } else if( arg <= 0xFFFFFFFF ) {
+      out.push_back( (char)(major | 26) );
+      numBytes = 4;
+    } else {
+      out.push_back( (char)(major | 27) );
+      numBytes = 8;
+    }
+    // big endian
+    for( int i = numBytes - 1; i >= 0; --i ) {
+      out.push_back( (char)((arg >> (8*i)) & 0xFF) );
+    }
+  }
+
+  void AppendCborString(const std::string& str, std::string& out)
+  {
+    AppendCborHead(3, str.size(), out);
+    out.append(str);
+  }
+
+}
+
+void AppendCbor(const Json::Value& value, std::string& out)
+{
+  switch( value.type() )
+  {
+    case Json::nullValue:
+      out.push_back( (char)0xF6 );
+      break;
+    case Json::booleanValue:
+      out.push_back( (char)(value.asBool() ? 0xF5 : 0xF4) );
+      break;
+    case Json::intValue:
+    {
+      const Json::LargestInt intVal = value.asLargestInt();
+      if( intVal >= 0 ) {
+        AppendCborHead(0, (uint64_t)intVal, out);
+      } else {
+        AppendCborHead(1, (uint64_t)(-1 - intVal), out);
+      }
+      break;
+    }
+    case Json::uintValue:
+      AppendCborHead(0, value.asLargestUInt(), out);
+      break;
+    case Json::realValue:
+    {
+      // most of what we send came from floats, so use single precision whenever it's exact
+      const double doubleVal = value.asDouble();
+      const float floatVal = (float)doubleVal;
+      if( (double)floatVal == doubleVal ) {
+        uint32_t bits;
+        memcpy(&bits, &floatVal, sizeof(bits));
+        out.push_back( (char)0xFA );
+        for( int i = 3; i >= 0; --i ) {
+          out.push_back( (char)((bits >> (8*i)) & 0xFF) );
+        }
+      } else {
+        uint64_t bits;
+        memcpy(&bits, &doubleVal, sizeof(bits));
+        out.push_back( (char)0xFB );
+        for( int i = 7; i >= 0; --i ) {
+          out.push_back( (char)((bits >> (8*i)) & 0xFF) );
+        }
+      }
+      break;
+    }
+    case Json::stringValue:
+      AppendCborString(value.asString(), out);
+      break;
+    case Json::arrayValue:
+      AppendCborHead(4, value.size(), out);
+      for( Json::ArrayIndex i = 0; i < value.size(); ++i ) {
+        AppendCbor(value[i], out);
+      }
+      break;
+    case Json::objectValue:
+      AppendCborHead(5, value.size(), out);
+      for( auto it = value.begin(); it != value.end(); ++it ) {
+        AppendCborString(it.key().asString(), out);
+        AppendCbor(*it, out);
+      }
+      break;
+  }
+}
+
+}
+}
+}
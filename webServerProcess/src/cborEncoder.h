@@ -0,0 +1,33 @@
+/**
+ * File: cborEncoder.h
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Minimal CBOR (RFC 7049) encoder for json values, for webviz clients that ask for binary frames
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __WebServerProcess_Src_CborEncoder_H__
+#define __WebServerProcess_Src_CborEncoder_H__
+
+#include "json/json.h"
+
+#include <string>
+
+namespace Anki {
+namespace Vector {
+namespace WebService {
+
+// Appends value to out as CBOR. Only the types json can hold are needed, and everything uses definite lengths.
+// Reals are written in single precision whenever that's exact, and in double precision otherwise.
+void AppendCbor(const Json::Value& value, std::string& out);
+
+}
+}
+}
+
+
+#endif
@@ -12,6 +12,7 @@
  **/
 
 #include "webService.h"
+#include "cborEncoder.h"
 
 #if !defined(ANKI_NO_WEBSERVER_ENABLED)
   #define ANKI_NO_WEBSERVER_ENABLED 0
@@ -28,11 +29,11 @@
 #include "util/console/consoleSystem.h"
 #include "util/console/consoleChannel.h"
 #include "util/cpuProfiler/cpuProfiler.h"
-#include "util/dispatchQueue/dispatchQueue.h"
 #include "util/global/globalDefinitions.h"
 #include "util/helpers/ankiDefines.h"
 #include "util/helpers/templateHelpers.h"
 #include "util/string/stringUtils.h"
+#include "util/threading/threadPriority.h"
 
 #include "osState/osState.h"
 
@@ -41,6 +42,7 @@
 #endif
 
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <chrono>
 #include <thread>
@@ -65,9 +67,16 @@ namespace {
 // http://tools.ietf.org/html/rfc6455#section-5.2
 enum {
   WebSocketsTypeText            = 0x1,
+  WebSocketsTypeBinary          = 0x2,
   WebSocketsTypeCloseConnection = 0x8
 };
 
+namespace {
+  // per connection; a client that can't keep up loses its oldest messages rather than stalling everyone else
+  const size_t kMaxQueuedMessagesPerConnection = 256;
+  const size_t kDroppedMessagesLogInterval = 100;
+}
+
 // 256KB to accommodate output of animation names
 static const size_t kBigBufferSize = 256*1024;
 
@@ -917,6 +926,30 @@ namespace Anki {
 namespace Vector {
 namespace WebService {
 
+struct WebService::OutgoingMessage
+{
+  Json::Value payload;
+
+  // only touched by the writer thread
+  std::string encoded[(size_t)WebSocketEncoding::Count];
+  bool isEncoded[(size_t)WebSocketEncoding::Count] = {false};
+
+  const std::string& GetEncoded(WebSocketEncoding encoding)
+  {
+    const size_t idx = (size_t)encoding;
+    if( !isEncoded[idx] ) {
+      if( encoding == WebSocketEncoding::Cbor ) {
+        AppendCbor(payload, encoded[idx]);
+      } else {
+        Json::FastWriter writer;
+        encoded[idx] = writer.write(payload);
+      }
+      isEncoded[idx] = true;
+    }
+    return encoded[idx];
+  }
+};
+
 WebService::WebService()
 : _ctx(nullptr)
 {
@@ -1030,7 +1063,11 @@ void WebService::Start(Anki::Util::Data::DataPlatform* platform, const Json::Val
 
   _requests.clear();
 
-  _dispatchQueue = Util::Dispatch::Create("WebsocketSender");
+  {
+    std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+    _wsWriterShouldStop = false;
+  }
+  _wsWriterThread = std::thread(&WebService::RunWebSocketWriter, this);
 }
 
 
@@ -1231,10 +1268,10 @@ void WebService::Update()
               if( (idx < _webSocketConnections.size())
                  && (_webSocketConnections[idx].subscribedModules.count( moduleName ) > 0) )
               {
-                Json::Value payload;
-                payload["module"] = moduleName;
-                payload["data"] = toSend;
-                SendToWebSocket( _webSocketConnections[idx].conn, payload );
+                auto msg = std::make_shared<OutgoingMessage>();
+                msg->payload["module"] = moduleName;
+                msg->payload["data"] = toSend;
+                SendToWebSocket( _webSocketConnections[idx], msg );
               }
             };
 
@@ -1300,6 +1337,9 @@ void WebService::Stop()
 #endif
     _ctx = nullptr;
   }
+
+  // after mg_stop, so that any write stuck on a dead client has been aborted
+  StopWebSocketWriter();
 }
 
 
@@ -1565,17 +1605,18 @@ void WebService::GenerateConsoleVarsUI(std::string& page, const std::string& cat
 
 void WebService::SendToWebSockets(const std::string& moduleName, const Json::Value& data) const
 {
+  // the payload is built once and shared by every subscriber. The caller only pays for that copy, serializing and
+  // writing happen on the writer thread
+  OutgoingMessagePtr msg;
   std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
-  Json::Value payload;
-  bool hasAssigned = false; // don't copy payload unless there is >= 1 client for this module
-  for( const auto& connData : _webSocketConnections ) {
+  for( auto& connData : _webSocketConnections ) {
     if( connData.subscribedModules.find( moduleName ) != connData.subscribedModules.end() ) {
-      if( !hasAssigned ) {
-        payload["module"] = moduleName;
-        payload["data"] = data;
-        hasAssigned = true;
+      if( msg == nullptr ) { // don't copy payload unless there is >= 1 client for this module
+        msg = std::make_shared<OutgoingMessage>();
+        msg->payload["module"] = moduleName;
+        msg->payload["data"] = data;
       }
-      SendToWebSocket(connData.conn, payload);
+      SendToWebSocket(connData, msg);
     }
   }
 }
@@ -1656,17 +1697,78 @@ void WebService::HandleWebSocketsClose(const struct mg_connection* conn, void* c
 }
 
 
-// This is always called in the main thread (whether we're sending or receiving)
-void WebService::SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const
+void WebService::SendToWebSocket(WebSocketConnectionData& connData, const OutgoingMessagePtr& msg) const
 {
-  // Dispatch work onto another thread (note we copy 'data' by value here)
-  Util::Dispatch::Async(_dispatchQueue, [conn, data] {
-    std::stringstream ss;
-    ss << data;
-    const std::string& str = ss.str();
+  if( connData.outbox.size() >= kMaxQueuedMessagesPerConnection ) {
+    connData.outbox.pop_front();
+    if( (connData.numDropped++ % kDroppedMessagesLogInterval) == 0 ) {
+      LOG_WARNING("WebService.SendToWebSocket.Dropped",
+                  "Client can't keep up, dropped %zu messages so far",
+                  connData.numDropped);
+    }
+  }
+  connData.outbox.push_back(msg);
+  _wsWriterCondition.notify_one();
+}
 
-    mg_websocket_write(conn, WebSocketsTypeText, str.c_str(), str.size());
-  });
+
+void WebService::RunWebSocketWriter()
+{
+  Anki::Util::SetThreadName(pthread_self(), "WebsocketSender");
+
+  std::unique_lock<std::mutex> lock(s_wsConnectionsMutex);
+  while( !_wsWriterShouldStop ) {
+    // next connection with something to send, starting after the last one served
+    WebSocketConnectionData* connData = nullptr;
+    const size_t numConnections = _webSocketConnections.size();
+    for( size_t i = 0; i < numConnections; ++i ) {
+      const size_t idx = (_wsWriterNextIdx + i) % numConnections;
+      if( !_webSocketConnections[idx].outbox.empty() ) {
+        connData = &_webSocketConnections[idx];
+        _wsWriterNextIdx = idx + 1;
+        break;
+      }
+    }
+
+    if( connData == nullptr ) {
+      _wsWriterCondition.wait(lock);
+      continue;
+    }
+
+    std::deque<OutgoingMessagePtr> toSend;
+    toSend.swap(connData->outbox);
+    const WebSocketEncoding encoding = connData->encoding;
+    struct mg_connection* conn = connData->conn;
+
+    // OnCloseWebSocket waits for this to be cleared, so conn stays valid while unlocked
+    _wsWriterConn = conn;
+    lock.unlock();
+
+    // binary frames are only ever cbor, so a client that just switched encodings can tell every message apart
+    const int opcode = (encoding == WebSocketEncoding::Json) ? WebSocketsTypeText : WebSocketsTypeBinary;
+    for( const auto& msg : toSend ) {
+      const std::string& str = msg->GetEncoded(encoding);
+      mg_websocket_write(conn, opcode, str.data(), str.size());
+    }
+    toSend.clear();
+
+    lock.lock();
+    _wsWriterConn = nullptr;
+    _wsWriteDoneCondition.notify_all();
+  }
+}
+
+
+void WebService::StopWebSocketWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+    _wsWriterShouldStop = true;
+  }
+  _wsWriterCondition.notify_all();
+  if( _wsWriterThread.joinable() ) {
+    _wsWriterThread.join();
+  }
 }
 
 
@@ -1724,10 +1826,20 @@ void WebService::OnReceiveWebSocket(struct mg_connection* conn, const Json::Valu
                        waitAndSendResponse);
       }
 
+    } else if( data["type"].asString() == "encoding" ) {
+      // e.g. {"type":"encoding", "encoding":"cbor"} to get binary frames instead of json text
+      const std::string& encoding = data["encoding"].asString();
+      if( encoding == "cbor" ) {
+        it->encoding = WebSocketEncoding::Cbor;
+      } else if( encoding == "json" ) {
+        it->encoding = WebSocketEncoding::Json;
+      } else {
+        LOG_WARNING("Webservice.OnReceiveWebSocket.UnknownEncoding", "'%s', keeping current encoding", encoding.c_str());
+      }
     } else if( !data["keepalive"].isNull() ) {
-      Json::Value response;
-      response["keepalive"] = true;
-      SendToWebSocket( it->conn, response );
+      auto msg = std::make_shared<OutgoingMessage>();
+      msg->payload["keepalive"] = true;
+      SendToWebSocket( *it, msg );
     }
   } else {
     std::stringstream ss;
@@ -1738,13 +1850,20 @@ void WebService::OnReceiveWebSocket(struct mg_connection* conn, const Json::Valu
 
 void WebService::OnCloseWebSocket(const struct mg_connection* conn)
 {
-  std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+  std::unique_lock<std::mutex> lock(s_wsConnectionsMutex);
+
+  // civetweb frees conn once this returns, so let the writer finish with it first
+  _wsWriteDoneCondition.wait(lock, [this, conn]{ return _wsWriterConn != conn; });
+
   // find connection
   auto it = std::find_if( _webSocketConnections.begin(), _webSocketConnections.end(), [&conn](const auto& perConnData) {
     return perConnData.conn == conn;
   });
+  if( it == _webSocketConnections.end() ) {
+    return;
+  }
 
-  // erase it
+  // erase it (along with anything still queued for it)
   auto& data = *it;
   std::swap(data, _webSocketConnections.back());
   _webSocketConnections.pop_back();
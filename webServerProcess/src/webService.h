@@ -17,7 +17,11 @@
 
 #include "json/json.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #include <mutex>
 #include <unordered_set>
@@ -39,9 +43,6 @@ namespace Util {
 namespace Data {
   class DataPlatform;
 }
-namespace Dispatch {
-  class Queue;
-}
 
 } // namespace Util
 
@@ -147,9 +148,24 @@ private:
   void GenerateConsoleVarsUI(std::string& page, const std::string& category,
                              const bool standalone);
 
+  // a message queued for one or more websockets. It's serialized by the writer thread, at most once per encoding,
+  // no matter how many connections it goes to
+  struct OutgoingMessage;
+  using OutgoingMessagePtr = std::shared_ptr<OutgoingMessage>;
+
+  // clients get json text frames unless they ask for something more compact
+  enum class WebSocketEncoding : uint8_t {
+    Json = 0,
+    Cbor,
+    Count
+  };
+
   struct WebSocketConnectionData {
     struct mg_connection* conn = nullptr;
     std::unordered_set<std::string> subscribedModules;
+    WebSocketEncoding encoding = WebSocketEncoding::Json;
+    std::deque<OutgoingMessagePtr> outbox; // waiting for the writer thread, oldest are dropped when full
+    size_t numDropped = 0;
   };
   
   // called by civetweb
@@ -163,15 +179,28 @@ private:
   void OnReceiveWebSocket(struct mg_connection* conn, const Json::Value& data);
   void OnCloseWebSocket(const struct mg_connection* conn);
 
-  void SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const;
+  // queues msg for connData, must be called with s_wsConnectionsMutex held
+  void SendToWebSocket(WebSocketConnectionData& connData, const OutgoingMessagePtr& msg) const;
+
+  // writer thread, drains the connection outboxes so that senders never block on a socket
+  void RunWebSocketWriter();
+  void StopWebSocketWriter();
 
   // todo: OTA update somehow?
 
   struct mg_context* _ctx;
   
-  std::vector<WebSocketConnectionData> _webSocketConnections;
+  mutable std::vector<WebSocketConnectionData> _webSocketConnections; // outboxes are filled by const senders
   mutable std::mutex s_wsConnectionsMutex;
 
+  // all guarded by s_wsConnectionsMutex
+  std::thread _wsWriterThread;
+  mutable std::condition_variable _wsWriterCondition;    // signaled when an outbox has something in it
+  std::condition_variable _wsWriteDoneCondition;         // signaled when the writer is done with _wsWriterConn
+  const struct mg_connection* _wsWriterConn = nullptr;   // connection the writer is currently writing to
+  size_t _wsWriterNextIdx = 0;                           // round robin over connections so one can't starve others
+  bool _wsWriterShouldStop = false;
+
   std::string _consoleVarsUIHTMLTemplate;
 
   std::vector<Request*> _requests;
@@ -184,8 +213,6 @@ private:
   
   OnAppToEngineOnDataType _appToEngineOnData;
   OnAppToEngineRequestDataType _appToEngineRequestData;
-  
-  Util::Dispatch::Queue* _dispatchQueue = nullptr;
 };
 
 } // namespace WebService
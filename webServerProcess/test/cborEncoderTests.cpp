@@ -0,0 +1,217 @@
+/**
+ * File: cborEncoderTests.cpp
+ *
+ * Author: agent
+ * Date:   10/16/2026
+ *
+ * Description: Checks the json to CBOR encoder against the examples in RFC 8949 Appendix A, plus the boundaries
+ *              where the size of an item's head changes
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "webServerProcess/src/cborEncoder.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace Anki::Vector::WebService;
+
+namespace {
+
+  std::string ToHex(const std::string& bytes)
+  {
+    static const char* const kDigits = "0123456789abcdef";
+    std::string hex;
+    for( const char byte : bytes ) {
+      hex.push_back( kDigits[((uint8_t)byte) >> 4] );
+      hex.push_back( kDigits[((uint8_t)byte) & 0x0F] );
+    }
+    return hex;
+  }
+
+  std::string EncodeToHex(const Json::Value& value)
+  {
+    std::string out;
+    AppendCbor(value, out);
+    return ToHex(out);
+  }
+
+  Json::Value ParseJson(const std::string& text)
+  {
+    Json::Value value;
+    Json::Reader reader;
+    EXPECT_TRUE( reader.parse(text, value) ) << text;
+    return value;
+  }
+
+}
+
+TEST(CborEncoder, UnsignedIntegers)
+{
+  const std::pair<uint64_t, const char*> kVectors[] = {
+    {0,                    "00"},
+    {1,                    "01"},
+    {10,                   "0a"},
+    {23,                   "17"},
+    {24,                   "1818"},
+    {25,                   "1819"},
+    {100,                  "1864"},
+    {255,                  "18ff"},
+    {256,                  "190100"},
+    {1000,                 "1903e8"},
+    {65535,                "19ffff"},
+    {65536,                "1a00010000"},
+    {1000000,              "1a000f4240"},
+    {4294967295,           "1affffffff"},
+    {4294967296,           "1b0000000100000000"},
+    {1000000000000,        "1b000000e8d4a51000"},
+    {18446744073709551615u, "1bffffffffffffffff"},
+  };
+
+  for( const auto& vector : kVectors ) {
+    // Json keeps these as uints
+    EXPECT_EQ( vector.second, EncodeToHex(Json::Value((Json::UInt64)vector.first)) ) << vector.first;
+
+    // and as ints when they fit, which should encode the same
+    if( vector.first <= (uint64_t)std::numeric_limits<Json::Int64>::max() ) {
+      const Json::Value intValue((Json::Int64)vector.first);
+      ASSERT_EQ( Json::intValue, intValue.type() );
+      EXPECT_EQ( vector.second, EncodeToHex(intValue) ) << vector.first;
+    }
+  }
+}
+
+TEST(CborEncoder, NegativeIntegers)
+{
+  const std::pair<int64_t, const char*> kVectors[] = {
+    {-1,                                      "20"},
+    {-10,                                     "29"},
+    {-24,                                     "37"},
+    {-25,                                     "3818"},
+    {-100,                                    "3863"},
+    {-256,                                    "38ff"},
+    {-257,                                    "390100"},
+    {-1000,                                   "3903e7"},
+    {-65536,                                  "39ffff"},
+    {-65537,                                  "3a00010000"},
+    {-4294967296,                             "3affffffff"},
+    {-4294967297,                             "3b0000000100000000"},
+    {std::numeric_limits<int64_t>::min(),     "3b7fffffffffffffff"},
+  };
+
+  for( const auto& vector : kVectors ) {
+    EXPECT_EQ( vector.second, EncodeToHex(Json::Value((Json::Int64)vector.first)) ) << vector.first;
+  }
+}
+
+// Values a float holds exactly are written in single precision, everything else in double
+TEST(CborEncoder, Reals)
+{
+  const std::pair<double, const char*> kVectors[] = {
+    {0.0,                                          "fa00000000"},
+    {-0.0,                                         "fa80000000"},
+    {1.0,                                          "fa3f800000"},
+    {1.5,                                          "fa3fc00000"},
+    {100000.0,                                     "fa47c35000"},
+    {3.4028234663852886e+38,                       "fa7f7fffff"},
+    {std::numeric_limits<double>::infinity(),      "fa7f800000"},
+    {-std::numeric_limits<double>::infinity(),     "faff800000"},
+    {(double)0.1f,                                 "fa3dcccccd"},
+    {1.1,                                          "fb3ff199999999999a"},
+    {0.1,                                          "fb3fb999999999999a"},
+    {1.0e+300,                                     "fb7e37e43c8800759c"},
+    {-4.1,                                         "fbc010666666666666"},
+    // Just beyond what a float can hold
+    {3.4028235677973366e+38,                       "fb47effffff0000000"},
+  };
+
+  for( const auto& vector : kVectors ) {
+    const Json::Value value(vector.first);
+    ASSERT_EQ( Json::realValue, value.type() );
+    EXPECT_EQ( vector.second, EncodeToHex(value) ) << vector.first;
+  }
+
+  // NaN never compares equal to itself, so it takes the double path
+  const std::string nan = EncodeToHex(Json::Value(std::numeric_limits<double>::quiet_NaN()));
+  EXPECT_EQ( "fb", nan.substr(0, 2) );
+  EXPECT_EQ( 18, nan.size() );
+}
+
+TEST(CborEncoder, Strings)
+{
+  EXPECT_EQ( "60",             EncodeToHex(Json::Value("")) );
+  EXPECT_EQ( "6161",           EncodeToHex(Json::Value("a")) );
+  EXPECT_EQ( "6449455446",     EncodeToHex(Json::Value("IETF")) );
+  EXPECT_EQ( "62225c",         EncodeToHex(Json::Value("\"\\")) );
+  EXPECT_EQ( "62c3bc",         EncodeToHex(Json::Value("\xc3\xbc")) );
+  EXPECT_EQ( "63e6b0b4",       EncodeToHex(Json::Value("\xe6\xb0\xb4")) );
+
+  // Longer strings need a bigger head
+  for( const size_t length : {23u, 24u, 255u, 256u, 65535u, 65536u} ) {
+    std::string expectedHead;
+    if( length < 24 ) {
+      expectedHead = ToHex(std::string(1, (char)(0x60 + length)));
+    } else if( length <= 0xFF ) {
+      expectedHead = "78" + ToHex(std::string(1, (char)length));
+    } else if( length <= 0xFFFF ) {
+      expectedHead = "79" + ToHex(std::string{(char)(length >> 8), (char)(length & 0xFF)});
+    } else {
+      expectedHead = "7a" + ToHex(std::string{0, (char)(length >> 16), (char)((length >> 8) & 0xFF),
+                                              (char)(length & 0xFF)});
+    }
+    const std::string str(length, 'x');
+    EXPECT_EQ( expectedHead + ToHex(str), EncodeToHex(Json::Value(str)) ) << length;
+  }
+}
+
+TEST(CborEncoder, Arrays)
+{
+  EXPECT_EQ( "80",               EncodeToHex(Json::Value(Json::arrayValue)) );
+  EXPECT_EQ( "83010203",         EncodeToHex(ParseJson("[1, 2, 3]")) );
+  EXPECT_EQ( "8301820203820405", EncodeToHex(ParseJson("[1, [2, 3], [4, 5]]")) );
+  EXPECT_EQ( "98190102030405060708090a0b0c0d0e0f101112131415161718181819",
+             EncodeToHex(ParseJson("[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, "
+                                   "21, 22, 23, 24, 25]")) );
+  EXPECT_EQ( "826161a161626163", EncodeToHex(ParseJson("[\"a\", {\"b\": \"c\"}]")) );
+
+  // 256 elements need a two byte length
+  Json::Value nulls(Json::arrayValue);
+  nulls.resize(256);
+  std::string expected = "990100";
+  for( int i = 0; i < 256; ++i ) {
+    expected += "f6";
+  }
+  EXPECT_EQ( expected, EncodeToHex(nulls) );
+}
+
+TEST(CborEncoder, Objects)
+{
+  EXPECT_EQ( "a0",                 EncodeToHex(Json::Value(Json::objectValue)) );
+  EXPECT_EQ( "a26161016162820203", EncodeToHex(ParseJson("{\"a\": 1, \"b\": [2, 3]}")) );
+  EXPECT_EQ( "a56161614161626142616361436164614461656145",
+             EncodeToHex(ParseJson("{\"a\": \"A\", \"b\": \"B\", \"c\": \"C\", \"d\": \"D\", \"e\": \"E\"}")) );
+  EXPECT_EQ( "a1616180", EncodeToHex(ParseJson("{\"a\": []}")) );
+  EXPECT_EQ( "a1616fa0", EncodeToHex(ParseJson("{\"o\": {}}")) );
+}
+
+TEST(CborEncoder, NullAndBool)
+{
+  EXPECT_EQ( "f6", EncodeToHex(Json::Value()) );
+  EXPECT_EQ( "f5", EncodeToHex(Json::Value(true)) );
+  EXPECT_EQ( "f4", EncodeToHex(Json::Value(false)) );
+  EXPECT_EQ( "83f6f5f4", EncodeToHex(ParseJson("[null, true, false]")) );
+}
+
+// Encoding appends to whatever is already there
+TEST(CborEncoder, Appends)
+{
+  std::string out = "\x01";
+  AppendCbor(Json::Value(24), out);
+  AppendCbor(Json::Value("a"), out);
+  EXPECT_EQ( "0118186161", ToHex(out) );
+}